@@ -0,0 +1,65 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains injector_roots struct.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Set of types that process is going to request from injector.
+ * @see injector::injector(std::vector<std::unique_ptr<module>>, const injector_roots &)
+ *
+ * Injector created with roots configures only types reachable from them, following setter dependencies
+ * and types required by factories. All other configured types are pruned.
+ */
+struct injector_roots
+{
+	/**
+	 * @brief Types that will be requested with injector::get(), injector::get_all() or injector::instantiate().
+	 *
+	 * Interfaces can be used - all configured types implementing them are roots.
+	 */
+	std::vector<type> types;
+
+	/**
+	 * @brief Type roles that will be used with injector::instantiate_all_with_type_role() or injector::get_all_with_type_role().
+	 */
+	std::vector<std::string> type_roles;
+
+	/**
+	 * @brief Types of objects that will be passed to injector::inject_into().
+	 *
+	 * These types do not have to be configured. Types of theirs setters are roots.
+	 */
+	std::vector<type> inject_into_types;
+};
+
+}}
@@ -21,8 +21,15 @@
 #pragma once
 
 #include <injeqt/injeqt.h>
+#include <injeqt/injector-roots.h>
+#include <injeqt/lazy-module.h>
+#include <injeqt/startup-report.h>
 #include <injeqt/type.h>
+#include <injeqt/validation-mode.h>
 
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <QtCore/QObject>
@@ -113,11 +120,125 @@ public:
 	 */
 	explicit injector(std::vector<injector *> super_injectors, std::vector<std::unique_ptr<module>> modules);
 
+	/**
+	 * @brief Create new injector from provided modules, with validated configuration cached in file.
+	 * @param modules list of modules
+	 * @param types_model_cache_file_name name of file to read and write cache of validated configuration
+	 * @throw ambiguous_types if one or more types in @p modules is ambiguous
+	 * @throw unresolvable_dependencies if a type with unresolvable dependency is found in @p modules
+	 * @throw invalid_setter if any tagged setter is invalid
+	 *
+	 * Works like injector(std::vector<std::unique_ptr<module>>), but relations and dependencies of types,
+	 * once validated, are saved to @p types_model_cache_file_name. Cache is keyed by hash of names,
+	 * superclasses, method counts and setter signatures of all configured types. On next start with
+	 * the same types file is memory mapped and deserialized, only setters stored in it are checked, and
+	 * creating setters and validation of configuration is skipped. Missing, corrupted and stale cache files are ignored
+	 * and rewritten.
+	 */
+	explicit injector(std::vector<std::unique_ptr<module>> modules, const QString &types_model_cache_file_name);
+
+	/**
+	 * @brief Create new injector from provided modules, with given validation mode.
+	 * @param modules list of modules
+	 * @param validation when configured types are validated
+	 * @throw ambiguous_types if one or more types in @p modules is ambiguous
+	 *
+	 * With validation_mode::eager it works exactly like injector(std::vector<std::unique_ptr<module>>).
+	 *
+	 * With validation_mode::lazy only ambiguity of types is checked here. Setters of type are extracted
+	 * and its dependencies and types required by its factory are validated when the type, or type that
+	 * depends on it, is first requested - by get(), get_all(), instantiate(), methods using type roles,
+	 * inject_into() or by prewarm. Exceptions otherwise thrown by constructor (unresolvable_dependencies,
+	 * unavailable_required_types, invalid_setter and others) are then thrown by these methods. Types
+	 * that are never requested are never validated.
+	 */
+	explicit injector(std::vector<std::unique_ptr<module>> modules, validation_mode validation);
+
+	/**
+	 * @brief Create new injector from provided modules, configured only with types reachable from @p roots.
+	 * @param modules list of modules
+	 * @param roots types, type roles and types of objects used with inject_into() that will be requested
+	 * @throw ambiguous_types if one or more reachable types is ambiguous
+	 * @throw unresolvable_dependencies if a reachable type has unresolvable dependency
+	 * @throw invalid_setter if any tagged setter of reachable type is invalid
+	 *
+	 * Types reachable from @p roots are found by following setters (only theirs parameter type names are
+	 * read) and types required by factories. Providers are created and types are inspected and validated
+	 * only for reachable types, so errors in other types are not reported. Other types are pruned -
+	 * requesting them throws unknown_type. List of pruned types is available from pruned_types() and can
+	 * be used to trim module definitions.
+	 */
+	explicit injector(std::vector<std::unique_ptr<module>> modules, const injector_roots &roots);
+
 	injector(injector &&x);
 	~injector();
 
 	injector & operator = (injector &&x);
 
+	/**
+	 * @brief Add configuration from @p modules to this injector.
+	 * @param modules list of modules
+	 * @throw ambiguous_types if any type from @p modules is already configured in this injector
+	 * @throw ambiguous_types if one or more types becomes ambiguous
+	 * @throw unresolvable_dependencies if a type with unresolvable dependency is found in @p modules
+	 * @throw unresolvable_dependencies if a type from @p modules makes dependency of already configured type
+	 *        ambiguous
+	 * @throw unavailable_required_types if a factory from @p modules requires not configured type
+	 * @throw dependency_on_self when type depends on self
+	 * @throw dependency_on_subtype when type depends on own supertype
+	 * @throw dependency_on_subtype when type depends on own subtype
+	 * @throw invalid_setter if any tagged setter has invalid signature
+	 *
+	 * This method allows to load features at runtime without creating new injector. Only types from
+	 * @p modules are reflected over and validated, so this is much cheaper than creating new injector.
+	 * Relations of new types are still merged into tables of already configured types, so part of cost
+	 * grows linearly with number of these. Already created objects are not modified - objects that received lists of objects in INJEQT_SET_ALL
+	 * setters are not updated with new implementations. Injectors that use this one as a parent injector
+	 * do not see added types.
+	 *
+	 * If an exception is thrown, configuration of injector is not modified and @p modules are destroyed.
+	 */
+	void add_modules(std::vector<std::unique_ptr<module>> modules);
+
+	/**
+	 * @brief Remove configuration of @p to_remove module from this injector and destroy it.
+	 * @param to_remove module to remove
+	 * @throw unresolvable_dependencies if a remaining type depends on type from @p to_remove
+	 * @throw unavailable_required_types if a remaining factory requires type from @p to_remove
+	 * @pre @p to_remove was passed to this injector in constructor or in add_modules()
+	 *
+	 * All objects of types from @p to_remove and all objects that transitively depend on them (for example
+	 * objects that received them in INJEQT_SET_ALL setters) have INJEQT_DONE methods called, dependents
+	 * first (in reverse topological order of dependencies). Then these objects are destroyed. Objects of
+	 * remaining types will be created again when requested. All other objects are not touched. Only
+	 * affected objects are finished and destroyed, but updating injector tables is linear in number of
+	 * configured types.
+	 *
+	 * Objects passed to inject_into() are not tracked and must not use removed objects anymore.
+	 *
+	 * If an exception is thrown, configuration of injector is not modified and @p to_remove is not destroyed.
+	 */
+	void remove_module(module *to_remove);
+
+	/**
+	 * @brief Add descriptors of modules that will be loaded only when one of its types is needed.
+	 * @param lazy_modules descriptors of modules to load on demand
+	 * @see lazy_module
+	 *
+	 * No module is created by this call. When a type that is not configured in this injector is requested
+	 * by get(), instantiate() or by INJEQT_SET setter of object passed to inject_into(), all lazy modules
+	 * declaring that type name are loaded. get_all() loads all lazy modules declaring name of requested
+	 * type even if it is already configured, as each of these modules can add new implementations. Type roles
+	 * declared by lazy modules are loaded in instantiate_all_with_type_role() and get_all_with_type_role().
+	 * Lazy modules declaring types required by types of loaded modules are loaded at the same time.
+	 *
+	 * Loaded modules are added as with add_modules() and the same exceptions can be thrown from methods
+	 * that trigger loading. Descriptors of loaded modules are discarded even if an exception was thrown,
+	 * so each loader is called at most once. Injectors that use this one as a parent injector do not see
+	 * types of lazy modules until these are loaded.
+	 */
+	void add_lazy_modules(std::vector<lazy_module> lazy_modules);
+
 	/**
 	 * @brief Instantiates object of given type @p interface_type
 	 * @tparam T type of object to instantiate
@@ -154,6 +275,9 @@ public:
 	 * create itself all required factories with the same alghoritm). After U with all its dependencies
 	 * is created all dependency setters are called with proper arguments. Then U object is added to cache
 	 * and is itself returned.
+	 *
+	 * Objects that are already created and initialized are returned without taking injector lock, so get()
+	 * can be called from many threads and does not wait for reconfiguration or prewarm of other types.
 	 */
 	template<typename T>
 	T * get()
@@ -174,9 +298,21 @@ public:
 	/**
 	 * @brief Instantiate all objects with given @p type_role.
 	 * @throw instantiation_failed if instantiation of one of found types failed
+	 *
+	 * Types can have more than one role declared with INJEQT_TYPE_ROLE. Lookup of types with given
+	 * role is done in index created at injector construction.
 	 */
 	void instantiate_all_with_type_role(const std::string &type_role);
 
+	/**
+	 * @brief Returns all objects with given @p type_role.
+	 * @throw instantiation_failed if instantiation of one of found types failed
+	 *
+	 * All objects with given role that are not yet available are instantiated first, like with
+	 * instantiate_all_with_type_role(const std::string &). Objects are returned in unspecified order.
+	 */
+	std::vector<QObject *> get_all_with_type_role(const std::string &type_role);
+
 	/**
 	 * @brief Returns pointer to object of given type interface_type.
 	 * @param interface_type type of object to return
@@ -189,6 +325,44 @@ public:
 	 */
 	QObject * get(const type &interface_type);
 
+	/**
+	 * @brief Returns all objects of configured types that implement @p interface_type.
+	 * @param interface_type type of objects to return
+	 * @throw qobject_type if interface_type represents QObject
+	 * @throw instantiation_failed if instantiation of one of required types failed
+	 * @pre !interface_type.is_empty()
+	 *
+	 * Unlike get(const type &) this method does not require that @p interface_type has unique implementation.
+	 * All configured types that implement it are instantiated (if not available yet) and returned in
+	 * unspecified order. If no configured type implements @p interface_type, an empty list is returned.
+	 *
+	 * The same list of objects is passed to setters tagged with INJEQT_SET_ALL:
+	 *
+	 *     INJEQT_SET_ALL void set_handlers(QList<handler *> handlers);
+	 *
+	 * @see std::vector<T *> get_all<T>()
+	 */
+	std::vector<QObject *> get_all(const type &interface_type);
+
+	/**
+	 * @brief Returns all objects of configured types that implement T.
+	 * @tparam T type of objects to return
+	 * @throw qobject_type if T represents QObject
+	 * @throw instantiation_failed if instantiation of one of required types failed
+	 *
+	 * @see std::vector<QObject *> get_all(const type &)
+	 */
+	template<typename T>
+	std::vector<T *> get_all()
+	{
+		auto objects = get_all(make_type<T>());
+		auto result = std::vector<T *>{};
+		result.reserve(objects.size());
+		for (auto &&object : objects)
+			result.push_back(qobject_cast<T *>(object));
+		return result;
+	}
+
 	/**
 	 * @brief Inject dependencies into @p object.
 	 * @param object object to inject dependencies into.
@@ -205,6 +379,167 @@ public:
 	 */
 	void inject_into(QObject *object);
 
+	/**
+	 * @brief Inject dependencies into all @p objects.
+	 * @param objects objects to inject dependencies into.
+	 * @throw invalid_setter if any tagged setter of any object is invalid (see inject_into(QObject *))
+	 * @pre all objects are not nullptr
+	 *
+	 * This method works like calling inject_into(QObject *) for each object, but it is much faster for
+	 * many objects of the same type. Setters are looked up and dependencies are resolved only once for each
+	 * distinct type. Then all INJEQT_SET methods and INJEQT_INIT methods are called on each object in order.
+	 *
+	 * Types of all objects are checked before any setter is called, so if an exception is thrown
+	 * no object was modified.
+	 */
+	void inject_into(const std::vector<QObject *> &objects);
+
+	/**
+	 * @brief Instantiate objects of @p interface_types on worker thread.
+	 * @param interface_types types of objects to instantiate
+	 * @throw empty_type if any of @p interface_types is empty
+	 * @throw qobject_type if any of @p interface_types represents QObject
+	 * @throw unknown_type if any of @p interface_types was not configured in injector
+	 *
+	 * This method returns immediately. Objects of @p interface_types are queued for worker thread shared by
+	 * all prewarm calls and are created one type (with all its dependencies) at a time. Each created object is moved to thread that called this method
+	 * before it becomes visible to other threads, so objects can be used as if they were created by get().
+	 * Only parentless objects are moved. INJEQT_INIT methods are called on worker thread, so types that
+	 * must be initialized on specific thread should not be prewarmed.
+	 *
+	 * Injector can be used normally while prewarm is running. When get() requests object that is just
+	 * being created by worker, it waits for it instead of creating it again.
+	 *
+	 * Errors from worker are reported by wait_for_prewarm(). Injector waits for worker in destructor. In
+	 * fast_exit() types that are still queued are dropped and only type that is being created is waited for.
+	 */
+	void prewarm(std::vector<type> interface_types);
+
+	/**
+	 * @brief Instantiate all objects with given @p type_role on worker thread.
+	 * @see prewarm(std::vector<type>)
+	 */
+	void prewarm_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Wait until all started prewarms are finished.
+	 * @throw instantiation_failed if instantiation of one of prewarmed types failed
+	 *
+	 * First exception thrown on worker thread is rethrown. Worker stops at first error and drops types
+	 * that are still queued, objects created before it are kept.
+	 */
+	void wait_for_prewarm();
+
+	/**
+	 * @brief Start recording order and cost of instantiation of objects.
+	 *
+	 * From now on, for each object created by injector time spent in its construction (by default constructor
+	 * or factory) and in its INJEQT_INIT methods is recorded. Recording stops in save_profile(). Calling
+	 * this method again discards previously recorded data.
+	 *
+	 * Example usage:
+	 *
+	 *     if (!injector.replay_profile(profile_file_name))
+	 *         injector.start_profile_recording();
+	 *     // ... startup ...
+	 *     injector.save_profile(profile_file_name);
+	 */
+	void start_profile_recording();
+
+	/**
+	 * @brief Stop recording and save recorded profile to @p file_name.
+	 * @param file_name name of file to write
+	 * @return true if profile was saved
+	 *
+	 * Profile contains recorded types in order of instantiation with theirs costs and signature of current
+	 * configuration of injector.
+	 */
+	bool save_profile(const QString &file_name);
+
+	/**
+	 * @brief Prewarm types recorded in profile saved in @p file_name.
+	 * @param file_name name of file with profile saved by save_profile()
+	 * @return true if prewarm was started
+	 *
+	 * Missing, unreadable and stale profiles (recorded with different set of types or with types that have
+	 * changed since) are ignored and false is returned. Otherwise all recorded types that are still configured
+	 * are passed to prewarm(), ordered so that types with most expensive dependency chains are created first.
+	 * Instantiation in injector is serialized, so profile is replayed by single worker thread.
+	 */
+	bool replay_profile(const QString &file_name);
+
+	/**
+	 * @brief Analyze critical path of startup recorded since start_profile_recording().
+	 * @return report with critical path, slack of each type and bounds of startup time
+	 *
+	 * Measured costs of types are combined with their dependencies. Report shows which types limit startup
+	 * time (those on critical path), how much every other type could be delayed or moved to background
+	 * without making startup longer and what is the shortest possible startup time with unlimited parallelism.
+	 * Types that are no longer configured are not included. If nothing was recorded, empty report is returned.
+	 */
+	startup_report analyze_startup();
+
+	/**
+	 * @return configured types that were not reachable from roots passed to constructor
+	 * @see injector(std::vector<std::unique_ptr<module>>, const injector_roots &)
+	 */
+	std::vector<type> pruned_types() const;
+
+	/**
+	 * @brief Instantiate objects of @p interface_types in small steps driven by Qt event loop.
+	 * @param interface_types types of objects to instantiate
+	 * @param slice_budget maximum time spent in one slice
+	 * @param finished function called when all objects are available (with null pointer) or when instantiation
+	 *        failed (with exception), can be empty
+	 * @throw empty_type if any of @p interface_types is empty
+	 * @throw qobject_type if any of @p interface_types represents QObject
+	 * @throw unknown_type if any of @p interface_types was not configured in injector
+	 *
+	 * This method returns immediately. All types required by @p interface_types are ordered so that dependencies
+	 * come first. Then, from event loop of thread that called this method, types are instantiated one by one
+	 * (with setters and INJEQT_INIT methods called) until @p slice_budget is used up. Control then returns to
+	 * event loop and next slice is executed after pending events are processed. At least one type is
+	 * instantiated in each slice. Unlike prewarm() all objects are created on the thread owning injector, so
+	 * this can be used in GUI applications with budget like 8 ms to keep frames responsive.
+	 *
+	 * Injector can be used normally in the meantime, get() creates requested object immediately and it is
+	 * then skipped by incremental instantiation. Requests are processed in order of calls. Injector must
+	 * not be destroyed from @p finished callback.
+	 *
+	 * Example usage:
+	 *
+	 *     injector.instantiate_incrementally(std::vector<type>{make_type<main_window>()}, std::chrono::milliseconds{8},
+	 *         [](std::exception_ptr error){ if (!error) show_main_window(); });
+	 */
+	void instantiate_incrementally(std::vector<type> interface_types, std::chrono::milliseconds slice_budget,
+		std::function<void(std::exception_ptr)> finished = std::function<void(std::exception_ptr)>{});
+
+	/**
+	 * @brief Shut down injector without destroying its objects.
+	 *
+	 * This method is intended to be called just before process exit when there is no need to
+	 * run destructors of all objects, as memory will be reclaimed by operating system anyway.
+	 *
+	 * Only INJEQT_DONE methods of objects of types marked with INJEQT_DONE_ON_FAST_EXIT are called.
+	 * Then all objects created by injector and all modules (with ready objects they own) are released
+	 * without calling theirs destructors. After this call injector is empty, as if it was created with
+	 * default constructor.
+	 *
+	 * Example usage:
+	 *
+	 *     class flushing_service : public QObject
+	 *     {
+	 *         Q_OBJECT
+	 *         INJEQT_DONE_ON_FAST_EXIT
+	 *
+	 *     private slots:
+	 *         INJEQT_DONE void done() { flush(); }
+	 *     };
+	 *
+	 *     injector.fast_exit();
+	 */
+	void fast_exit();
+
 private:
 	std::unique_ptr<injeqt::internal::injector_impl> _pimpl;
 
@@ -32,6 +32,7 @@
 #  define INJEQT_INIT
 #  define INJEQT_DONE
 #  define INJEQT_SET
+#  define INJEQT_SET_ALL
 // depreceated, use INJEQT_SET instead
 #  define INJEQT_SETTER
 #endif
@@ -39,6 +40,9 @@
 #define INJEQT_TYPE_ROLE_CLASSINFO_NAME "injeqt.type-role"
 #define INJEQT_TYPE_ROLE(N) Q_CLASSINFO(INJEQT_TYPE_ROLE_CLASSINFO_NAME, N)
 
+#define INJEQT_DONE_ON_FAST_EXIT_CLASSINFO_NAME "injeqt.done-on-fast-exit"
+#define INJEQT_DONE_ON_FAST_EXIT Q_CLASSINFO(INJEQT_DONE_ON_FAST_EXIT_CLASSINFO_NAME, "true")
+
 namespace injeqt {
 	namespace v1 { }
 	using namespace v1;
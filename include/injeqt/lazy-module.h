@@ -0,0 +1,119 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for describing modules that are loaded on demand.
+ */
+
+namespace injeqt { namespace v1 {
+
+class module;
+
+/**
+ * @brief Descriptor of module that is created only when one of its types is needed.
+ *
+ * Lazy module declares names of types it provides (and optionally type roles of these types)
+ * without creating any objects or even loading code of these types. This data can come for example
+ * from Q_PLUGIN_METADATA JSON of plugin read with QPluginLoader::metaData(), which does not load
+ * plugin library.
+ *
+ * Names must be exactly as returned by type::name() for provided types and for all interfaces these
+ * types can be requested as (including these used in INJEQT_SET and INJEQT_SET_ALL setters of other
+ * types). If a name is missing, injector will not know that this lazy module is able to provide given type.
+ *
+ * Loader is called at most once, when injector first needs one of declared types in injector::get(),
+ * injector::instantiate(), injector::get_all(), injector::inject_into() or when type role declared
+ * in this descriptor is instantiated. Returned module is then added to injector just like with
+ * injector::add_modules().
+ *
+ * Example usage:
+ *
+ *     auto loader = std::make_shared<QPluginLoader>("plugins/libstorage.so");
+ *     auto metadata = loader->metaData().value("MetaData").toObject();
+ *     auto type_names = std::vector<std::string>{};
+ *     for (auto &&type_name : metadata.value("types").toArray())
+ *         type_names.push_back(type_name.toString().toStdString());
+ *
+ *     auto storage_module = lazy_module{type_names, [loader](){
+ *         return qobject_cast<module_plugin *>(loader->instance())->create_module();
+ *     }};
+ *
+ *     injector.add_lazy_modules(std::vector<lazy_module>{storage_module});
+ */
+class INJEQT_API lazy_module final
+{
+
+public:
+	/**
+	 * @brief Function creating module when it is first needed.
+	 */
+	using loader = std::function<std::unique_ptr<module>()>;
+
+	/**
+	 * @brief Create lazy module descriptor.
+	 * @param provided_type_names names of types that can be provided by module returned from @p load
+	 * @param load function creating module, must not return nullptr
+	 * @param type_roles type roles of types provided by module returned from @p load
+	 */
+	explicit lazy_module(std::vector<std::string> provided_type_names, loader load, std::vector<std::string> type_roles = std::vector<std::string>{});
+
+	/**
+	 * @return names of types that can be provided by module
+	 */
+	const std::vector<std::string> & provided_type_names() const;
+
+	/**
+	 * @return type roles of types provided by module
+	 */
+	const std::vector<std::string> & type_roles() const;
+
+	/**
+	 * @return true if @p type_name was declared as provided by module
+	 */
+	bool provides(const std::string &type_name) const;
+
+	/**
+	 * @return true if @p type_role was declared for module
+	 */
+	bool has_type_role(const std::string &type_role) const;
+
+	/**
+	 * @brief Create module by calling loader.
+	 */
+	std::unique_ptr<module> load() const;
+
+private:
+	std::vector<std::string> _provided_type_names;
+	loader _load;
+	std::vector<std::string> _type_roles;
+
+};
+
+}}
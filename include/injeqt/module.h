@@ -31,6 +31,7 @@
  */
 
 namespace injeqt { namespace internal {
+	class injector_builder;
 	class injector_impl;
 	class module_impl;
 }}
@@ -233,6 +234,7 @@ protected:
 	}
 
 private:
+	friend class ::injeqt::internal::injector_builder;
 	friend class ::injeqt::internal::injector_impl;
 	std::unique_ptr<injeqt::internal::module_impl> _pimpl;
 
@@ -0,0 +1,97 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <string>
+#include <vector>
+#include <QtCore/QtGlobal>
+
+/**
+ * @file
+ * @brief Contains classes and functions for reporting analysis of startup costs.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Cost and scheduling data of one type in startup_report.
+ */
+struct startup_report_entry
+{
+	/**
+	 * @brief Name of implementation type.
+	 */
+	std::string type_name;
+
+	/**
+	 * @brief Measured time of construction and INJEQT_INIT methods, in nanoseconds.
+	 *
+	 * Time of other objects created by injector during them is not included.
+	 */
+	qint64 cost_ns;
+
+	/**
+	 * @brief Earliest time this type can be ready if all independent types are created in parallel, in nanoseconds.
+	 */
+	qint64 earliest_finish_ns;
+
+	/**
+	 * @brief How much this type can be delayed without making startup longer, in nanoseconds.
+	 *
+	 * Types on critical path have zero slack.
+	 */
+	qint64 slack_ns;
+};
+
+/**
+ * @brief Result of analysis of recorded startup.
+ * @see injector::analyze_startup()
+ *
+ * Dependency graph of types is combined with measured costs of types. Longest chain of dependencies
+ * (weighted by costs) is critical path - startup can not be faster than its length, even with unlimited
+ * parallelism. Optimizing types from critical path first gives best results.
+ */
+struct startup_report
+{
+	/**
+	 * @brief Names of types on critical path, dependencies first.
+	 */
+	std::vector<std::string> critical_path;
+
+	/**
+	 * @brief All analyzed types in order of recording.
+	 */
+	std::vector<startup_report_entry> types;
+
+	/**
+	 * @brief Length of critical path - lower bound of startup time under full parallelism, in nanoseconds.
+	 */
+	qint64 critical_path_ns;
+
+	/**
+	 * @brief Sum of costs of all types - startup time without any parallelism, in nanoseconds.
+	 */
+	qint64 total_ns;
+};
+
+}}
@@ -0,0 +1,56 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+/**
+ * @file
+ * @brief Contains validation_mode enum.
+ */
+
+namespace injeqt { namespace v1 {
+
+/**
+ * @brief Describes when injector validates configured types.
+ * @see injector::injector(std::vector<std::unique_ptr<module>>, validation_mode)
+ */
+enum class validation_mode
+{
+	/**
+	 * @brief Dependencies of all types are extracted and validated when injector is created.
+	 *
+	 * Any error in configuration is reported by constructor of injector. This is default mode,
+	 * recommended for tests and continuous integration.
+	 */
+	eager,
+
+	/**
+	 * @brief Dependencies of type are extracted and validated when it or one of its dependents is first requested.
+	 *
+	 * Only ambiguity of configured types is checked when injector is created. Processes that use only
+	 * small part of configured types do not pay for validation of the rest. Errors in configuration
+	 * are reported by first call that needs invalid type.
+	 */
+	lazy
+};
+
+}}
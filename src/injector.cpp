@@ -29,6 +29,7 @@
 #include "module-impl.h"
 #include "provider.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace injeqt::internal;
@@ -45,6 +46,21 @@ injector::injector(std::vector<std::unique_ptr<module>> modules) :
 {
 }
 
+injector::injector(std::vector<std::unique_ptr<module>> modules, const QString &types_model_cache_file_name) :
+	_pimpl{new ::injeqt::internal::injector_impl{std::move(modules), types_model_cache_file_name}}
+{
+}
+
+injector::injector(std::vector<std::unique_ptr<module>> modules, validation_mode validation) :
+	_pimpl{new ::injeqt::internal::injector_impl{std::move(modules), validation}}
+{
+}
+
+injector::injector(std::vector<std::unique_ptr<module>> modules, const injector_roots &roots) :
+	_pimpl{new ::injeqt::internal::injector_impl{std::move(modules), roots}}
+{
+}
+
 injector::injector(std::vector<injector *> super_injectors, std::vector<std::unique_ptr<module>> modules)
 {
 	auto extract_impl = std::function<injector_impl*(injector *)>([](injector *i){ return i->_pimpl.get(); });
@@ -66,6 +82,23 @@ injector & injector::operator = (injector &&x)
 	return *this;
 }
 
+void injector::add_modules(std::vector<std::unique_ptr<module>> modules)
+{
+	_pimpl->add_modules(std::move(modules));
+}
+
+void injector::remove_module(module *to_remove)
+{
+	assert(to_remove);
+
+	_pimpl->remove_module(to_remove);
+}
+
+void injector::add_lazy_modules(std::vector<lazy_module> lazy_modules)
+{
+	_pimpl->add_lazy_modules(std::move(lazy_modules));
+}
+
 void injector::instantiate(const type &interface_type)
 {
 	assert(!interface_type.is_empty());
@@ -81,6 +114,21 @@ void injector::instantiate_all_with_type_role(const std::string &type_role)
 	_pimpl->instantiate_all_with_type_role(type_role);
 }
 
+std::vector<QObject *> injector::get_all_with_type_role(const std::string &type_role)
+{
+	return _pimpl->get_all_with_type_role(type_role);
+}
+
+std::vector<QObject *> injector::get_all(const type &interface_type)
+{
+	assert(!interface_type.is_empty());
+
+	if (interface_type.is_qobject())
+		throw exception::qobject_type{};
+
+	return _pimpl->get_all(interface_type);
+}
+
 QObject * injector::get(const type &interface_type)
 {
 	assert(!interface_type.is_empty());
@@ -98,4 +146,77 @@ void injector::inject_into(QObject *object)
 	_pimpl->inject_into(object);
 }
 
+void injector::inject_into(const std::vector<QObject *> &objects)
+{
+	assert(std::none_of(std::begin(objects), std::end(objects), [](QObject *object){ return object == nullptr; }));
+
+	_pimpl->inject_into(objects);
+}
+
+void injector::prewarm(std::vector<type> interface_types)
+{
+	for (auto &&interface_type : interface_types)
+	{
+		if (interface_type.is_empty())
+			throw exception::empty_type{};
+		if (interface_type.is_qobject())
+			throw exception::qobject_type{};
+	}
+
+	_pimpl->prewarm(std::move(interface_types));
+}
+
+void injector::prewarm_with_type_role(const std::string &type_role)
+{
+	_pimpl->prewarm_with_type_role(type_role);
+}
+
+void injector::wait_for_prewarm()
+{
+	_pimpl->wait_for_prewarm();
+}
+
+void injector::start_profile_recording()
+{
+	_pimpl->start_profile_recording();
+}
+
+bool injector::save_profile(const QString &file_name)
+{
+	return _pimpl->save_profile(file_name);
+}
+
+bool injector::replay_profile(const QString &file_name)
+{
+	return _pimpl->replay_profile(file_name);
+}
+
+startup_report injector::analyze_startup()
+{
+	return _pimpl->analyze_startup();
+}
+
+std::vector<type> injector::pruned_types() const
+{
+	return _pimpl->pruned_types();
+}
+
+void injector::instantiate_incrementally(std::vector<type> interface_types, std::chrono::milliseconds slice_budget, std::function<void(std::exception_ptr)> finished)
+{
+	for (auto &&interface_type : interface_types)
+	{
+		if (interface_type.is_empty())
+			throw exception::empty_type{};
+		if (interface_type.is_qobject())
+			throw exception::qobject_type{};
+	}
+
+	_pimpl->instantiate_incrementally(std::move(interface_types), slice_budget, std::move(finished));
+}
+
+void injector::fast_exit()
+{
+	_pimpl->fast_exit();
+}
+
 }}
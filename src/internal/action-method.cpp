@@ -93,11 +93,11 @@ action_method make_action_method(const QMetaMethod &meta_method)
 	return action_method{meta_method};
 }
 
-std::vector<action_method> extract_actions(const std::string &action_tag, const type &for_type)
+action_methods extract_actions(const std::string &action_tag, const type &for_type)
 {
 	assert(!for_type.is_empty());
 
-	auto result = std::vector<action_method>{};
+	auto result = action_methods{};
 
 	auto meta_object = for_type.meta_object();
 	auto method_count = meta_object->methodCount();
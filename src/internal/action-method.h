@@ -21,6 +21,7 @@
 #pragma once
 
 #include "internal.h"
+#include "small-vector.h"
 
 #include <injeqt/exception/exception.h>
 #include <injeqt/injeqt.h>
@@ -125,7 +126,14 @@ private:
 
 };
 
+/**
+ * @brief List of action methods of one type.
+ *
+ * Types rarely have more than few INJEQT_INIT or INJEQT_DONE methods, so these are stored inline.
+ */
+using action_methods = small_vector<action_method, 4>;
+
 INJEQT_INTERNAL_API action_method make_action_method(const QMetaMethod &meta_method);
-std::vector<action_method> extract_actions(const std::string &action_tag, const type &for_type);
+INJEQT_INTERNAL_API action_methods extract_actions(const std::string &action_tag, const type &for_type);
 
 }}
@@ -23,6 +23,11 @@
 #include "internal.h"
 
 #include <algorithm>
+#include <exception>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 /**
@@ -47,6 +52,84 @@ inline INJEQT_INTERNAL_API std::vector<T> transform(const std::vector<S> &source
 	return result;
 }
 
+/**
+ * @brief Functional interface to std::transform running on multiple threads.
+ * @tparam S type of source items
+ * @tparam F type of transforming function, called directly without std::function wrapper
+ * @tparam T type of result items
+ * @param source source data
+ * @param f transforming function, must be safe to call from many threads at once
+ * @param min_chunk_size minimal number of items processed by one thread
+ *
+ * Source is split into contiguous chunks, one per hardware thread, and results are concatenated in order
+ * of source, so result is the same as of transform(). Each chunk stops at first exception. If any chunk
+ * failed, exception of first failing chunk is rethrown - it is the exception that serial transform()
+ * would throw. Small inputs, and chunks for which thread could not be created, are transformed on
+ * calling thread.
+ */
+template<typename S, typename F, typename T = typename std::result_of<F(const S &)>::type>
+inline INJEQT_INTERNAL_API std::vector<T> parallel_transform(const std::vector<S> &source, F f, std::size_t min_chunk_size = 64)
+{
+	auto thread_count = std::max(std::size_t{1}, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+	auto chunk_count = std::min(thread_count, source.size() / std::max(std::size_t{1}, min_chunk_size));
+
+	if (chunk_count < 2)
+	{
+		auto result = std::vector<T>{};
+		result.reserve(source.size());
+		for (auto &&item : source)
+			result.push_back(f(item));
+		return result;
+	}
+
+	auto chunk_size = (source.size() + chunk_count - 1) / chunk_count;
+	auto chunk_results = std::vector<std::vector<T>>(chunk_count);
+	auto chunk_errors = std::vector<std::exception_ptr>(chunk_count);
+	auto transform_chunk = [&](std::size_t chunk){
+		auto begin = chunk * chunk_size;
+		auto end = std::min(source.size(), begin + chunk_size);
+		try
+		{
+			chunk_results[chunk].reserve(end - begin);
+			for (auto i = begin; i < end; i++)
+				chunk_results[chunk].push_back(f(source[i]));
+		}
+		catch (...)
+		{
+			chunk_errors[chunk] = std::current_exception();
+		}
+	};
+
+	auto threads = std::vector<std::thread>{};
+	threads.reserve(chunk_count - 1);
+	auto started_chunk_count = std::size_t{1};
+	try
+	{
+		for (; started_chunk_count < chunk_count; started_chunk_count++)
+			threads.emplace_back(transform_chunk, started_chunk_count);
+	}
+	catch (std::system_error &)
+	{
+		// chunks without thread are transformed on calling thread, started threads are joined below
+	}
+
+	transform_chunk(0);
+	for (auto chunk = started_chunk_count; chunk < chunk_count; chunk++)
+		transform_chunk(chunk);
+	for (auto &&thread : threads)
+		thread.join();
+
+	for (auto &&chunk_error : chunk_errors)
+		if (chunk_error)
+			std::rethrow_exception(chunk_error);
+
+	auto result = std::vector<T>{};
+	result.reserve(source.size());
+	for (auto &&chunk_result : chunk_results)
+		std::move(std::begin(chunk_result), std::end(chunk_result), std::back_inserter(result));
+	return result;
+}
+
 /**
  * @brief Extract data from multiple vectors into one vector.
  * @tparam S type of source items
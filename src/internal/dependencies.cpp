@@ -31,6 +31,7 @@
 #include "dependency.h"
 #include "interfaces-utils.h"
 #include "setter-method.h"
+#include "small-vector.h"
 #include "type-relations.h"
 
 #include <QtCore/QMetaMethod>
@@ -42,18 +43,18 @@ namespace injeqt { namespace internal {
 
 namespace {
 
-std::vector<setter_method> extract_setters(const types_by_name &known_types, const type &for_type)
+small_vector<setter_method, 8> extract_setters(const types_by_name &known_types, const type &for_type)
 {
 	assert(!for_type.is_empty());
 
-	auto result = std::vector<setter_method>{};
+	auto result = small_vector<setter_method, 8>{};
 
 	auto meta_object = for_type.meta_object();
 	auto method_count = meta_object->methodCount();
 	for (decltype(method_count) i = 0; i < method_count; i++)
 	{
 		auto maybe_setter = meta_object->method(i);
-		if (setter_method::is_setter_tag(maybe_setter.tag()))
+		if (setter_method::is_setter_tag(maybe_setter.tag()) || setter_method::is_setter_all_tag(maybe_setter.tag()))
 			result.emplace_back(make_setter_method(known_types, maybe_setter));
 	}
 
@@ -80,12 +81,40 @@ dependencies extract_dependencies(const types_by_name &known_types, const type &
 			throw exception::dependency_on_subtype{};
 	}
 
-	auto result = std::vector<dependency>{};
+	auto result = dependencies::storage_type{};
 	std::transform(std::begin(setters), std::end(setters), std::back_inserter(result),
 		[](const setter_method &setter){ return dependency{setter}; }
 	);
 
-	return dependencies{result};
+	return dependencies{std::move(result)};
+}
+
+std::vector<std::string> extract_dependency_type_names(const type &for_type)
+{
+	assert(!for_type.is_empty());
+
+	auto result = std::vector<std::string>{};
+
+	auto list_prefix = std::string{"QList<"};
+	auto meta_object = for_type.meta_object();
+	auto method_count = meta_object->methodCount();
+	for (decltype(method_count) i = 0; i < method_count; i++)
+	{
+		auto maybe_setter = meta_object->method(i);
+		auto is_setter = setter_method::is_setter_tag(maybe_setter.tag());
+		auto is_setter_all = setter_method::is_setter_all_tag(maybe_setter.tag());
+		if ((!is_setter && !is_setter_all) || maybe_setter.parameterCount() != 1)
+			continue;
+
+		auto name = std::string{maybe_setter.parameterTypes()[0].data()};
+		if (is_setter_all && name.compare(0, list_prefix.length(), list_prefix) == 0 && !name.empty() && name.back() == '>')
+			name = name.substr(list_prefix.length(), name.length() - list_prefix.length() - 1);
+		if (!name.empty() && name.back() == '*')
+			name.pop_back();
+		result.push_back(name);
+	}
+
+	return result;
 }
 
 }}
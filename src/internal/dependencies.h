@@ -25,8 +25,12 @@
 
 #include "dependency.h"
 #include "internal.h"
+#include "small-vector.h"
 #include "types-by-name.h"
 
+#include <string>
+#include <vector>
+
 /**
  * @file
  * @brief Contains classes and functions for representing set of Injeqt dependencies.
@@ -60,8 +64,9 @@ INJEQT_INTERNAL_API inline dependency dependency_from_dependency(const dependenc
  * type based sets (like implementations) using match() function.
  *
  * The best way to create instance of this type is to call make_validated_dependencies(const type &).
+ * Most types have less than eight dependencies, so these are stored inline, without heap allocation.
  */
-using dependencies = sorted_unique_vector<dependency, dependency, dependency_from_dependency>;
+using dependencies = sorted_unique_vector<dependency, dependency, dependency_from_dependency, small_vector<dependency, 8>>;
 
 /**
  * @brief Extract set of dependencies from type.
@@ -81,4 +86,15 @@ using dependencies = sorted_unique_vector<dependency, dependency, dependency_fro
  */
 INJEQT_INTERNAL_API dependencies extract_dependencies(const types_by_name &known_types, const type &for_type);
 
+/**
+ * @brief Extract names of types required by setters of type.
+ * @param for_type type to extract dependency names from.
+ * @pre !for_type.is_empty()
+ *
+ * Returns names of types used as parameters of all slots tagged with INJEQT_SET and INJEQT_SET_ALL without
+ * pointer and QList decorations. No validation is done and types does not have to be known, so this function
+ * can be used to find out what configuration is required before injecting into object of @p for_type.
+ */
+INJEQT_INTERNAL_API std::vector<std::string> extract_dependency_type_names(const type &for_type);
+
 }}
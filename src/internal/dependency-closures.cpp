@@ -0,0 +1,211 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "dependency-closures.h"
+
+#include "dependency-graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+const auto not_computed = std::numeric_limits<std::size_t>::max();
+const auto bits_per_word = std::size_t{64};
+
+}
+
+node_set::node_set(std::size_t size) :
+	_size{size},
+	_words((size + bits_per_word - 1) / bits_per_word, 0)
+{
+}
+
+std::size_t node_set::size() const
+{
+	return _size;
+}
+
+void node_set::set(std::size_t id)
+{
+	assert(id < _size);
+	_words[id / bits_per_word] |= std::uint64_t{1} << (id % bits_per_word);
+}
+
+bool node_set::test(std::size_t id) const
+{
+	assert(id < _size);
+	return (_words[id / bits_per_word] >> (id % bits_per_word)) & 1;
+}
+
+bool node_set::none() const
+{
+	auto result = std::uint64_t{0};
+	for (auto word : _words)
+		result |= word;
+	return result == 0;
+}
+
+bool node_set::intersects(const node_set &other) const
+{
+	assert(_size == other._size);
+
+	auto result = std::uint64_t{0};
+	for (auto i = std::size_t{0}; i < _words.size(); i++)
+		result |= _words[i] & other._words[i];
+	return result != 0;
+}
+
+node_set & node_set::operator |= (const node_set &other)
+{
+	assert(_size == other._size);
+
+	for (auto i = std::size_t{0}; i < _words.size(); i++)
+		_words[i] |= other._words[i];
+	return *this;
+}
+
+node_set & node_set::and_not(const node_set &other)
+{
+	assert(_size == other._size);
+
+	for (auto i = std::size_t{0}; i < _words.size(); i++)
+		_words[i] &= ~other._words[i];
+	return *this;
+}
+
+std::vector<std::size_t> node_set::ids() const
+{
+	auto result = std::vector<std::size_t>{};
+	for (auto i = std::size_t{0}; i < _words.size(); i++)
+		for (auto word = _words[i]; word != 0; word &= word - 1)
+		{
+			auto bit = std::size_t{0};
+			while (!((word >> bit) & 1))
+				bit++;
+			result.push_back(i * bits_per_word + bit);
+		}
+	return result;
+}
+
+dependency_closures::dependency_closures() :
+	_next_visit_index{0}
+{
+}
+
+const node_set & dependency_closures::closure(const dependency_graph &graph, std::size_t id)
+{
+	assert(id < graph.size());
+
+	std::lock_guard<std::mutex> lock{_mutex};
+	if (_closure_index.empty())
+	{
+		_closure_index.assign(graph.size(), not_computed);
+		_visit_index.assign(graph.size(), not_computed);
+		_low_link.assign(graph.size(), 0);
+		_on_stack.assign(graph.size(), false);
+	}
+
+	if (_closure_index[id] == not_computed)
+		compute(graph, id);
+	return *_closures[_closure_index[id]];
+}
+
+void dependency_closures::compute(const dependency_graph &graph, std::size_t id)
+{
+	struct frame
+	{
+		std::size_t node;
+		std::size_t next_target;
+	};
+
+	auto frames = std::vector<frame>{};
+	auto stack = std::vector<std::size_t>{};
+	auto visit = [&](std::size_t node){
+		_visit_index[node] = _low_link[node] = _next_visit_index++;
+		_on_stack[node] = true;
+		stack.push_back(node);
+		frames.push_back(frame{node, 0});
+	};
+
+	visit(id);
+	while (!frames.empty())
+	{
+		auto &current = frames.back();
+		auto targets = graph.targets_of(current.node);
+		if (current.next_target < targets.size())
+		{
+			auto target = targets.begin()[current.next_target++];
+			// nodes from previous computations are in already completed components
+			if (_closure_index[target] != not_computed)
+				continue;
+			if (_visit_index[target] == not_computed)
+				visit(target);
+			else if (_on_stack[target])
+				_low_link[current.node] = std::min(_low_link[current.node], _visit_index[target]);
+			continue;
+		}
+
+		auto node = current.node;
+		frames.pop_back();
+		if (!frames.empty())
+			_low_link[frames.back().node] = std::min(_low_link[frames.back().node], _low_link[node]);
+
+		if (_low_link[node] != _visit_index[node])
+			continue;
+
+		auto root_it = std::find(stack.rbegin(), stack.rend(), node);
+		auto members = std::vector<std::size_t>(root_it.base() - 1, std::end(stack));
+		add_component(graph, members);
+		stack.erase(root_it.base() - 1, std::end(stack));
+	}
+}
+
+void dependency_closures::add_component(const dependency_graph &graph, const std::vector<std::size_t> &members)
+{
+	auto result = std::unique_ptr<node_set>{new node_set{graph.size()}};
+	auto cyclic = members.size() > 1;
+	for (auto &&member : members)
+		for (auto &&target : graph.targets_of(member))
+			// only members of this component are still on stack
+			if (_on_stack[target])
+				cyclic = true;
+			else
+			{
+				*result |= *_closures[_closure_index[target]];
+				result->set(target);
+			}
+
+	if (cyclic)
+		for (auto &&member : members)
+			result->set(member);
+
+	for (auto &&member : members)
+	{
+		_on_stack[member] = false;
+		_closure_index[member] = _closures.size();
+	}
+	_closures.push_back(std::move(result));
+}
+
+}}
@@ -0,0 +1,139 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for computing transitive closures of dependency_graph.
+ */
+
+namespace injeqt { namespace internal {
+
+class dependency_graph;
+
+/**
+ * @brief Set of dependency_graph node ids stored as bitset.
+ *
+ * Set operations work on whole 64-bit words, in simple loops that compilers vectorize.
+ */
+class INJEQT_INTERNAL_API node_set final
+{
+
+public:
+	/**
+	 * @brief Create empty set for node ids less than @p size.
+	 */
+	explicit node_set(std::size_t size = 0);
+
+	/**
+	 * @return maximum node id plus one
+	 */
+	std::size_t size() const;
+
+	void set(std::size_t id);
+	bool test(std::size_t id) const;
+
+	/**
+	 * @return true if no id is in set
+	 */
+	bool none() const;
+
+	/**
+	 * @return true if any id is in both this set and @p other
+	 * @pre size() == other.size()
+	 */
+	bool intersects(const node_set &other) const;
+
+	/**
+	 * @brief Add all ids from @p other to this set.
+	 * @pre size() == other.size()
+	 */
+	node_set & operator |= (const node_set &other);
+
+	/**
+	 * @brief Remove all ids in @p other from this set.
+	 * @pre size() == other.size()
+	 */
+	node_set & and_not(const node_set &other);
+
+	/**
+	 * @return all ids in set, in ascending order
+	 */
+	std::vector<std::size_t> ids() const;
+
+private:
+	std::size_t _size;
+	std::vector<std::uint64_t> _words;
+
+};
+
+/**
+ * @brief Memoized transitive closures of nodes of dependency_graph.
+ *
+ * Closure of a node is a set of all nodes it depends on, directly or indirectly. Closures are computed
+ * on first request, together with closures of all nodes they need, by Tarjan's algorithm: strongly
+ * connected components are completed in reverse topological order and closure of each is a union of
+ * closures of components it depends on. All nodes of a component share one closure. Node in a cycle is
+ * included in its own closure.
+ *
+ * Computed closures are never changed, so references to them stay valid for lifetime of this object.
+ * Computation is guarded by mutex, as graphs are shared between configuration snapshots.
+ */
+class INJEQT_INTERNAL_API dependency_closures final
+{
+
+public:
+	dependency_closures();
+	dependency_closures(const dependency_closures &) = delete;
+	dependency_closures & operator = (const dependency_closures &) = delete;
+
+	/**
+	 * @return closure of node @p id of @p graph
+	 * @pre id < graph.size()
+	 * @pre this object is used only with one graph
+	 */
+	const node_set & closure(const dependency_graph &graph, std::size_t id);
+
+private:
+	std::mutex _mutex;
+	std::vector<std::unique_ptr<node_set>> _closures;
+	std::vector<std::size_t> _closure_index;
+	std::vector<std::size_t> _visit_index;
+	std::vector<std::size_t> _low_link;
+	std::vector<bool> _on_stack;
+	std::size_t _next_visit_index;
+
+	void compute(const dependency_graph &graph, std::size_t id);
+	void add_component(const dependency_graph &graph, const std::vector<std::size_t> &members);
+
+};
+
+}}
@@ -0,0 +1,204 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "dependency-graph.h"
+
+#include "dependencies.h"
+#include "dependency.h"
+#include "implemented-by.h"
+#include "implemented-by-all.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+template<typename F>
+void for_each_edge(const type_dependencies &node_dependencies, const implemented_by_mapping &available_types,
+	const implemented_by_all_mapping &all_implementations, F add_edge)
+{
+	auto add_implementation_edge = [&](const type &required_type, const setter_method &setter){
+		auto implementation_it = available_types.get(required_type);
+		if (implementation_it != std::end(available_types))
+			add_edge(implementation_it->implementation_type(), setter);
+	};
+
+	for (auto &&d : node_dependencies.dependency_list())
+	{
+		if (!d.setter().is_all())
+		{
+			add_implementation_edge(d.required_type(), d.setter());
+			continue;
+		}
+
+		auto all_implementations_it = all_implementations.get(d.required_type());
+		if (all_implementations_it != std::end(all_implementations))
+			for (auto &&implementation_type : all_implementations_it->implementation_types())
+				add_implementation_edge(implementation_type, d.setter());
+	}
+}
+
+}
+
+struct dependency_graph::added_edges
+{
+	struct node_edges
+	{
+		std::vector<node_id> targets;
+		std::vector<setter_method> setters;
+	};
+
+	explicit added_edges(std::size_t size) :
+			nodes{new std::atomic<const node_edges *>[size]}
+	{
+		for (auto i = std::size_t{0}; i < size; i++)
+			nodes[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	// set once per node, written under mutex and read without it
+	std::mutex mutex;
+	std::unique_ptr<std::atomic<const node_edges *>[]> nodes;
+	std::vector<std::unique_ptr<node_edges>> owned;
+};
+
+dependency_graph::dependency_graph() :
+	_edge_offsets{0},
+	_added_edges{std::make_shared<added_edges>(0)},
+	_closures{std::make_shared<dependency_closures>()}
+{
+}
+
+dependency_graph::dependency_graph(const implemented_by_mapping &available_types, const types_dependencies &mapped_dependencies,
+	const implemented_by_all_mapping &all_implementations) :
+	_closures{std::make_shared<dependency_closures>()}
+{
+	_node_types.reserve(available_types.size() + mapped_dependencies.size());
+	for (auto &&i : available_types)
+		_node_types.push_back(i.implementation_type());
+	for (auto &&d : mapped_dependencies)
+		_node_types.push_back(d.dependent_type());
+	std::sort(std::begin(_node_types), std::end(_node_types));
+	_node_types.erase(std::unique(std::begin(_node_types), std::end(_node_types)), std::end(_node_types));
+
+	auto add_edge = [&](const type &implementation_type, const setter_method &setter){
+		_edge_targets.push_back(find(implementation_type));
+		_edge_setters.push_back(setter);
+	};
+
+	_with_dependencies = node_set{_node_types.size()};
+	_added_edges = std::make_shared<added_edges>(_node_types.size());
+	_edge_offsets.reserve(_node_types.size() + 1);
+	_edge_offsets.push_back(0);
+	for (auto &&node_type : _node_types)
+	{
+		auto dependencies_it = mapped_dependencies.get(node_type);
+		if (dependencies_it != std::end(mapped_dependencies))
+		{
+			_with_dependencies.set(_edge_offsets.size() - 1);
+			for_each_edge(*dependencies_it, available_types, all_implementations, add_edge);
+		}
+		_edge_offsets.push_back(_edge_targets.size());
+	}
+}
+
+void dependency_graph::add_edges(const types_dependencies &added_dependencies, const implemented_by_mapping &available_types,
+	const implemented_by_all_mapping &all_implementations) const
+{
+	std::lock_guard<std::mutex> lock{_added_edges->mutex};
+	for (auto &&node_dependencies : added_dependencies)
+	{
+		auto id = find(node_dependencies.dependent_type());
+		if (id == size() || _with_dependencies.test(id) || _added_edges->nodes[id].load(std::memory_order_relaxed))
+			continue;
+
+		auto edges = std::unique_ptr<added_edges::node_edges>{new added_edges::node_edges{}};
+		for_each_edge(node_dependencies, available_types, all_implementations,
+			[&](const type &implementation_type, const setter_method &setter){
+				edges->targets.push_back(find(implementation_type));
+				edges->setters.push_back(setter);
+			});
+		_added_edges->nodes[id].store(edges.get(), std::memory_order_release);
+		_added_edges->owned.push_back(std::move(edges));
+	}
+}
+
+std::size_t dependency_graph::size() const
+{
+	return _node_types.size();
+}
+
+dependency_graph::node_id dependency_graph::find(const type &implementation_type) const
+{
+	auto it = std::lower_bound(std::begin(_node_types), std::end(_node_types), implementation_type);
+	return it != std::end(_node_types) && *it == implementation_type
+		? static_cast<node_id>(it - std::begin(_node_types))
+		: size();
+}
+
+const type & dependency_graph::node_type(node_id id) const
+{
+	assert(id < size());
+	return _node_types[id];
+}
+
+contiguous_range<dependency_graph::node_id> dependency_graph::targets_of(node_id id) const
+{
+	assert(id < size());
+	auto added = _with_dependencies.test(id) ? nullptr : _added_edges->nodes[id].load(std::memory_order_acquire);
+	if (added)
+		return {added->targets.data(), added->targets.data() + added->targets.size()};
+
+	auto targets = _edge_targets.data();
+	return {targets + _edge_offsets[id], targets + _edge_offsets[id + 1]};
+}
+
+contiguous_range<setter_method> dependency_graph::setters_of(node_id id) const
+{
+	assert(id < size());
+	auto added = _with_dependencies.test(id) ? nullptr : _added_edges->nodes[id].load(std::memory_order_acquire);
+	if (added)
+		return {added->setters.data(), added->setters.data() + added->setters.size()};
+
+	auto setters = _edge_setters.data();
+	return {setters + _edge_offsets[id], setters + _edge_offsets[id + 1]};
+}
+
+const node_set & dependency_graph::closure(node_id id) const
+{
+	assert(id < size());
+	return _closures->closure(*this, id);
+}
+
+bool dependency_graph::depends_on(node_id from, node_id to) const
+{
+	assert(to < size());
+	return closure(from).test(to);
+}
+
+bool dependency_graph::in_cycle(node_id id) const
+{
+	return closure(id).test(id);
+}
+
+}}
@@ -0,0 +1,177 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "dependency-closures.h"
+#include "implemented-by-all-mapping.h"
+#include "implemented-by-mapping.h"
+#include "internal.h"
+#include "setter-method.h"
+#include "types-dependencies.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing graph of dependencies between implementation types.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Range of items stored contiguously.
+ */
+template<typename T>
+struct contiguous_range
+{
+	const T *first;
+	const T *last;
+
+	const T * begin() const { return first; }
+	const T * end() const { return last; }
+	std::size_t size() const { return static_cast<std::size_t>(last - first); }
+	bool empty() const { return first == last; }
+};
+
+/**
+ * @brief Compact graph of dependencies between implementation types.
+ *
+ * Each implementation type of a model gets a dense node id - its index in sorted list of node types.
+ * Edges are stored in compressed sparse row form: targets of edges of node i are stored contiguously
+ * between offsets i and i + 1. Each edge leads from type with a dependency to implementation type that
+ * satisfies it. Dependencies with setters tagged with INJEQT_SET_ALL have one edge per implementation
+ * of required type. Setter that caused each edge is stored in parallel array.
+ *
+ * Required types are mapped to implementation types when graph is built, so traversals do not need to
+ * look into types_model.
+ *
+ * Transitive closures of nodes are computed lazily and memoized in dependency_closures shared by all
+ * copies of graph.
+ *
+ * Graph of lazily validated configuration is built once, without dependencies that were not extracted
+ * yet. Edges of these are added later with add_edges(). Dependencies of a type never change, so added
+ * edges are memoized just like closures: they are stored once per node, outside of compressed arrays,
+ * and are shared by all copies of graph. Closures computed before remain valid, as closure of a node is
+ * only requested after dependencies of all nodes it reaches were added.
+ */
+class INJEQT_INTERNAL_API dependency_graph final
+{
+
+	struct added_edges;
+
+public:
+	using node_id = std::size_t;
+
+	/**
+	 * @brief Create empty graph.
+	 */
+	dependency_graph();
+
+	/**
+	 * @brief Create graph from parts of types_model.
+	 * @param available_types set of all interfaces mapped to implementation types
+	 * @param mapped_dependencies set of all dependencies of implementation types
+	 * @param all_implementations set of all interfaces mapped to all implementation types
+	 *
+	 * Dependencies on interfaces that are not in @p available_types do not create edges.
+	 */
+	explicit dependency_graph(const implemented_by_mapping &available_types, const types_dependencies &mapped_dependencies,
+		const implemented_by_all_mapping &all_implementations);
+
+	/**
+	 * @brief Add edges of dependencies from @p added_dependencies to graph.
+	 * @param added_dependencies dependencies that were not known when graph was built
+	 * @param available_types the same set of interfaces graph was built with
+	 * @param all_implementations the same set of interfaces graph was built with
+	 *
+	 * Only nodes that had no dependencies when graph was built and had no edges added before get new edges,
+	 * other entries of @p added_dependencies are ignored, as are dependent types that are not nodes of graph.
+	 * Cost is proportional to size of @p added_dependencies. Edges are visible in all copies of graph.
+	 */
+	void add_edges(const types_dependencies &added_dependencies, const implemented_by_mapping &available_types,
+		const implemented_by_all_mapping &all_implementations) const;
+
+	/**
+	 * @return number of nodes
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @return id of node for implementation type @p implementation_type or size() if there is none
+	 */
+	node_id find(const type &implementation_type) const;
+
+	/**
+	 * @return implementation type of node @p id
+	 * @pre id < size()
+	 */
+	const type & node_type(node_id id) const;
+
+	/**
+	 * @return ids of nodes that node @p id depends on
+	 * @pre id < size()
+	 */
+	contiguous_range<node_id> targets_of(node_id id) const;
+
+	/**
+	 * @return setters of edges of node @p id, in the same order as targets_of(node_id)
+	 * @pre id < size()
+	 */
+	contiguous_range<setter_method> setters_of(node_id id) const;
+
+	/**
+	 * @return set of all nodes that node @p id depends on, directly or indirectly
+	 * @pre id < size()
+	 *
+	 * Node is in its own closure only if it is part of dependency cycle.
+	 */
+	const node_set & closure(node_id id) const;
+
+	/**
+	 * @return true if node @p from depends on node @p to, directly or indirectly
+	 * @pre from < size()
+	 * @pre to < size()
+	 */
+	bool depends_on(node_id from, node_id to) const;
+
+	/**
+	 * @return true if node @p id is part of dependency cycle
+	 * @pre id < size()
+	 */
+	bool in_cycle(node_id id) const;
+
+private:
+	std::vector<type> _node_types;
+	std::vector<std::size_t> _edge_offsets;
+	std::vector<node_id> _edge_targets;
+	std::vector<setter_method> _edge_setters;
+	node_set _with_dependencies;
+	std::shared_ptr<added_edges> _added_edges;
+	std::shared_ptr<dependency_closures> _closures;
+
+};
+
+}}
@@ -0,0 +1,166 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for fast searching in read-only sorted data.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @addtogroup Misc
+ * @{
+ */
+
+/**
+ * @class eytzinger_index
+ * @short Copy of sorted keys stored in Eytzinger (breadth-first binary tree) order.
+ * @tparam K type of key
+ *
+ * Keys of a binary search path are stored close to each other, so first levels of tree share
+ * cache lines and next levels can be prefetched before they are needed. Result of key comparison
+ * is used to compute next node instead of choosing between branches, but comparison itself can
+ * still branch for keys like std::string. Each key is stored with its position in original sorted
+ * data. Node i of tree (with root being node 1) is stored at index i - 1.
+ *
+ * Keys are copied into index. This doubles memory used by keys like std::string, but keys that are
+ * extracted by value (like type names) are not created again on each comparison.
+ *
+ * Index does not track changes of original data, it must be built again after each change.
+ */
+template<typename K>
+class eytzinger_index
+{
+
+public:
+	using size_type = std::size_t;
+
+	/**
+	 * @short Build index from sorted data.
+	 * @param sorted_begin begin of sorted and unique data
+	 * @param sorted_end end of sorted and unique data
+	 * @param key_extractor function returning key of item from sorted data
+	 */
+	template<typename RandomAccessIterator, typename KeyExtractor>
+	void build(RandomAccessIterator sorted_begin, RandomAccessIterator sorted_end, KeyExtractor key_extractor)
+	{
+		auto size = static_cast<size_type>(sorted_end - sorted_begin);
+		_positions.assign(size, size);
+		build_positions(0, 1);
+
+		_keys.clear();
+		_keys.reserve(size);
+		for (auto &&position : _positions)
+			_keys.push_back(key_extractor(*(sorted_begin + position)));
+		_built = true;
+	}
+
+	/**
+	 * @short Drop index content.
+	 */
+	void clear()
+	{
+		_keys.clear();
+		_positions.clear();
+		_built = false;
+	}
+
+	/**
+	 * @return true if index was built with build() and not cleared
+	 */
+	bool built() const
+	{
+		return _built;
+	}
+
+	/**
+	 * @return position of first item in sorted data with key not less than @p k or size of data if there is none
+	 * @pre built()
+	 */
+	size_type lower_bound(const K &k) const
+	{
+		auto size = _keys.size();
+		auto keys = _keys.data();
+		auto i = size_type{1};
+		while (i <= size)
+		{
+			// descendants of node i few levels below are stored next to each other
+			prefetch(keys + std::min(i * keys_per_cache_line(), size) - 1);
+			i = 2 * i + static_cast<size_type>(keys[i - 1] < k);
+		}
+
+		// go up the tree to last node where search went left
+		while (i & 1)
+			i >>= 1;
+		i >>= 1;
+
+		return i == 0 ? size : _positions[i - 1];
+	}
+
+private:
+	static constexpr size_type keys_per_cache_line()
+	{
+		return sizeof(K) < 64 ? 64 / sizeof(K) : 1;
+	}
+
+	std::vector<K> _keys;
+	std::vector<size_type> _positions;
+	bool _built = false;
+
+	/**
+	 * @short Assign sorted positions to nodes of subtree with root @p i using in-order traversal.
+	 * @return next sorted position after subtree
+	 */
+	size_type build_positions(size_type sorted_position, size_type i)
+	{
+		if (i <= _positions.size())
+		{
+			sorted_position = build_positions(sorted_position, 2 * i);
+			_positions[i - 1] = sorted_position++;
+			sorted_position = build_positions(sorted_position, 2 * i + 1);
+		}
+		return sorted_position;
+	}
+
+	static void prefetch(const K *address)
+	{
+#if defined(__GNUC__)
+		__builtin_prefetch(address);
+#else
+		(void)address;
+#endif
+	}
+
+};
+
+/**
+ * @}
+ */
+
+}}
@@ -0,0 +1,44 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+namespace injeqt { namespace internal {
+
+/**
+ * @return true if @p for_type is marked with INJEQT_DONE_ON_FAST_EXIT
+ * @pre !for_type.is_empty()
+ *
+ * Objects of such types have theirs INJEQT_DONE methods called even when injector is
+ * shut down with injector::fast_exit().
+ */
+INJEQT_INTERNAL_API bool requires_done_on_fast_exit(const type &for_type);
+
+template<typename T>
+inline bool requires_done_on_fast_exit()
+{
+	return requires_done_on_fast_exit(make_type<T>());
+}
+
+}}
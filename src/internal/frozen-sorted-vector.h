@@ -0,0 +1,232 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "eytzinger-index.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing read-only sorted vectors with fast lookups.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @addtogroup Misc
+ * @{
+ */
+
+/**
+ * @class frozen_sorted_vector
+ * @short Read-only sorted_unique_vector with index of keys in Eytzinger layout.
+ * @tparam SortedVector type of wrapped sorted_unique_vector
+ *
+ * Use for tables that are built once and then only searched, like parts of types_model and list
+ * of known types. Index is built in constructor and lookups with contains_key() and get() use it
+ * instead of binary search over content. Content can not be modified, use sorted() to make a
+ * modified copy. Mutable sorted_unique_vector does not pay for the index.
+ */
+template<typename SortedVector>
+class frozen_sorted_vector
+{
+
+public:
+	using sorted_vector_type = SortedVector;
+	using value_type = typename sorted_vector_type::value_type;
+	using key_type = typename sorted_vector_type::key_type;
+	using storage_type = typename sorted_vector_type::storage_type;
+	using const_iterator = typename sorted_vector_type::const_iterator;
+	using size_type = typename sorted_vector_type::size_type;
+
+	/**
+	 * @short Create empty frozen_sorted_vector.
+	 */
+	frozen_sorted_vector()
+	{
+		build_index();
+	}
+
+	/**
+	 * @short Create frozen_sorted_vector with content of @p sorted_vector.
+	 * @param sorted_vector vector to get data from
+	 */
+	explicit frozen_sorted_vector(sorted_vector_type sorted_vector) :
+			_content{std::move(sorted_vector)}
+	{
+		build_index();
+	}
+
+	/**
+	 * @short Create frozen_sorted_vector from given vector.
+	 * @param storage vector to get data from
+	 *
+	 * Sorts content of storage and removes duplicates.
+	 */
+	explicit frozen_sorted_vector(storage_type storage) :
+			frozen_sorted_vector{sorted_vector_type{std::move(storage)}}
+	{
+	}
+
+	/**
+	 * @short Create frozen_sorted_vector from given initialization list.
+	 * @param values vector to get data from
+	 *
+	 * Sorts values and removes duplicates.
+	 */
+	explicit frozen_sorted_vector(std::initializer_list<value_type> values) :
+			frozen_sorted_vector{sorted_vector_type{std::move(values)}}
+	{
+	}
+
+	/**
+	 * @return wrapped sorted vector
+	 */
+	const sorted_vector_type & sorted() const
+	{
+		return _content;
+	}
+
+	/**
+	 * @short Allow passing frozen_sorted_vector where read-only sorted vector is expected.
+	 *
+	 * Lookups made on result use binary search instead of index.
+	 */
+	operator const sorted_vector_type & () const
+	{
+		return _content;
+	}
+
+	const_iterator begin() const
+	{
+		return _content.begin();
+	}
+
+	const_iterator end() const
+	{
+		return _content.end();
+	}
+
+	/**
+	 * @return Data stored in sorted vector.
+	 */
+	const storage_type & content() const
+	{
+		return _content.content();
+	}
+
+	/**
+	 * @return true if no data is stored
+	 */
+	bool empty() const
+	{
+		return _content.empty();
+	}
+
+	/**
+	 * @return number of stored items
+	 */
+	size_type size() const
+	{
+		return _content.size();
+	}
+
+	/**
+	 * @return true if element with value v is found
+	 */
+	bool contains(const value_type &v) const
+	{
+		auto item_it = get(sorted_vector_type::key_of(v));
+		return item_it != end() && *item_it == v;
+	}
+
+	/**
+	 * @return true if element with key k is found
+	 */
+	bool contains_key(const key_type &k) const
+	{
+		return get(k) != end();
+	}
+
+	/**
+	 * @return item with key k
+	 */
+	const_iterator get(const key_type &k) const
+	{
+		auto lower_bound = begin() + _index.lower_bound(k);
+		if (lower_bound == end())
+			return lower_bound;
+
+		return sorted_vector_type::key_of(*lower_bound) == k
+			? lower_bound
+			: end();
+	}
+
+private:
+	sorted_vector_type _content;
+	eytzinger_index<key_type> _index;
+
+	void build_index()
+	{
+		_index.build(std::begin(_content.content()), std::end(_content.content()), sorted_vector_type::key_of);
+	}
+
+};
+
+/**
+ * @return begin iterator to content of frozen_sorted_vector.
+ */
+template<typename SortedVector>
+typename frozen_sorted_vector<SortedVector>::const_iterator begin(const frozen_sorted_vector<SortedVector> &frozen_vector)
+{
+	return frozen_vector.begin();
+}
+
+/**
+ * @return end iterator to content of frozen_sorted_vector.
+ */
+template<typename SortedVector>
+typename frozen_sorted_vector<SortedVector>::const_iterator end(const frozen_sorted_vector<SortedVector> &frozen_vector)
+{
+	return frozen_vector.end();
+}
+
+template<typename SortedVector>
+bool operator == (const frozen_sorted_vector<SortedVector> &x, const frozen_sorted_vector<SortedVector> &y)
+{
+	return x.sorted() == y.sorted();
+}
+
+template<typename SortedVector>
+bool operator != (const frozen_sorted_vector<SortedVector> &x, const frozen_sorted_vector<SortedVector> &y)
+{
+	return !(x == y);
+}
+
+/**
+ * @}
+ */
+
+}}
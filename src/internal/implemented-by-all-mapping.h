@@ -0,0 +1,53 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "implemented-by-all.h"
+#include "sorted-unique-vector.h"
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing set of Injeqt implemented_by_all objects.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Extract interface type from implemented_by_all for storting purposes.
+ */
+inline type type_from_implemented_by_all(const implemented_by_all &i)
+{
+	return i.interface_type();
+}
+
+/**
+ * @brief Abstraction of Injeqt set of implemented_by_all objects.
+ *
+ * This set is used to map each interface of configured types (including ambiguous ones) to list
+ * of all configured types that implement it. It is sorted by interface types that are unique.
+ *
+ * This class is mostly used in type_relations and types_model to support multibinding.
+ */
+using implemented_by_all_mapping = sorted_unique_vector<type, implemented_by_all, type_from_implemented_by_all>;
+
+}}
@@ -0,0 +1,67 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "implemented-by-all.h"
+
+#include <injeqt/type.h>
+
+#include "interfaces-utils.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+implemented_by_all::implemented_by_all(type interface_type, types implementation_types) :
+	_interface_type{std::move(interface_type)},
+	_implementation_types{std::move(implementation_types)}
+{
+	assert(!_interface_type.is_empty());
+	assert(std::all_of(std::begin(_implementation_types), std::end(_implementation_types),
+		[this](const type &t){ return implements(t, _interface_type); }));
+}
+
+const type & implemented_by_all::interface_type() const
+{
+	return _interface_type;
+}
+
+const types & implemented_by_all::implementation_types() const
+{
+	return _implementation_types;
+}
+
+bool operator == (const implemented_by_all &x, const implemented_by_all &y)
+{
+	if (x.interface_type() != y.interface_type())
+		return false;
+
+	if (x.implementation_types() != y.implementation_types())
+		return false;
+
+	return true;
+}
+
+bool operator != (const implemented_by_all &x, const implemented_by_all &y)
+{
+	return !(x == y);
+}
+
+}}
@@ -0,0 +1,78 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+#include "types.h"
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing "interface is implemented by all of types" relations.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Represents "interface is implemented by all of types" relations.
+ *
+ * Unlike implemented_by this class does not require interface to be implemented by only one
+ * configured type. It is used for multibinding - setters tagged with INJEQT_SET_ALL and
+ * injector::get_all<T>() receive objects of all configured types that implement an interface.
+ *
+ * List of implementation types is computed once when types model is built and is stored in
+ * contiguous memory.
+ */
+class INJEQT_INTERNAL_API implemented_by_all final
+{
+
+public:
+	/**
+	 * @brief Create new instance of implemented_by_all.
+	 * @param interface_type type of interface
+	 * @param implementation_types types of all objects implementing interface
+	 * @pre !interface_type.is_empty()
+	 * @pre all of implementation_types implements interface_type
+	 */
+	explicit implemented_by_all(type interface_type, types implementation_types);
+
+	/**
+	 * @return type of interface.
+	 */
+	const type & interface_type() const;
+
+	/**
+	 * @return types of all objects implementing interface.
+	 */
+	const types & implementation_types() const;
+
+private:
+	type _interface_type;
+	types _implementation_types;
+
+};
+
+INJEQT_INTERNAL_API bool operator == (const implemented_by_all &x, const implemented_by_all &y);
+INJEQT_INTERNAL_API bool operator != (const implemented_by_all &x, const implemented_by_all &y);
+
+}}
@@ -0,0 +1,107 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "incremental-instantiation.h"
+
+#include <QtCore/QElapsedTimer>
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+incremental_instantiation::incremental_instantiation(std::function<void(const type &)> instantiate_step) :
+	_instantiate_step{std::move(instantiate_step)}
+{
+	assert(_instantiate_step);
+
+	_timer.setInterval(0);
+	QObject::connect(&_timer, &QTimer::timeout, [this](){ run_slice(); });
+}
+
+void incremental_instantiation::add(std::vector<type> steps, std::chrono::milliseconds slice_budget, finished_callback finished)
+{
+	auto r = request{};
+	r.steps = std::deque<type>{std::begin(steps), std::end(steps)};
+	r.slice_budget = slice_budget;
+	r.finished = std::move(finished);
+	_requests.push_back(std::move(r));
+
+	if (!_timer.isActive())
+		_timer.start();
+}
+
+bool incremental_instantiation::is_running() const
+{
+	return !_requests.empty();
+}
+
+void incremental_instantiation::run_slice()
+{
+	auto elapsed = QElapsedTimer{};
+	elapsed.start();
+	auto executed_any = false;
+
+	auto generation = _generation;
+	while (!_requests.empty())
+	{
+		// stays valid until clear(), as adding new requests to deque does not invalidate references
+		auto &current = _requests.front();
+		auto error = std::exception_ptr{};
+		while (!current.steps.empty() && !error)
+		{
+			if (executed_any && elapsed.elapsed() >= current.slice_budget.count())
+				return;
+
+			auto step = current.steps.front();
+			current.steps.pop_front();
+			executed_any = true;
+			try
+			{
+				_instantiate_step(step);
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+
+			// step could clear all requests, for example with fast_exit()
+			if (_generation != generation)
+				return;
+		}
+
+		auto finished = std::move(current.finished);
+		_requests.pop_front();
+		if (finished)
+			finished(error);
+
+		if (_generation != generation)
+			return;
+	}
+
+	_timer.stop();
+}
+
+void incremental_instantiation::clear()
+{
+	_generation++;
+	_requests.clear();
+	_timer.stop();
+}
+
+}}
@@ -0,0 +1,113 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <QtCore/QTimer>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for instantiating types in time slices driven by event loop.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Queue of instantiation steps executed in time slices from Qt event loop.
+ *
+ * Each request is a list of types to instantiate in order. Steps are executed by function passed to
+ * constructor, one type per step. Each slice executes steps until its time budget is exceeded (at least
+ * one step is always executed) and then returns to event loop. Next slice is scheduled with zero-timeout
+ * timer, so all pending events are processed between slices.
+ *
+ * Requests are executed in order of adding. When all steps of request are done or one of them throws,
+ * finished callback of request is called with exception (or with null pointer on success).
+ */
+class INJEQT_INTERNAL_API incremental_instantiation final
+{
+
+public:
+	/**
+	 * @brief Function called when all steps of request are done.
+	 */
+	using finished_callback = std::function<void(std::exception_ptr)>;
+
+	/**
+	 * @brief Create incremental_instantiation with @p instantiate_step function.
+	 * @param instantiate_step function called for each step
+	 */
+	explicit incremental_instantiation(std::function<void(const type &)> instantiate_step);
+
+	incremental_instantiation(const incremental_instantiation &) = delete;
+	incremental_instantiation & operator = (const incremental_instantiation &) = delete;
+
+	/**
+	 * @brief Add new request and schedule first slice if none is scheduled.
+	 * @param steps types to instantiate in order
+	 * @param slice_budget maximum time of one slice
+	 * @param finished function to call when request is done, can be empty
+	 */
+	void add(std::vector<type> steps, std::chrono::milliseconds slice_budget, finished_callback finished);
+
+	/**
+	 * @return true if any request is not finished yet
+	 */
+	bool is_running() const;
+
+	/**
+	 * @brief Execute one slice of steps.
+	 *
+	 * Called by timer, can be also called directly.
+	 */
+	void run_slice();
+
+	/**
+	 * @brief Drop all requests without calling theirs finished callbacks.
+	 *
+	 * Can be called from step or from finished callback, current slice stops then after that step.
+	 */
+	void clear();
+
+private:
+	struct request
+	{
+		std::deque<type> steps;
+		std::chrono::milliseconds slice_budget;
+		finished_callback finished;
+	};
+
+	std::function<void(const type &)> _instantiate_step;
+	std::deque<request> _requests;
+	unsigned _generation = 0;
+	QTimer _timer;
+
+};
+
+}}
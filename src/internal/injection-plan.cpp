@@ -0,0 +1,75 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "injection-plan.h"
+
+#include <QtCore/QObject>
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+injection_plan::injection_plan()
+{
+}
+
+injection_plan::injection_plan(type object_type, std::vector<resolved_dependency> resolved_dependencies,
+	std::vector<resolved_all_dependency> resolved_all_dependencies, action_methods init_actions) :
+	_object_type{std::move(object_type)},
+	_resolved_dependencies{std::move(resolved_dependencies)},
+	_resolved_all_dependencies{std::move(resolved_all_dependencies)},
+	_init_actions{std::move(init_actions)}
+{
+	assert(!_object_type.is_empty());
+}
+
+const type & injection_plan::object_type() const
+{
+	return _object_type;
+}
+
+const std::vector<resolved_dependency> & injection_plan::resolved_dependencies() const
+{
+	return _resolved_dependencies;
+}
+
+const std::vector<resolved_all_dependency> & injection_plan::resolved_all_dependencies() const
+{
+	return _resolved_all_dependencies;
+}
+
+const action_methods & injection_plan::init_actions() const
+{
+	return _init_actions;
+}
+
+void injection_plan::apply_on(QObject *on) const
+{
+	assert(on != nullptr);
+	assert(type{on->metaObject()} == _object_type);
+
+	for (auto &&resolved : _resolved_dependencies)
+		resolved.apply_on(on);
+	for (auto &&resolved_all : _resolved_all_dependencies)
+		resolved_all.first.invoke(on, resolved_all.second);
+	for (auto &&init_action : _init_actions)
+		init_action.invoke(on);
+}
+
+}}
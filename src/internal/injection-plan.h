@@ -0,0 +1,116 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "action-method.h"
+#include "internal.h"
+#include "resolved-dependency.h"
+#include "setter-method.h"
+
+#include <QtCore/QList>
+#include <utility>
+#include <vector>
+
+class QObject;
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing injection plans.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Setter tagged with INJEQT_SET_ALL with list of objects to pass to it.
+ * @see setter_method::make_parameter_list(const std::vector<QObject *> &)
+ */
+using resolved_all_dependency = std::pair<setter_method, QList<void *>>;
+
+/**
+ * @brief Everything that is required to inject dependencies into object of given type.
+ *
+ * Injection plan is computed once for a type by injector_core and then can be applied to any number
+ * of objects of that type without any reflection or dependency resolution. It contains resolved
+ * dependencies for INJEQT_SET setters, lists of objects for INJEQT_SET_ALL setters and INJEQT_INIT
+ * methods to call after all setters were called.
+ *
+ * Plan is only valid as long as objects it refers to are alive.
+ */
+class INJEQT_INTERNAL_API injection_plan final
+{
+
+public:
+	/**
+	 * @brief Create empty injection_plan.
+	 */
+	injection_plan();
+
+	/**
+	 * @brief Create new injection_plan.
+	 * @param object_type type of objects that this plan can be applied to
+	 * @param resolved_dependencies dependencies to apply on each object
+	 * @param resolved_all_dependencies INJEQT_SET_ALL setters with theirs lists of objects
+	 * @param init_actions INJEQT_INIT methods to call on each object after all dependencies were applied
+	 * @pre !object_type.is_empty()
+	 */
+	explicit injection_plan(type object_type, std::vector<resolved_dependency> resolved_dependencies,
+		std::vector<resolved_all_dependency> resolved_all_dependencies, action_methods init_actions);
+
+	/**
+	 * @return type of objects that this plan can be applied to.
+	 */
+	const type & object_type() const;
+
+	/**
+	 * @return dependencies to apply on each object.
+	 */
+	const std::vector<resolved_dependency> & resolved_dependencies() const;
+
+	/**
+	 * @return INJEQT_SET_ALL setters with theirs lists of objects.
+	 */
+	const std::vector<resolved_all_dependency> & resolved_all_dependencies() const;
+
+	/**
+	 * @return INJEQT_INIT methods to call on each object after all dependencies were applied.
+	 */
+	const action_methods & init_actions() const;
+
+	/**
+	 * @brief Apply all dependencies on @p on and call its INJEQT_INIT methods.
+	 * @param on object to apply plan on
+	 * @pre on != nullptr
+	 * @pre type{on->metaObject()} == object_type()
+	 */
+	void apply_on(QObject *on) const;
+
+private:
+	type _object_type;
+	std::vector<resolved_dependency> _resolved_dependencies;
+	std::vector<resolved_all_dependency> _resolved_all_dependencies;
+	action_methods _init_actions;
+
+};
+
+}}
@@ -0,0 +1,106 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "injector-builder.h"
+
+#include <injeqt/module.h>
+
+#include "containers.h"
+#include "injector-impl.h"
+#include "interfaces-utils.h"
+#include "module-impl.h"
+#include "provider.h"
+#include "reachability.h"
+
+namespace injeqt { namespace internal {
+
+injector_builder::injector_builder(const std::vector<std::unique_ptr<module>> &modules, const std::vector<injector_impl *> &parent_injectors)
+{
+	auto parent_types = std::vector<std::vector<type>>{};
+	parent_types.reserve(parent_injectors.size());
+	auto parent_types_count = std::size_t{0};
+	for (auto &&parent_injector : parent_injectors)
+	{
+		parent_types.push_back(parent_injector->provided_types());
+		parent_types_count += parent_types.back().size();
+	}
+
+	auto module_configurations_count = std::size_t{0};
+	for (auto &&m : modules)
+		module_configurations_count += m->_pimpl->provider_configurations().size();
+
+	// no reallocation can happen after pointers to elements are taken
+	_parent_configurations.reserve(parent_types_count);
+	_configurations.reserve(module_configurations_count + parent_types_count);
+
+	for (auto &&m : modules)
+		for (auto &&configuration : m->_pimpl->provider_configurations())
+			_configurations.push_back(configuration.get());
+
+	for (auto i = std::size_t{0}; i < parent_injectors.size(); i++)
+		for (auto &&parent_type : parent_types[i])
+		{
+			_parent_configurations.emplace_back(parent_injectors[i], parent_type);
+			_configurations.push_back(&_parent_configurations.back());
+		}
+}
+
+const std::vector<const provider_configuration *> & injector_builder::configurations() const
+{
+	return _configurations;
+}
+
+std::vector<type> injector_builder::prune(const std::vector<std::string> &root_type_names, const std::vector<std::string> &root_type_roles)
+{
+	auto pruned = prune_provider_configurations(_configurations, root_type_names, root_type_roles);
+	_configurations = std::move(pruned.reachable);
+	return std::move(pruned.pruned_types);
+}
+
+types_by_name injector_builder::known_types() const
+{
+	auto interfaces = parallel_transform(_configurations, [](const provider_configuration *configuration){
+		auto result = std::vector<type>{};
+		for (auto &&t : configuration->types())
+		{
+			auto type_interfaces = extract_interfaces(t);
+			std::copy(std::begin(type_interfaces), std::end(type_interfaces), std::back_inserter(result));
+		}
+		return result;
+	});
+
+	auto all_types_count = std::size_t{0};
+	for (auto &&configuration_interfaces : interfaces)
+		all_types_count += configuration_interfaces.size();
+
+	auto all_types = std::vector<type>{};
+	all_types.reserve(all_types_count);
+	for (auto &&configuration_interfaces : interfaces)
+		std::copy(std::begin(configuration_interfaces), std::end(configuration_interfaces), std::back_inserter(all_types));
+	return types_by_name{std::move(all_types)};
+}
+
+std::vector<std::unique_ptr<provider>> injector_builder::create_providers(const types_by_name &known_types) const
+{
+	return parallel_transform(_configurations,
+		[&known_types](const provider_configuration *configuration){ return configuration->create_provider(known_types); });
+}
+
+}}
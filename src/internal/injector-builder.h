@@ -0,0 +1,102 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+#include "provider-by-parent-injector-configuration.h"
+#include "types-by-name.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for building providers of injector from modules.
+ */
+
+namespace injeqt { namespace v1 {
+class module;
+}}
+
+namespace injeqt { namespace internal {
+
+class injector_impl;
+class provider;
+class provider_configuration;
+
+/**
+ * @brief Collects provider configurations of modules and parent injectors and creates providers from them.
+ *
+ * All configurations are collected once, in constructor, into one contiguous list of pointers. Configurations
+ * of modules are not copied - they are owned by modules, which must outlive builder. Configurations for types
+ * of parent injectors are stored by value in storage reserved up front. Known types and providers are then
+ * created with one pass over this list each.
+ *
+ * Builder holds pointers to its own storage, so it can not be copied or moved.
+ */
+class INJEQT_INTERNAL_API injector_builder final
+{
+
+public:
+	/**
+	 * @brief Collect configurations of @p modules and of types provided by @p parent_injectors.
+	 */
+	explicit injector_builder(const std::vector<std::unique_ptr<::injeqt::v1::module>> &modules,
+		const std::vector<injector_impl *> &parent_injectors = std::vector<injector_impl *>{});
+
+	injector_builder(const injector_builder &) = delete;
+	injector_builder(injector_builder &&) = delete;
+	injector_builder & operator = (const injector_builder &) = delete;
+	injector_builder & operator = (injector_builder &&) = delete;
+
+	/**
+	 * @return list of collected configurations, in order of modules, parent injectors last
+	 */
+	const std::vector<const provider_configuration *> & configurations() const;
+
+	/**
+	 * @brief Remove configurations not reachable from roots.
+	 * @return provided types of removed configurations
+	 * @see prune_provider_configurations()
+	 */
+	std::vector<type> prune(const std::vector<std::string> &root_type_names, const std::vector<std::string> &root_type_roles);
+
+	/**
+	 * @return all types known to collected configurations with all theirs interfaces
+	 */
+	types_by_name known_types() const;
+
+	/**
+	 * @return providers created from collected configurations, in order of configurations
+	 */
+	std::vector<std::unique_ptr<provider>> create_providers(const types_by_name &known_types) const;
+
+private:
+	std::vector<provider_by_parent_injector_configuration> _parent_configurations;
+	std::vector<const provider_configuration *> _configurations;
+
+};
+
+}}
@@ -0,0 +1,96 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+#include <injeqt/validation-mode.h>
+
+#include "ready-objects.h"
+#include "types.h"
+#include "types-by-name.h"
+#include "types-model.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing immutable snapshot of injector configuration.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Immutable snapshot of configuration of injector_core.
+ *
+ * Snapshot is created when injector_core is constructed and each time its configuration changes.
+ * It is never modified after being published - new snapshot is created as modified copy of previous
+ * one and replaces it atomically. Operations that started with old snapshot keep reference to it and
+ * finish with it, old snapshot is destroyed when last such operation ends.
+ *
+ * The only part of snapshot that changes after publishing is table of ready objects. Its slots are
+ * filled once, when objects of configured types are created and initialized, so readers can get these
+ * objects from snapshot without taking any lock.
+ */
+struct injector_configuration
+{
+	/**
+	 * @brief All types known to injector, including all interfaces of provided types.
+	 */
+	types_by_name known_types;
+
+	/**
+	 * @brief Relations and dependencies of all provided types.
+	 */
+	types_model model;
+
+	/**
+	 * @brief Index of provided types by roles declared with INJEQT_TYPE_ROLE.
+	 */
+	std::map<std::string, types> types_by_role;
+
+	/**
+	 * @brief List of all types with configured providers.
+	 */
+	std::vector<type> provided_types;
+
+	/**
+	 * @brief When dependencies of provided types are extracted and validated.
+	 */
+	validation_mode validation = validation_mode::eager;
+
+	/**
+	 * @brief Implementation types with dependencies already extracted and validated in validation_mode::lazy.
+	 */
+	types validated_types;
+
+	/**
+	 * @brief Created and initialized objects, indexed as interface types in model.available_types().
+	 *
+	 * Can be null in snapshot of empty injector_core.
+	 */
+	std::shared_ptr<ready_objects> objects;
+};
+
+}}
@@ -23,10 +23,12 @@
 #include <injeqt/exception/ambiguous-types.h>
 #include <injeqt/exception/unavailable-required-types.h>
 #include <injeqt/exception/unknown-type.h>
+#include <injeqt/exception/unresolvable-dependencies.h>
 #include <injeqt/module.h>
 
 #include "action-method.h"
 #include "containers.h"
+#include "fast-exit.h"
 #include "interfaces-utils.h"
 #include "provided-object.h"
 #include "provider-by-default-constructor.h"
@@ -36,44 +38,48 @@
 #include "required-to-satisfy.h"
 #include "resolve-dependencies.h"
 #include "resolved-dependency.h"
+#include "startup-analysis.h"
 #include "type-role.h"
+#include "types-model-cache.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <set>
 
 namespace injeqt { namespace internal {
 
-injector_core::injector_core()
+injector_core::injector_core() :
+	_configuration{std::make_shared<injector_configuration>()}
 {
 }
 
-injector_core::injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers) :
-	_known_types{std::move(known_types)}
+injector_core::injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers,
+	const QString &types_model_cache_file_name, validation_mode validation)
 {
 	auto all_providers_size = all_providers.size();
-	_available_providers = providers{std::move(all_providers)};
+	_available_providers = make_providers(std::move(all_providers));
 
 	// some types were removed, because of duplication
 	if (_available_providers.size() != all_providers_size)
 		throw exception::ambiguous_types{}; // TODO: find a way to extract type names
 
-	_types_model = create_types_model();
+	auto configuration = injector_configuration{};
+	configuration.model = create_types_model(known_types, types_model_cache_file_name, validation);
+	configuration.validation = validation;
+	configuration.known_types = std::move(known_types);
+	add_types_by_role(configuration.types_by_role, _available_providers);
+	std::transform(std::begin(_available_providers), std::end(_available_providers), std::back_inserter(configuration.provided_types), type_from_provider);
 
-	auto required_types = std::vector<type>{};
-	for (auto &&p : _available_providers)
-		for (auto &&r : p->required_types())
-			required_types.push_back(r);
-
-	auto unavailable_required_types = match(types{required_types}, _types_model.available_types()).unmatched_1;
-	if (!unavailable_required_types.empty())
-	{
-		auto message = std::string{};
-		for (auto &&t : unavailable_required_types)
-		{
-			message.append(t.name());
-			message.append("\n");
-		}
-		throw exception::unavailable_required_types{message};
-	}
+	if (validation == validation_mode::eager)
+		validate_required_types(_available_providers, configuration.model);
+	add_dependents(configuration.model.mapped_dependencies(), _available_providers);
+	_objects.reserve(configuration.model.available_types().size());
+	_resolved_objects.reserve(_available_providers.size());
+	publish(std::move(configuration));
 }
 
 injector_core::~injector_core()
@@ -82,27 +88,483 @@ injector_core::~injector_core()
 		call_done_methods(resolved_object.object());
 }
 
-types_model injector_core::create_types_model() const
+std::shared_ptr<const injector_configuration> injector_core::configuration() const
+{
+	return std::atomic_load(&_configuration);
+}
+
+void injector_core::publish(injector_configuration configuration)
+{
+	auto not_published = std::set<QObject *>{};
+	for (auto &&new_object : _new_objects)
+		not_published.insert(new_object.object());
+
+	auto &available_types = configuration.model.available_types();
+	configuration.objects = std::make_shared<ready_objects>(available_types.size());
+	for (auto i = std::begin(available_types), e = std::end(available_types); i != e; ++i)
+	{
+		auto object_it = _objects.get(i->interface_type());
+		if (object_it != std::end(_objects) && not_published.find(object_it->object()) == std::end(not_published))
+			configuration.objects->set(std::distance(std::begin(available_types), i), object_it->object());
+	}
+
+	std::atomic_store(&_configuration, std::shared_ptr<const injector_configuration>{std::make_shared<injector_configuration>(std::move(configuration))});
+	// plans and lists reference objects resolved with previous configuration
+	_configuration_generation++;
+	_injection_plans.clear();
+	_parameter_lists.clear();
+}
+
+const node_set & injector_core::ready_nodes(const types_model &model)
+{
+	// _ready_model keeps its graph alive, so address of graph can not be reused by other one
+	if (&_ready_model.graph() != &model.graph())
+	{
+		_ready_nodes = internal::ready_nodes(model, _objects);
+		_ready_model = model;
+	}
+	return _ready_nodes;
+}
+
+void injector_core::reset_ready_nodes()
+{
+	_ready_model = types_model{};
+	_ready_nodes = node_set{};
+}
+
+std::shared_ptr<const injector_configuration> injector_core::validated_configuration(const std::vector<type> &implementation_types)
+{
+	auto current = configuration();
+	if (current->validation == validation_mode::eager)
+		return current;
+
+	auto to_validate = implementation_types;
+	auto newly_validated = std::vector<type>{};
+	auto new_dependencies = std::vector<type_dependencies>{};
+	auto visited_interfaces = std::set<type>{};
+	while (!to_validate.empty())
+	{
+		auto implementation_type = to_validate.back();
+		to_validate.pop_back();
+
+		if (current->validated_types.contains_key(implementation_type)
+			|| std::find(std::begin(newly_validated), std::end(newly_validated), implementation_type) != std::end(newly_validated))
+			continue;
+
+		// unknown types are reported by callers
+		auto provider_it = _available_providers.get(implementation_type);
+		if (provider_it == std::end(_available_providers))
+			continue;
+		newly_validated.push_back(implementation_type);
+
+		// copied, so nothing points into provider table while rest of type is validated
+		auto required_types = provider_it->required_types();
+		auto require_resolving = provider_it->require_resolving();
+		for (auto &&required_type : required_types)
+		{
+			if (!current->model.contains(required_type))
+				throw exception::unavailable_required_types{required_type.name() + "\n"};
+			to_validate.push_back(implementation_for(*current, required_type));
+		}
+
+		if (!require_resolving)
+			continue;
+
+		for (auto &&interface_type : extract_interfaces(implementation_type))
+		{
+			if (!visited_interfaces.insert(interface_type).second)
+				continue;
+
+			auto dependencies_it = current->model.mapped_dependencies().get(interface_type);
+			auto interface_dependencies = dependencies_it != std::end(current->model.mapped_dependencies())
+				? *dependencies_it
+				: make_type_dependencies(current->known_types, interface_type);
+			if (dependencies_it == std::end(current->model.mapped_dependencies()))
+				new_dependencies.push_back(interface_dependencies);
+
+			for (auto &&dependency : interface_dependencies.dependency_list())
+			{
+				auto &dependency_types = current->model.all_implementations_of(dependency.required_type());
+				std::copy(std::begin(dependency_types), std::end(dependency_types), std::back_inserter(to_validate));
+			}
+		}
+	}
+
+	if (newly_validated.empty())
+		return current;
+
+	auto added_dependencies = types_dependencies{new_dependencies};
+	auto model = extend_types_dependencies(current->model, added_dependencies);
+
+	// nothing can throw below this line
+
+	add_type_dependents(_dependents, added_dependencies);
+
+	auto next = injector_configuration{*current};
+	next.model = std::move(model);
+	next.validated_types.add_all(std::move(newly_validated));
+	publish(std::move(next));
+
+	return configuration();
+}
+
+types_model injector_core::create_types_model(const types_by_name &known_types, const QString &cache_file_name, validation_mode validation) const
 {
 	auto all_types = std::vector<type>{};
 	auto need_dependencies = std::vector<type>{};
 	for (auto &&p : _available_providers)
 	{
-		all_types.push_back(p->provided_type());
-		if (p->require_resolving())
+		all_types.push_back(p.provided_type());
+		if (p.require_resolving())
 		{
-			auto interfaces = extract_interfaces(p->provided_type());
+			auto interfaces = extract_interfaces(p.provided_type());
+			std::copy(std::begin(interfaces), std::end(interfaces), std::back_inserter(need_dependencies));
+		}
+	}
+	if (validation == validation_mode::lazy)
+		return make_types_model(known_types, all_types, std::vector<type>{});
+	if (cache_file_name.isEmpty() || all_types.empty())
+		return make_types_model(known_types, all_types, need_dependencies);
+
+	auto key = make_types_model_cache_key(all_types, need_dependencies);
+	QFile cache_file{cache_file_name};
+	if (cache_file.open(QIODevice::ReadOnly))
+	{
+		auto size = cache_file.size();
+		auto data = cache_file.map(0, size);
+		if (data)
+		{
+			// each configured type implements at least itself, so empty model means cache miss
+			auto cached = read_types_model_cache(reinterpret_cast<const char *>(data), size, key, known_types);
+			cache_file.unmap(data);
+			if (!cached.available_types().empty())
+				return cached;
+		}
+		cache_file.close();
+	}
+
+	auto result = make_types_model(known_types, all_types, need_dependencies);
+
+	QSaveFile save_file{cache_file_name};
+	if (save_file.open(QIODevice::WriteOnly))
+	{
+		save_file.write(write_types_model_cache(result, key));
+		save_file.commit();
+	}
+
+	return result;
+}
+
+void injector_core::add_providers(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&new_providers)
+{
+	auto new_providers_size = new_providers.size();
+	auto added_providers = make_providers(std::move(new_providers));
+
+	// some types were removed, because of duplication
+	if (added_providers.size() != new_providers_size)
+		throw exception::ambiguous_types{};
+
+	auto current = configuration();
+	auto new_types = std::vector<type>{};
+	auto need_dependencies = std::vector<type>{};
+	auto no_longer_available = std::vector<type>{};
+	for (auto &&p : added_providers)
+	{
+		if (_available_providers.contains_key(p.provided_type()))
+			throw exception::ambiguous_types{p.provided_type().name()};
+
+		new_types.push_back(p.provided_type());
+		auto interfaces = extract_interfaces(p.provided_type());
+		for (auto &&interface_type : interfaces)
+			if (current->model.contains(interface_type))
+				no_longer_available.push_back(interface_type);
+		if (p.require_resolving() && current->validation == validation_mode::eager)
 			std::copy(std::begin(interfaces), std::end(interfaces), std::back_inserter(need_dependencies));
+	}
+
+	auto model = extend_types_model(current->model, known_types, new_types, need_dependencies);
+	if (current->validation == validation_mode::eager)
+		validate_required_types(added_providers, model);
+	if (!no_longer_available.empty())
+		validate_required_types(_available_providers, model);
+
+	// nothing can throw below this line
+
+	if (!no_longer_available.empty())
+	{
+		auto still_available = std::vector<implementation>{};
+		std::copy_if(std::begin(_objects), std::end(_objects), std::back_inserter(still_available),
+			[&](const implementation &i){ return std::find(std::begin(no_longer_available), std::end(no_longer_available), i.interface_type()) == std::end(no_longer_available); });
+		_objects = implementations{still_available};
+		reset_ready_nodes();
+	}
+
+	auto added_dependencies = std::vector<type_dependencies>{};
+	for (auto &&dependent_type : need_dependencies)
+	{
+		auto dependencies_it = model.mapped_dependencies().get(dependent_type);
+		if (dependencies_it != std::end(model.mapped_dependencies()))
+			added_dependencies.push_back(*dependencies_it);
+	}
+	add_dependents(types_dependencies{added_dependencies}, added_providers);
+
+	auto next = injector_configuration{*current};
+	add_types_by_role(next.types_by_role, added_providers);
+	std::copy(std::begin(new_types), std::end(new_types), std::back_inserter(next.provided_types));
+	next.known_types = std::move(known_types);
+	next.model = std::move(model);
+
+	_available_providers.merge(std::move(added_providers));
+	// lists of INJEQT_SET_ALL objects may have changed, so plans are dropped as well
+	publish(std::move(next));
+}
+
+void injector_core::remove_providers(const std::vector<type> &removed_types)
+{
+	assert(std::all_of(std::begin(removed_types), std::end(removed_types),
+		[&](const type &t){ return _available_providers.contains_key(t); }));
+
+	auto is_removed = [&](const type &t){ return std::find(std::begin(removed_types), std::end(removed_types), t) != std::end(removed_types); };
+
+	auto current = configuration();
+	auto model = reduce_types_model(current->model, removed_types);
+	validate_removal(*current, removed_types, model);
+
+	// nothing can throw below this line
+
+	auto next = injector_configuration{*current};
+	auto invalidated_types = transitive_dependents(_dependents, current->model, removed_types);
+	auto invalidated_objects = std::set<QObject *>{};
+	for (auto i = invalidated_types.rbegin(), e = invalidated_types.rend(); i != e; ++i)
+	{
+		auto object_it = _objects.get(*i);
+		if (object_it == std::end(_objects))
+			continue;
+
+		invalidated_objects.insert(object_it->object());
+		if (_resolved_objects.contains_key(*i))
+			call_done_methods(object_it->object());
+	}
+
+	auto is_valid = [&](const implementation &i){ return invalidated_objects.find(i.object()) == std::end(invalidated_objects); };
+	auto valid_objects = std::vector<implementation>{};
+	std::copy_if(std::begin(_objects), std::end(_objects), std::back_inserter(valid_objects), is_valid);
+	_objects = implementations{valid_objects};
+	reset_ready_nodes();
+	auto valid_resolved_objects = std::vector<implementation>{};
+	std::copy_if(std::begin(_resolved_objects), std::end(_resolved_objects), std::back_inserter(valid_resolved_objects), is_valid);
+	_resolved_objects = implementations{valid_resolved_objects};
+	_new_objects.erase(std::remove_if(std::begin(_new_objects), std::end(_new_objects),
+		[&](const implementation &i){ return !is_valid(i); }), std::end(_new_objects));
+
+	auto removed_interfaces = std::vector<type>{};
+	for (auto &&removed_type : removed_types)
+		for (auto &&interface_type : extract_interfaces(removed_type))
+		{
+			// interface that was ambiguous can have only one implementation left
+			if (!current->model.contains(interface_type) && model.contains(interface_type))
+			{
+				auto object_it = _objects.get(model.available_types().get(interface_type)->implementation_type());
+				if (object_it != std::end(_objects))
+					_objects.add(implementation{interface_type, object_it->object()});
+			}
+			if (model.all_implementations_of(interface_type).empty())
+				removed_interfaces.push_back(interface_type);
+
+			auto dependencies_it = current->model.mapped_dependencies().get(interface_type);
+			if (dependencies_it != std::end(current->model.mapped_dependencies()) && !model.mapped_dependencies().contains_key(interface_type))
+				remove_type_dependents(_dependents, *dependencies_it);
 		}
+
+	for (auto &&removed_type : removed_types)
+		for (auto &&type_role : extract_type_roles(removed_type))
+		{
+			auto role_types = std::vector<type>{};
+			std::copy_if(std::begin(next.types_by_role[type_role]), std::end(next.types_by_role[type_role]), std::back_inserter(role_types),
+				[&](const type &t){ return !is_removed(t); });
+			if (role_types.empty())
+				next.types_by_role.erase(type_role);
+			else
+				next.types_by_role[type_role] = types{role_types};
+		}
+
+	if (!removed_interfaces.empty())
+	{
+		auto still_known_types = std::vector<type>{};
+		std::copy_if(std::begin(next.known_types), std::end(next.known_types), std::back_inserter(still_known_types),
+			[&](const type &t){ return std::find(std::begin(removed_interfaces), std::end(removed_interfaces), t) == std::end(removed_interfaces); });
+		next.known_types = types_by_name{std::move(still_known_types)};
 	}
-	return make_types_model(_known_types, all_types, need_dependencies);
+
+	next.provided_types.erase(std::remove_if(std::begin(next.provided_types), std::end(next.provided_types), is_removed), std::end(next.provided_types));
+	next.model = std::move(model);
+
+	auto remaining_providers = std::vector<provider_entry>{};
+	auto removed_providers = std::vector<provider_entry>{};
+	for (auto &&p : _available_providers.take())
+		if (is_removed(p.provided_type()))
+		{
+			for (auto &&required_type : p.required_types())
+				remove_type_dependent(_dependents, required_type, p.provided_type());
+			removed_providers.push_back(std::move(p));
+		}
+		else
+		{
+			if (std::find(std::begin(invalidated_types), std::end(invalidated_types), p.provided_type()) != std::end(invalidated_types))
+				p.get()->reset();
+			remaining_providers.push_back(std::move(p));
+		}
+
+	_available_providers = providers{std::move(remaining_providers)};
+	publish(std::move(next));
+
+	// destroys objects of removed types
+	removed_providers.clear();
+}
+
+void injector_core::validate_removal(const injector_configuration &configuration, const std::vector<type> &removed_types, const types_model &model) const
+{
+	auto unresolvable_message = std::string{};
+	auto unavailable_message = std::string{};
+
+	for (auto &&removed_type : removed_types)
+		for (auto &&interface_type : extract_interfaces(removed_type))
+		{
+			if (!configuration.model.contains(interface_type) || model.contains(interface_type))
+				continue;
+
+			auto dependents_it = _dependents.find(interface_type);
+			if (dependents_it == std::end(_dependents))
+				continue;
+
+			for (auto &&dependent_type : dependents_it->second)
+			{
+				auto dependencies_it = model.mapped_dependencies().get(dependent_type);
+				if (dependencies_it != std::end(model.mapped_dependencies()))
+					for (auto &&dependency : dependencies_it->dependency_list())
+						if (!dependency.setter().is_all() && dependency.required_type() == interface_type)
+						{
+							unresolvable_message.append(interface_type.name());
+							unresolvable_message.append(": ");
+							unresolvable_message.append(dependency.setter().signature());
+							unresolvable_message.append("\n");
+						}
+
+				auto provider_it = _available_providers.get(dependent_type);
+				if (provider_it != std::end(_available_providers) && !model.all_implementations_of(dependent_type).empty()
+					&& provider_it->required_types().contains(interface_type))
+				{
+					unavailable_message.append(interface_type.name());
+					unavailable_message.append("\n");
+				}
+			}
+		}
+
+	if (!unresolvable_message.empty())
+		throw exception::unresolvable_dependencies{unresolvable_message};
+	if (!unavailable_message.empty())
+		throw exception::unavailable_required_types{unavailable_message};
+}
+
+void injector_core::add_dependents(const types_dependencies &dependencies, const providers &dependent_providers)
+{
+	add_type_dependents(_dependents, dependencies);
+	for (auto &&p : dependent_providers)
+		for (auto &&required_type : p.required_types())
+			add_type_dependent(_dependents, required_type, p.provided_type());
+}
+
+void injector_core::validate_required_types(const providers &providers_to_check, const types_model &model) const
+{
+	auto required_types = std::vector<type>{};
+	for (auto &&p : providers_to_check)
+		for (auto &&r : p.required_types())
+			required_types.push_back(r);
+
+	auto message = std::string{};
+	match_visit(types{std::move(required_types)}, model.available_types().sorted(), ignore_match{},
+		[&](const type &t){ message.append(t.name()); message.append("\n"); },
+		ignore_match{});
+	if (!message.empty())
+		throw exception::unavailable_required_types{message};
+}
+
+void injector_core::add_types_by_role(std::map<std::string, types> &types_by_role, const providers &new_providers) const
+{
+	auto new_types_by_role = std::map<std::string, std::vector<type>>{};
+	for (auto &&p : new_providers)
+		for (auto &&type_role : extract_type_roles(p.provided_type()))
+			new_types_by_role[type_role].push_back(p.provided_type());
+
+	for (auto &&role_types : new_types_by_role)
+		types_by_role[role_types.first].add_all(std::move(role_types.second));
 }
 
 std::vector<type> injector_core::provided_types() const
 {
-	auto result = std::vector<type>{};
-	std::transform(std::begin(_available_providers), std::end(_available_providers), std::back_inserter(result), type_from_provider);
-	return result;
+	return configuration()->provided_types;
+}
+
+QObject * injector_core::ready_object(const type &interface_type) const
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	return ready_object(*configuration(), interface_type);
+}
+
+std::vector<QObject *> injector_core::ready_objects_of(const type &interface_type) const
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	auto current = configuration();
+	return ready_objects_of(*current, current->model.all_implementations_of(interface_type));
+}
+
+std::vector<QObject *> injector_core::ready_objects_with_type_role(const std::string &type_role) const
+{
+	auto current = configuration();
+	auto role_types_it = current->types_by_role.find(type_role);
+	if (role_types_it == std::end(current->types_by_role))
+		return {};
+
+	return ready_objects_of(*current, role_types_it->second);
+}
+
+QObject * injector_core::ready_object(const injector_configuration &configuration, const type &interface_type) const
+{
+	if (!configuration.objects)
+		return nullptr;
+
+	auto &available_types = configuration.model.available_types();
+	auto interface_it = available_types.get(interface_type);
+	if (interface_it == std::end(available_types))
+		return nullptr;
+
+	return configuration.objects->get(std::distance(std::begin(available_types), interface_it));
+}
+
+void injector_core::publish_new_objects(QThread *move_to)
+{
+	if (_new_objects.empty())
+		return;
+
+	auto current = configuration();
+	auto &available_types = current->model.available_types();
+	for (auto &&new_object : _new_objects)
+	{
+		// object is listed once for each of its interfaces, but it is moved only on first one
+		auto object = new_object.object();
+		if (move_to && object->thread() == QThread::currentThread() && !object->parent())
+			object->moveToThread(move_to);
+
+		// configuration could change since object was created
+		auto interface_it = available_types.get(new_object.interface_type());
+		if (interface_it != std::end(available_types))
+			current->objects->set(std::distance(std::begin(available_types), interface_it), new_object.object());
+	}
+	_new_objects.clear();
 }
 
 void injector_core::instantiate(const type &interface_type)
@@ -112,19 +574,51 @@ void injector_core::instantiate(const type &interface_type)
 
 	auto object_it = _objects.get(interface_type);
 	if (object_it == end(_objects))
-		instantiate_interface(interface_type);
+	{
+		auto implementation_type = implementation_for(*configuration(), interface_type);
+		instantiate_implementation(*validated_configuration(std::vector<type>{implementation_type}), implementation_type);
+	}
 }
 
 void injector_core::instantiate_all_with_type_role(const std::string &type_role)
 {
-	for (auto &&provider : _available_providers)
+	auto current = configuration();
+	auto role_types_it = current->types_by_role.find(type_role);
+	if (role_types_it != std::end(current->types_by_role))
 	{
-		auto type = provider->provided_type();
-		if (has_type_role(type, type_role))
-			instantiate_interface(type);
+		auto &role_types = role_types_it->second;
+		instantiate_implementations(*validated_configuration(std::vector<type>{std::begin(role_types), std::end(role_types)}), role_types);
 	}
 }
 
+std::vector<QObject *> injector_core::get_all_with_type_role(const std::string &type_role)
+{
+	auto current = configuration();
+	auto role_types_it = current->types_by_role.find(type_role);
+	if (role_types_it == std::end(current->types_by_role))
+		return {};
+
+	auto &role_types = role_types_it->second;
+	instantiate_implementations(*validated_configuration(std::vector<type>{std::begin(role_types), std::end(role_types)}), role_types);
+
+	auto result = std::vector<QObject *>{};
+	result.reserve(role_types_it->second.size());
+	for (auto &&role_type : role_types_it->second)
+		result.push_back(_objects.get(role_type)->object());
+	return result;
+}
+
+std::vector<QObject *> injector_core::get_all(const type &interface_type)
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	auto implementation_types = configuration()->model.all_implementations_of(interface_type);
+	auto current = validated_configuration(std::vector<type>{std::begin(implementation_types), std::end(implementation_types)});
+	instantiate_implementations(*current, current->model.all_implementations_of(interface_type));
+	return all_objects_of(*current, interface_type);
+}
+
 QObject * injector_core::get(const type &interface_type)
 {
 	assert(!interface_type.is_empty());
@@ -134,59 +628,86 @@ QObject * injector_core::get(const type &interface_type)
 	return _objects.get(interface_type)->object();
 }
 
-void injector_core::instantiate_interface(const type &interface_type)
+void injector_core::instantiate_interface(const injector_configuration &configuration, const type &interface_type)
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	instantiate_implementation(implementation_for(interface_type));
+	instantiate_implementation(configuration, implementation_for(configuration, interface_type));
 }
 
-type injector_core::implementation_for(const type &interface_type) const
+type injector_core::implementation_for(const injector_configuration &configuration, const type &interface_type) const
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	auto implementation_type_it = _types_model.available_types().get(interface_type);
-	if (implementation_type_it == end(_types_model.available_types()))
+	auto implementation_type_it = configuration.model.available_types().get(interface_type);
+	if (implementation_type_it == end(configuration.model.available_types()))
 		throw exception::unknown_type{interface_type.name()};
 	return implementation_type_it->implementation_type();
 }
 
-void injector_core::instantiate_implementation(const type &implementation_type)
+void injector_core::instantiate_implementation(const injector_configuration &configuration, const type &implementation_type)
 {
 	assert(!implementation_type.is_empty());
 	assert(!implementation_type.is_qobject());
 
-	auto types_to_instantiate = required_to_satisfy(implementation_type_dependencies(implementation_type), _types_model, _objects);
-	types_to_instantiate.add(implementation_type);
-	instantiate_all(types_to_instantiate);
+	instantiate_implementations(configuration, types{implementation_type});
 }
 
-dependencies injector_core::implementation_type_dependencies(const type &implementation_type) const
+void injector_core::instantiate_implementations(const injector_configuration &configuration, const types &implementation_types)
+{
+	auto all_dependencies = std::vector<dependency>{};
+	for (auto &&implementation_type : implementation_types)
+	{
+		assert(!implementation_type.is_empty());
+		assert(!implementation_type.is_qobject());
+
+		auto implementation_dependencies = implementation_type_dependencies(configuration, implementation_type);
+		std::copy(std::begin(implementation_dependencies), std::end(implementation_dependencies), std::back_inserter(all_dependencies));
+	}
+
+	auto types_to_instantiate = required_to_satisfy(dependencies{all_dependencies}, configuration.model, ready_nodes(configuration.model));
+	types_to_instantiate.merge(implementation_types);
+	instantiate_all(configuration, types_to_instantiate);
+}
+
+dependencies injector_core::implementation_type_dependencies(const injector_configuration &configuration, const type &implementation_type) const
 {
 	assert(!implementation_type.is_empty());
 	assert(!implementation_type.is_qobject());
 
-	return _types_model.mapped_dependencies().contains_key(implementation_type)
-			? _types_model.mapped_dependencies().get(implementation_type)->dependency_list()
+	return configuration.model.mapped_dependencies().contains_key(implementation_type)
+			? configuration.model.mapped_dependencies().get(implementation_type)->dependency_list()
 			: dependencies{};
 }
 
-void injector_core::instantiate_all(const types &interface_types)
+void injector_core::instantiate_all(const injector_configuration &configuration, const types &interface_types)
 {
-	instantiate_required_types_for(interface_types);
+	instantiate_required_types_for(configuration, interface_types);
+
+	auto provided_objects = provide_objects(non_instantiated(interface_types));
+	auto stored_objects = objects_to_store(configuration, extract_implementations(provided_objects));
+	_objects.add_all(stored_objects);
+	mark_ready(_ready_nodes, _ready_model, stored_objects);
+	resolve_objects(configuration, objects_to_resolve(provided_objects));
 
-	auto provided_objects = provide_objects(providers_for(non_instantiated(interface_types)));
-	_objects.merge(implementations{objects_to_store(extract_implementations(provided_objects))});
-	resolve_objects(objects_to_resolve(provided_objects));
+	// objects can be seen by other threads only after theirs INJEQT_INIT methods were called
+	std::move(std::begin(stored_objects), std::end(stored_objects), std::back_inserter(_new_objects));
 }
 
-void injector_core::instantiate_required_types_for(const types &types_to_instantiate)
+void injector_core::instantiate_required_types_for(const injector_configuration &configuration, const types &types_to_instantiate)
 {
-	for (auto &&provider : providers_for(types_to_instantiate))
-		for (auto &&required_type : provider->required_types())
-			instantiate_interface(required_type);
+	// instantiating a type can add modules and move provider entries, so required types are copied first
+	auto required_types = std::vector<type>{};
+	for (auto &&type_to_instantiate : types_to_instantiate)
+	{
+		auto &entry_required_types = provider_for(type_to_instantiate).required_types();
+		std::copy(std::begin(entry_required_types), std::end(entry_required_types), std::back_inserter(required_types));
+	}
+
+	for (auto &&required_type : required_types)
+		instantiate_interface(configuration, required_type);
 }
 
 std::vector<type> injector_core::non_instantiated(const types &to_filter) const
@@ -199,15 +720,22 @@ std::vector<type> injector_core::non_instantiated(const types &to_filter) const
 	return result;
 }
 
-std::vector<provided_object> injector_core::provide_objects(const std::vector<provider *> &providers)
+std::vector<provided_object> injector_core::provide_objects(const std::vector<type> &implementation_types)
 {
 	auto result = std::vector<provided_object>{};
-	result.reserve(providers.size());
-	for (auto &&provider : providers)
+	result.reserve(implementation_types.size());
+	for (auto &&implementation_type : implementation_types)
 	{
-		auto instance = provider->provide(*this);
-		auto i = make_implementation(provider->provided_type(), instance);
-		result.push_back(provided_object{provider, i});
+		// entry is looked up for each type, as previous providers could have added modules
+		auto p = provider_for(implementation_type).get();
+		auto instance = static_cast<QObject *>(nullptr);
+		if (_profile_recording)
+			_profile.add_build(implementation_type, measure_self_time([&](){ instance = p->provide(*this); }));
+		else
+			instance = p->provide(*this);
+
+		auto i = make_implementation(implementation_type, instance);
+		result.push_back(provided_object{p, i});
 	}
 	return result;
 }
@@ -231,38 +759,39 @@ std::vector<implementation> injector_core::extract_implementations(const std::ve
 	return result;
 }
 
-std::vector<implementation> injector_core::objects_to_store(const std::vector<implementation> &objects) const
+std::vector<implementation> injector_core::objects_to_store(const injector_configuration &configuration, const std::vector<implementation> &objects) const
 {
 	auto result = std::vector<implementation>{};
 	for (auto &&object : objects)
 	{
 		auto interfaces = extract_interfaces(object.interface_type());
-		auto matched = match(interfaces, _types_model.available_types()).matched;
-		for (auto &&m : matched)
-		{
-			auto i = implementation{m.first, object.object()}; // no need to check preconditions again with make_implementation
-			result.emplace_back(i);
-		}
+		match_visit(interfaces, configuration.model.available_types().sorted(),
+			// no need to check preconditions again with make_implementation
+			[&](const type &interface_type, const implemented_by &){ result.emplace_back(implementation{interface_type, object.object()}); },
+			ignore_match{}, ignore_match{});
 	}
 	return result;
 }
 
-void injector_core::resolve_objects(const std::vector<implementation> &objects)
+void injector_core::resolve_objects(const injector_configuration &configuration, const std::vector<implementation> &objects)
 {
 	for (auto &&object : objects)
-		resolve_object(object);
+		resolve_object(configuration, object);
 	for (auto &&object : objects)
-		call_init_methods(object.object());
-	_resolved_objects.merge(implementations{objects});
+		if (_profile_recording)
+			_profile.add_init(object.interface_type(), measure_self_time([&](){ call_init_methods(object.object()); }));
+		else
+			call_init_methods(object.object());
+	_resolved_objects.add_all(objects);
 }
 
-void injector_core::resolve_object(const implementation &object) const
+void injector_core::resolve_object(const injector_configuration &configuration, const implementation &object)
 {
-	auto object_dependencies = implementation_type_dependencies(object.interface_type());
-	resolve_object(object_dependencies, object);
+	auto object_dependencies = implementation_type_dependencies(configuration, object.interface_type());
+	resolve_object(configuration, object_dependencies, object);
 }
 
-void injector_core::resolve_object(const dependencies &object_dependencies, const implementation &object) const
+void injector_core::resolve_object(const injector_configuration &configuration, const dependencies &object_dependencies, const implementation &object)
 {
 	auto resolved_dependencies = resolve_dependencies(object_dependencies, _objects);
 	assert(resolved_dependencies.unresolved.empty());
@@ -272,16 +801,231 @@ void injector_core::resolve_object(const dependencies &object_dependencies, cons
 		assert(implements(object.interface_type(), resolved.setter().object_type()));
 		resolved.apply_on(object.object());
 	}
+
+	for (auto &&object_dependency : object_dependencies)
+		if (object_dependency.setter().is_all())
+			object_dependency.setter().invoke(object.object(), parameter_list_for(configuration, object_dependency.setter()));
+}
+
+std::vector<QObject *> injector_core::all_objects_of(const injector_configuration &configuration, const type &interface_type) const
+{
+	auto &implementation_types = configuration.model.all_implementations_of(interface_type);
+	auto result = std::vector<QObject *>{};
+	result.reserve(implementation_types.size());
+	for (auto &&implementation_type : implementation_types)
+	{
+		auto object_it = _objects.get(implementation_type);
+		assert(object_it != std::end(_objects));
+		result.push_back(object_it->object());
+	}
+	return result;
+}
+
+const QList<void *> & injector_core::parameter_list_for(const injector_configuration &configuration, const setter_method &setter)
+{
+	assert(setter.is_all());
+
+	auto list_it = _parameter_lists.find(setter.parameter_type());
+	if (list_it != std::end(_parameter_lists))
+		return list_it->second;
+
+	auto list = setter.make_parameter_list(all_objects_of(configuration, setter.parameter_type()));
+	return _parameter_lists.insert(std::make_pair(setter.parameter_type(), list)).first->second;
 }
 
 void injector_core::inject_into(QObject *object)
 {
-	auto object_implementation = implementation{type{object->metaObject()}, object};
-	auto dependencies = extract_dependencies(_known_types, object_implementation.interface_type());
-	auto types_to_instantiate = required_to_satisfy(dependencies, _types_model, _objects);
-	instantiate_all(types_to_instantiate);
-	resolve_object(dependencies, object_implementation);
-	call_init_methods(object);
+	auto plan = injection_plan_for(object->metaObject());
+	plan->apply_on(object);
+}
+
+void injector_core::inject_into(const std::vector<QObject *> &objects)
+{
+	// all plans are made before first object is touched, so invalid type does not leave objects half-injected
+	for (auto &&object : objects)
+		injection_plan_for(object->metaObject());
+
+	auto last_meta_object = static_cast<const QMetaObject *>(nullptr);
+	auto last_plan = std::shared_ptr<const injection_plan>{};
+	auto last_generation = _configuration_generation;
+	for (auto &&object : objects)
+	{
+		// INJEQT_INIT of previous object could change configuration
+		if (object->metaObject() != last_meta_object || _configuration_generation != last_generation)
+		{
+			last_meta_object = object->metaObject();
+			last_plan = injection_plan_for(last_meta_object);
+			last_generation = _configuration_generation;
+		}
+		last_plan->apply_on(object);
+	}
+}
+
+std::shared_ptr<const injection_plan> injector_core::injection_plan_for(const QMetaObject *meta_object)
+{
+	auto plan_it = _injection_plans.find(meta_object);
+	if (plan_it != std::end(_injection_plans))
+		return plan_it->second;
+
+	auto generation = _configuration_generation;
+	auto plan = std::make_shared<const injection_plan>(make_injection_plan(type{meta_object}));
+	// INJEQT_INIT of instantiated dependency could change configuration
+	if (generation == _configuration_generation)
+		_injection_plans.insert(std::make_pair(meta_object, plan));
+	return plan;
+}
+
+injection_plan injector_core::make_injection_plan(const type &object_type)
+{
+	auto unvalidated = configuration();
+	auto dependencies = extract_dependencies(unvalidated->known_types, object_type);
+
+	auto dependency_types = std::vector<type>{};
+	for (auto &&dependency : dependencies)
+	{
+		auto &implementation_types = unvalidated->model.all_implementations_of(dependency.required_type());
+		std::copy(std::begin(implementation_types), std::end(implementation_types), std::back_inserter(dependency_types));
+	}
+
+	auto current = validated_configuration(dependency_types);
+	auto &configuration = *current;
+	auto types_to_instantiate = required_to_satisfy(dependencies, configuration.model, ready_nodes(configuration.model));
+	instantiate_all(configuration, types_to_instantiate);
+
+	auto resolved_dependencies = resolve_dependencies(dependencies, _objects);
+	assert(resolved_dependencies.unresolved.empty());
+
+	auto resolved_all_dependencies = std::vector<resolved_all_dependency>{};
+	for (auto &&dependency : dependencies)
+		if (dependency.setter().is_all())
+			resolved_all_dependencies.emplace_back(dependency.setter(), parameter_list_for(configuration, dependency.setter()));
+
+	return injection_plan{object_type, std::move(resolved_dependencies.resolved), std::move(resolved_all_dependencies),
+		extract_actions("INJEQT_INIT", object_type)};
+}
+
+std::vector<type> injector_core::instantiation_order(const std::vector<type> &interface_types)
+{
+	auto implementation_types = std::vector<type>{};
+	for (auto &&interface_type : interface_types)
+		implementation_types.push_back(implementation_for(*configuration(), interface_type));
+
+	auto current = validated_configuration(implementation_types);
+	auto result = std::vector<type>{};
+	auto visited = std::set<type>{};
+
+	// iterative depth-first search with post-order output, so dependencies are placed first
+	auto stack = std::vector<std::pair<type, bool>>{};
+	for (auto i = interface_types.rbegin(), e = interface_types.rend(); i != e; ++i)
+		stack.emplace_back(implementation_for(*current, *i), false);
+
+	while (!stack.empty())
+	{
+		auto item = stack.back();
+		stack.pop_back();
+
+		if (item.second)
+		{
+			result.push_back(item.first);
+			continue;
+		}
+		if (!visited.insert(item.first).second || _objects.contains_key(item.first))
+			continue;
+
+		stack.emplace_back(item.first, true);
+
+		auto required_types = std::vector<type>{};
+		for (auto &&dependency : implementation_type_dependencies(*current, item.first))
+		{
+			auto &implementation_types = current->model.all_implementations_of(dependency.required_type());
+			std::copy(std::begin(implementation_types), std::end(implementation_types), std::back_inserter(required_types));
+		}
+		for (auto &&required_type : provider_for(item.first).required_types())
+			required_types.push_back(implementation_for(*current, required_type));
+
+		for (auto &&required_type : required_types)
+			if (visited.find(required_type) == std::end(visited))
+				stack.emplace_back(required_type, false);
+	}
+
+	return result;
+}
+
+void injector_core::set_profile_recording(bool enabled)
+{
+	if (enabled)
+		_profile = instantiation_profile{};
+	_profile_recording = enabled;
+}
+
+instantiation_profile injector_core::recorded_profile() const
+{
+	auto result = _profile;
+	result.set_signature(make_profile_signature(provided_types()));
+	return result;
+}
+
+startup_report injector_core::recorded_startup_report() const
+{
+	auto current = configuration();
+	auto implementation_types = recorded_types(*current, _profile);
+	return analyze_startup(implementation_types, required_types_of(*current, implementation_types), _profile);
+}
+
+std::vector<type> injector_core::replay_order(const instantiation_profile &profile) const
+{
+	auto current = configuration();
+	auto implementation_types = recorded_types(*current, profile);
+	return critical_path_order(implementation_types, required_types_of(*current, implementation_types), profile);
+}
+
+std::vector<type> injector_core::recorded_types(const injector_configuration &configuration, const instantiation_profile &profile) const
+{
+	auto result = std::vector<type>{};
+	auto found = std::set<type>{};
+	for (auto &&timing : profile.timings())
+	{
+		auto type_it = configuration.known_types.get(timing.type_name);
+		if (type_it != std::end(configuration.known_types) && _available_providers.contains_key(*type_it) && found.insert(*type_it).second)
+			result.push_back(*type_it);
+	}
+	return result;
+}
+
+std::map<type, std::vector<type>> injector_core::required_types_of(const injector_configuration &configuration, const std::vector<type> &implementation_types) const
+{
+	auto result = std::map<type, std::vector<type>>{};
+	for (auto &&implementation_type : implementation_types)
+	{
+		auto &required_types = result[implementation_type];
+		for (auto &&dependency : implementation_type_dependencies(configuration, implementation_type))
+		{
+			auto &dependency_types = configuration.model.all_implementations_of(dependency.required_type());
+			std::copy(std::begin(dependency_types), std::end(dependency_types), std::back_inserter(required_types));
+		}
+		for (auto &&required_type : provider_for(implementation_type).required_types())
+			required_types.push_back(implementation_for(configuration, required_type));
+	}
+	return result;
+}
+
+void injector_core::fast_exit()
+{
+	for (auto &&resolved_object : _resolved_objects)
+		if (requires_done_on_fast_exit(type{resolved_object.object()->metaObject()}))
+			call_done_methods(resolved_object.object());
+
+	// memory of leaked objects is reclaimed by operating system at process exit
+	auto leaked_providers = _available_providers.take();
+	for (auto &&leaked_provider : leaked_providers)
+		leaked_provider.release();
+
+	_objects.clear();
+	reset_ready_nodes();
+	_resolved_objects.clear();
+	_new_objects.clear();
+	_dependents.clear();
+	publish(injector_configuration{});
 }
 
 void injector_core::call_init_methods(QObject *object) const
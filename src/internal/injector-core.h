@@ -21,15 +21,28 @@
 #pragma once
 
 #include <injeqt/injeqt.h>
+#include <injeqt/startup-report.h>
 #include <injeqt/type.h>
+#include <injeqt/validation-mode.h>
 
 #include "implementations.h"
+#include "injection-plan.h"
+#include "injector-configuration.h"
+#include "instantiation-profile.h"
 #include "providers.h"
+#include "type-dependents.h"
 #include "types-by-name.h"
 #include "types-model.h"
 
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QString>
+
+class QThread;
 
 /**
  * @file
@@ -50,7 +63,17 @@ class provided_object;
  * Its main purpose is to gather configuration from set of providers and construct objects with
  * resolved dependencies.
  *
- * Injector keeps list of all configured providers and of all already created objects.
+ * Injector keeps list of all configured providers and of all already created objects. Configuration
+ * (known types, types model and roles) is kept in immutable injector_configuration snapshot. Each public
+ * operation takes current snapshot on start and uses only it, so reconfiguration done in the middle of
+ * operation (for example from INJEQT_INIT method or by other reader of configuration()) does not change
+ * model used by that operation.
+ *
+ * Providers, list of created objects and all caches are writer state. Methods that change configuration
+ * or instantiate objects must be serialized by owner of injector_core (injector_impl uses mutex for that).
+ * Only configuration(), provided_types() and ready_object...() methods can be called concurrently with
+ * them, as these read published snapshot only. Created objects are added to snapshot by publish_new_objects().
+ *
  * Two methods objects_with(implementations, const type &) and objects_with(implementations, const types &)
  * are used to update list of already created objects with new ones.
  */
@@ -82,8 +105,17 @@ public:
 	 *
 	 * This constructor creates types_model object to get all required information from providers. This object
 	 * takes ownership of passed providers.
+	 *
+	 * If @p types_model_cache_file_name is not empty, validated types_model is read from this file when it was
+	 * saved for the same set of types, skipping reflection and validation of types. Otherwise model is created
+	 * and saved to this file.
+	 *
+	 * In validation_mode::lazy only relations of types are created and checked for ambiguity. Dependencies
+	 * of each type are extracted and validated on first request of it or of type depending on it, so
+	 * exceptions listed above can be thrown later by methods that instantiate objects.
 	 */
-	explicit injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers);
+	explicit injector_core(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&all_providers,
+		const QString &types_model_cache_file_name = QString{}, validation_mode validation = validation_mode::eager);
 
 	injector_core(const injector_core &) = delete;
 	injector_core(injector_core &&) = default;
@@ -98,6 +130,49 @@ public:
 	 */
 	~injector_core();
 
+	/**
+	 * @brief Add new providers to already working injector_core.
+	 * @param known_types list of all known types, including types of @p new_providers
+	 * @param new_providers set of providers to add
+	 * @throw ambiguous_types if one of @p new_providers provides already configured type
+	 * @throw ambiguous_types if one or more types becomes ambiguous
+	 * @throw unresolvable_dependencies if a type with unresolvable dependency is found in @p new_providers
+	 * @throw unresolvable_dependencies if a new type made type required by existing dependency ambiguous
+	 * @throw unavailable_required_types if a type required by a provider is not available
+	 * @throw dependency_on_self when type depends on self
+	 * @throw dependency_on_subtype when type depends on own supertype
+	 * @throw dependency_on_subtype when type depends on own subtype
+	 * @throw invalid_setter if any tagged setter has invalid signature
+	 *
+	 * Types model is extended with extend_types_model(), so only relations and dependencies of new types are
+	 * computed and validated. Already created objects are not modified. If an exception is thrown,
+	 * injector_core is not modified.
+	 */
+	void add_providers(types_by_name known_types, std::vector<std::unique_ptr<provider>> &&new_providers);
+
+	/**
+	 * @brief Remove providers of @p removed_types from injector_core.
+	 * @param removed_types list of provided types to remove
+	 * @throw unresolvable_dependencies if a remaining type depends on interface that would not be available anymore
+	 * @throw unavailable_required_types if a remaining provider requires type that would not be available anymore
+	 * @pre all of @p removed_types are provided by this injector_core
+	 *
+	 * Objects of removed types and all objects that transitively depend on them are invalidated. Reverse
+	 * dependency index is used to find them, so cost is proportional to size of affected subgraph. INJEQT_DONE
+	 * methods are called on invalidated objects, dependents first. Then objects of remaining types are destroyed
+	 * by theirs providers (and will be created again on demand) and removed providers are destroyed with
+	 * theirs objects. If an exception is thrown, injector_core is not modified.
+	 */
+	void remove_providers(const std::vector<type> &removed_types);
+
+	/**
+	 * @return current snapshot of configuration.
+	 *
+	 * Snapshot is read atomically and is never modified, so it can be used without any locking, even if
+	 * configuration is changed at the same time. Changes are visible only in snapshots returned later.
+	 */
+	std::shared_ptr<const injector_configuration> configuration() const;
+
 	/**
 	 * @brief Returns list of all configured types.
 	 *
@@ -106,6 +181,46 @@ public:
 	 */
 	std::vector<type> provided_types() const;
 
+	/**
+	 * @return object of @p interface_type from current snapshot or nullptr if it was not published yet
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 *
+	 * Does not instantiate anything and does not use writer state, so it can be called without any lock,
+	 * concurrently with reconfiguration and instantiation. Lookup is done in table of ready objects of
+	 * current snapshot, so its cost does not depend on number of created objects.
+	 */
+	QObject * ready_object(const type &interface_type) const;
+
+	/**
+	 * @return objects of all configured types that implement @p interface_type from current snapshot
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 *
+	 * Works like ready_object(const type &). Returned list is empty if any of these objects was not
+	 * published yet or if no configured type implements @p interface_type.
+	 */
+	std::vector<QObject *> ready_objects_of(const type &interface_type) const;
+
+	/**
+	 * @return objects of all types with @p type_role from current snapshot
+	 *
+	 * Works like ready_object(const type &). Returned list is empty if any of these objects was not
+	 * published yet or if no type has @p type_role.
+	 */
+	std::vector<QObject *> ready_objects_with_type_role(const std::string &type_role) const;
+
+	/**
+	 * @brief Add objects created and initialized since last call to table of ready objects of current snapshot.
+	 * @param move_to thread to move new objects to before publishing them, nullptr to keep them in place
+	 *
+	 * After this call objects are returned by ready_object(const type &). If @p move_to is not null, new
+	 * parentless objects living in current thread are moved to @p move_to first, so objects created on
+	 * worker thread can be handed to thread owning injector before other threads see them. Cost of this
+	 * method is proportional to number of new objects.
+	 */
+	void publish_new_objects(QThread *move_to = nullptr);
+
 	/**
 	 * @brief Instantiates object of given type @p interface_type
 	 * @param interface_type type of object to instantiate.
@@ -120,9 +235,30 @@ public:
 	/**
 	 * @brief Instantiate all objects with given @p type_role.
 	 * @throw instantiation_failed if instantiation of one of found types failed
+	 *
+	 * All types with given role are instantiated in one batch, with theirs dependencies computed once.
 	 */
 	void instantiate_all_with_type_role(const std::string &type_role);
 
+	/**
+	 * @brief Returns all objects with given @p type_role.
+	 * @throw instantiation_failed if instantiation of one of found types failed
+	 *
+	 * Objects that were not yet available are instantiated with instantiate_all_with_type_role(const std::string &).
+	 */
+	std::vector<QObject *> get_all_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Returns all objects that implement @p interface_type.
+	 * @throw instantiation_failed if instantiation of one of found types failed
+	 * @pre !interface_type.is_empty()
+	 * @pre !interface_type.is_qobject()
+	 *
+	 * All configured types that implement @p interface_type are instantiated in one batch. Returned list
+	 * is empty if no configured type implements @p interface_type.
+	 */
+	std::vector<QObject *> get_all(const type &interface_type);
+
 	/**
 	 * @brief Returns pointer to object of given type @p interface_type
 	 * @param interface_type type of object to return.
@@ -150,12 +286,130 @@ public:
 	 */
 	void inject_into(QObject *object);
 
+	/**
+	 * @brief Inject dependencies into all @p objects.
+	 * @throw invalid_setter if any tagged setter of any object has invalid signature
+	 * @pre all objects are not nullptr
+	 *
+	 * Dependencies are extracted and resolved only once for each distinct type of objects. Then
+	 * all setters and INJEQT_INIT methods are called on each object. If any exception is thrown,
+	 * no object has its setters called. If an INJEQT_INIT method changes configuration, plans for
+	 * remaining objects are made again.
+	 */
+	void inject_into(const std::vector<QObject *> &objects);
+
+	/**
+	 * @brief Return implementation types that must be instantiated to have all @p interface_types available.
+	 * @throw unknown_type if any of @p interface_types does not have corresponding implementation
+	 * @pre none of @p interface_types is empty or is qobject
+	 *
+	 * Dependencies (including types required by providers) are placed before types that depend on them,
+	 * so instantiating types one by one in returned order creates about one new object per step. Types
+	 * with cyclic dependencies are returned in arbitrary order. Already instantiated types are skipped.
+	 */
+	std::vector<type> instantiation_order(const std::vector<type> &interface_types);
+
+	/**
+	 * @brief Enable or disable recording of instantiation profile.
+	 *
+	 * When enabled, each provided object has duration of provider::provide() and of its INJEQT_INIT methods
+	 * recorded in order of instantiation. Objects created by nested calls to injector_core are measured
+	 * separately, so theirs time is not counted again in duration of outer object. Enabling recording clears
+	 * previously recorded profile.
+	 */
+	void set_profile_recording(bool enabled);
+
+	/**
+	 * @return profile recorded since last set_profile_recording(true) call, with signature of current configuration
+	 */
+	instantiation_profile recorded_profile() const;
+
+	/**
+	 * @return analysis of critical path of types in recorded profile
+	 *
+	 * Setter dependencies and types required by providers are considered edges of dependency graph.
+	 */
+	startup_report recorded_startup_report() const;
+
+	/**
+	 * @return configured types recorded in @p profile, ordered so types with most expensive dependency chains come first
+	 * @see critical_path_order(const std::vector<type> &, const std::map<type, std::vector<type>> &, const instantiation_profile &)
+	 *
+	 * Setter dependencies and types required by providers are considered edges of dependency graph.
+	 */
+	std::vector<type> replay_order(const instantiation_profile &profile) const;
+
+	/**
+	 * @brief Prepare injector_core for fast process exit.
+	 *
+	 * Calls INJEQT_DONE methods only on objects which types are marked with INJEQT_DONE_ON_FAST_EXIT.
+	 * Then all providers are released without being destroyed, so no destructor of object owned by
+	 * them is called. After this call injector_core is empty.
+	 */
+	void fast_exit();
+
 private:
-	types_by_name _known_types;
+	std::shared_ptr<const injector_configuration> _configuration;
 	providers _available_providers;
 	implementations _objects;
+	types_model _ready_model;
+	node_set _ready_nodes;
 	implementations _resolved_objects;
-	types_model _types_model;
+	std::vector<implementation> _new_objects;
+	std::map<const QMetaObject *, std::shared_ptr<const injection_plan>> _injection_plans;
+	unsigned _configuration_generation = 0;
+	std::map<type, QList<void *>> _parameter_lists;
+	type_dependents _dependents;
+	bool _profile_recording = false;
+	qint64 _profile_measured_ns = 0;
+	instantiation_profile _profile;
+
+	/**
+	 * @brief Replace current configuration snapshot with @p configuration.
+	 *
+	 * Snapshot is swapped atomically. Previous snapshot is destroyed when no operation uses it anymore.
+	 * New table of ready objects is filled with all created objects, except these that were not yet
+	 * published with publish_new_objects().
+	 */
+	void publish(injector_configuration configuration);
+
+	/**
+	 * @brief Return set of nodes of graph of @p model that have objects in _objects.
+	 *
+	 * Set is updated when objects are created and rebuilt only when graph of @p model is not the one
+	 * set was built for, so after providers are added or removed. Lazily validated models share graph.
+	 */
+	const node_set & ready_nodes(const types_model &model);
+
+	/**
+	 * @brief Forget set of ready nodes, so it is rebuilt on next call of ready_nodes(const types_model &).
+	 *
+	 * Must be called when objects are removed from _objects.
+	 */
+	void reset_ready_nodes();
+
+	/**
+	 * @brief Add types provided by @p new_providers to @p types_by_role index of types by roles.
+	 */
+	void add_types_by_role(std::map<std::string, types> &types_by_role, const providers &new_providers) const;
+
+	/**
+	 * @brief Add @p dependencies and requirements of @p dependent_providers to reverse dependency index.
+	 */
+	void add_dependents(const types_dependencies &dependencies, const providers &dependent_providers);
+
+	/**
+	 * @brief Check if remaining types do not depend on interfaces lost after removal of @p removed_types.
+	 * @throw unresolvable_dependencies if a remaining type depends on interface that is not available in @p model
+	 * @throw unavailable_required_types if a remaining provider requires type that is not available in @p model
+	 */
+	void validate_removal(const injector_configuration &configuration, const std::vector<type> &removed_types, const types_model &model) const;
+
+	/**
+	 * @brief Check if all types required by @p providers_to_check are available in @p model.
+	 * @throw unavailable_required_types if any required type is not available
+	 */
+	void validate_required_types(const providers &providers_to_check, const types_model &model) const;
 
 	/**
 	 * @brief Extract all provided types and makes a types_model from them.
@@ -167,14 +421,58 @@ private:
 	 * @throw invalid_setter if any tagged setter has parameter that is not a QObject-derived pointer
 	 * @throw invalid_setter if any tagged setter has parameter that is a QObject pointer
 	 * @throw invalid_setter if any tagged setter has other number of parameters than one
+	 *
+	 * When @p cache_file_name is not empty, model is read from memory mapped cache file if its key matches
+	 * current types. Newly created model is written to cache file. In validation_mode::lazy model is created
+	 * without any dependencies and cache is not used.
+	 */
+	types_model create_types_model(const types_by_name &known_types, const QString &cache_file_name, validation_mode validation) const;
+
+	/**
+	 * @brief Return configuration with @p implementation_types and all types they depend on validated.
+	 * @throw unresolvable_dependencies if a type with unresolvable dependency is found
+	 * @throw unavailable_required_types if a type required by a provider is not available
+	 * @throw invalid_setter if any tagged setter has invalid signature
+	 *
+	 * In validation_mode::eager current configuration is returned. In validation_mode::lazy dependencies
+	 * of not yet validated types are extracted and validated, transitively, and new configuration with
+	 * them added to model is published. Graph of dependencies is shared with previous configuration and
+	 * only gets edges of new dependencies (@see extend_types_dependencies). If an exception is thrown,
+	 * injector_core is not modified.
 	 */
-	types_model create_types_model() const;
+	std::shared_ptr<const injector_configuration> validated_configuration(const std::vector<type> &implementation_types);
 
 	/**
 	 * @brief Return type that implements @p interface_type.
 	 * @throw unknown_type if @p interface_type does not have corresponding implementation
 	 */
-	type implementation_for(const type &interface_type) const;
+	type implementation_for(const injector_configuration &configuration, const type &interface_type) const;
+
+	/**
+	 * @return object of @p interface_type from table of ready objects of @p configuration or nullptr
+	 */
+	QObject * ready_object(const injector_configuration &configuration, const type &interface_type) const;
+
+	/**
+	 * @return objects of all @p implementation_types from table of ready objects of @p configuration
+	 *
+	 * Returned list is empty if any of these objects is not available.
+	 */
+	template<typename T>
+	std::vector<QObject *> ready_objects_of(const injector_configuration &configuration, const T &implementation_types) const
+	{
+		auto result = std::vector<QObject *>{};
+		result.reserve(implementation_types.size());
+		for (auto &&implementation_type : implementation_types)
+		{
+			auto object = ready_object(configuration, implementation_type);
+			if (!object)
+				return {};
+			result.push_back(object);
+		}
+
+		return result;
+	}
 
 	/**
 	 * @brief Instantiate class of interface type @p interface_type and makes it available for use.
@@ -185,7 +483,7 @@ private:
 	 * Instantiate class of interface type @p interface_type with all of its dependencies, then resolves them and
 	 * calls INJEQT_INIT slots.
 	 */
-	void instantiate_interface(const type &interface_type);
+	void instantiate_interface(const injector_configuration &configuration, const type &interface_type);
 
 	/**
 	 * @brief Instantiate class of type @p implementation_type and makes it available for use.
@@ -195,12 +493,22 @@ private:
 	 * Instantiate class of exact type @p implementation_type with all of its dependencies, then resolves them and
 	 * calls INJEQT_INIT slots.
 	 */
-	void instantiate_implementation(const type &implementation_type);
+	void instantiate_implementation(const injector_configuration &configuration, const type &implementation_type);
+
+	/**
+	 * @brief Instantiate classes of types @p implementation_types and makes them available for use.
+	 * @param implementation_types types of objects to create
+	 * @throw instantiation_failed if instantiation of one of required types failed
+	 *
+	 * Instantiate classes of exact types @p implementation_types with all of theirs dependencies in one batch,
+	 * then resolves them and calls INJEQT_INIT slots.
+	 */
+	void instantiate_implementations(const injector_configuration &configuration, const types &implementation_types);
 
 	/**
 	 * @brief Return all dependencies for @p implementation_type.
 	 */
-	dependencies implementation_type_dependencies(const type &implementation_type) const;
+	dependencies implementation_type_dependencies(const injector_configuration &configuration, const type &implementation_type) const;
 
 	/**
 	 * @brief Instantiate classes of interface types from @p interface_types and makes them available for use.
@@ -210,7 +518,7 @@ private:
 	 *
 	 * Instantiate all classes of interface type @p interface_types without looking for dependencies.
 	 */
-	void instantiate_all(const types &interface_types);
+	void instantiate_all(const injector_configuration &configuration, const types &interface_types);
 
 	/**
 	 * @brief Instantiate classes that are required before instantiating any of @p types_to_instantiate.
@@ -220,25 +528,20 @@ private:
 	 * Instantiate all classes that are returned from @see provider::required_type() methods of any provider
 	 * for these types.
 	 */
-	void instantiate_required_types_for(const types &types_to_instantiate);
+	void instantiate_required_types_for(const injector_configuration &configuration, const types &types_to_instantiate);
 
 	/**
-	 * @brief Return list of providers required to instantiate types from @p for_types.
+	 * @brief Return entry of provider of @p for_type.
+	 * @pre _available_providers.contains_key(for_type)
+	 *
+	 * Returned reference is valid only until modules are added, so it must not be held while any provider is called.
 	 */
-	template<typename T>
-	std::vector<provider *> providers_for(const T &for_types) const
+	const provider_entry & provider_for(const type &for_type) const
 	{
-		auto result = std::vector<provider *>{};
-		result.reserve(for_types.size());
-		for (auto &&for_type : for_types)
-		{
-			auto provider_it = _available_providers.get(for_type);
-			assert(provider_it != end(_available_providers));
-
-			result.push_back(provider_it->get());
-		}
+		auto provider_it = _available_providers.get(for_type);
+		assert(provider_it != end(_available_providers));
 
-		return result;
+		return *provider_it;
 	}
 
 	/**
@@ -247,9 +550,9 @@ private:
 	std::vector<type> non_instantiated(const types &to_filter) const;
 
 	/**
-	 * @brief Instantiate types with @p providers.
+	 * @brief Instantiate types from @p implementation_types with theirs providers.
 	 */
-	std::vector<provided_object> provide_objects(const std::vector<provider *> &providers);
+	std::vector<provided_object> provide_objects(const std::vector<type> &implementation_types);
 
 	/**
 	 * @brief Return objects that needs resolving from @p provided_objects.
@@ -268,26 +571,92 @@ private:
 	 * Each implementation object is returned with set of @see implementation instances that contains all unique inferfaces
 	 * for that object, so it is later avaialble under all types it implements.
 	 */
-	std::vector<implementation> objects_to_store(const std::vector<implementation> &objects) const;
+	std::vector<implementation> objects_to_store(const injector_configuration &configuration, const std::vector<implementation> &objects) const;
 
 	/**
 	 * @brief Resolve all @p objects dependencies, call all INJEQT_INIT slots and add types to list of resolved objects.
 	 *
 	 * This method assumes that all object dependencies are already instantiated.
 	 */
-	void resolve_objects(const std::vector<implementation> &objects);
+	void resolve_objects(const injector_configuration &configuration, const std::vector<implementation> &objects);
 
 	/**
 	 * @brief Resolve all @p object dependencies.
 	 *
 	 * This method assumes that all object dependencies are already instantiated.
 	 */
-	void resolve_object(const implementation &object) const;
+	void resolve_object(const injector_configuration &configuration, const implementation &object);
 
 	/**
 	 * @brief Resolve all @p object dependencies with @p object_dependencies.
 	 */
-	void resolve_object(const dependencies &object_dependencies, const implementation &object) const;
+	void resolve_object(const injector_configuration &configuration, const dependencies &object_dependencies, const implementation &object);
+
+	/**
+	 * @return list of already instantiated objects of all configured types that implement @p interface_type.
+	 */
+	std::vector<QObject *> all_objects_of(const injector_configuration &configuration, const type &interface_type) const;
+
+	/**
+	 * @return list of objects to pass to INJEQT_SET_ALL @p setter
+	 * @pre setter.is_all()
+	 * @pre all implementations of setter.parameter_type() are instantiated
+	 *
+	 * List is made with setter_method::make_parameter_list(const std::vector<QObject *> &) on first use for given
+	 * interface and then reused for all setters of that interface, until configuration changes.
+	 */
+	const QList<void *> & parameter_list_for(const injector_configuration &configuration, const setter_method &setter);
+
+	/**
+	 * @brief Create injection plan for objects of type @p object_type.
+	 * @throw invalid_setter if any tagged setter of @p object_type has invalid signature
+	 *
+	 * All types required by @p object_type dependencies are instantiated.
+	 */
+	injection_plan make_injection_plan(const type &object_type);
+
+	/**
+	 * @brief Return cached injection plan for objects with @p meta_object.
+	 * @throw invalid_setter if any tagged setter of @p meta_object type has invalid signature
+	 *
+	 * Plan is created with make_injection_plan(const type &) on first use and then reused, so repeated
+	 * injections into objects of the same type do not use reflection. Objects referenced by plans are
+	 * never destroyed before injector_core, so cache only needs to be cleared when configuration changes.
+	 *
+	 * Plan is returned as shared pointer, so it stays alive while it is applied, even if its INJEQT_INIT
+	 * methods change configuration and cache is cleared. Plan is not cached if configuration changed
+	 * while it was made.
+	 */
+	std::shared_ptr<const injection_plan> injection_plan_for(const QMetaObject *meta_object);
+
+	/**
+	 * @brief Call @p function and return its duration without durations measured by nested calls, in nanoseconds.
+	 */
+	template<typename F>
+	qint64 measure_self_time(F function)
+	{
+		auto measured_before = _profile_measured_ns;
+		auto timer = QElapsedTimer{};
+		timer.start();
+		function();
+
+		auto elapsed = timer.nsecsElapsed();
+		auto nested = _profile_measured_ns - measured_before;
+		_profile_measured_ns = measured_before + elapsed;
+		return elapsed - nested;
+	}
+
+	/**
+	 * @return configured types recorded in @p profile, in order of first recording
+	 */
+	std::vector<type> recorded_types(const injector_configuration &configuration, const instantiation_profile &profile) const;
+
+	/**
+	 * @return types required by each of @p implementation_types to be ready before it
+	 *
+	 * Implementations of setter dependencies and types required by providers are returned.
+	 */
+	std::map<type, std::vector<type>> required_types_of(const injector_configuration &configuration, const std::vector<type> &implementation_types) const;
 
 	/**
 	 * @brief Call all INJEQT_INIT methods on given object in proper order.
@@ -23,10 +23,10 @@
 #include <injeqt/exception/unknown-type.h>
 #include <injeqt/module.h>
 
-#include "containers.h"
+#include "dependencies.h"
+#include "injector-builder.h"
 #include "interfaces-utils.h"
 #include "provider-by-default-constructor.h"
-#include "provider-by-parent-injector-configuration.h"
 #include "provider-ready.h"
 #include "provider.h"
 #include "module-impl.h"
@@ -34,73 +34,276 @@
 #include "resolve-dependencies.h"
 #include "resolved-dependency.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <algorithm>
 #include <cassert>
 
 namespace injeqt { namespace internal {
 
-injector_impl::injector_impl()
+injector_impl::injector_impl() :
+	_incremental{[this](const type &t){ instantiate_step(t); }}
 {
 }
 
 injector_impl::injector_impl(std::vector<std::unique_ptr<module>> modules) :
 	// modules are only stored because these can own objects used by injector
-	_modules{std::move(modules)}
+	_modules{std::move(modules)},
+	_incremental{[this](const type &t){ instantiate_step(t); }}
 {
 	init(std::vector<injector_impl *>{});
 }
 
+injector_impl::injector_impl(std::vector<std::unique_ptr<module>> modules, const QString &types_model_cache_file_name) :
+	// modules are only stored because these can own objects used by injector
+	_modules{std::move(modules)},
+	_incremental{[this](const type &t){ instantiate_step(t); }}
+{
+	init(std::vector<injector_impl *>{}, types_model_cache_file_name);
+}
+
+injector_impl::injector_impl(std::vector<std::unique_ptr<module>> modules, validation_mode validation) :
+	// modules are only stored because these can own objects used by injector
+	_modules{std::move(modules)},
+	_incremental{[this](const type &t){ instantiate_step(t); }}
+{
+	init(std::vector<injector_impl *>{}, QString{}, validation);
+}
+
+injector_impl::injector_impl(std::vector<std::unique_ptr<module>> modules, const injector_roots &roots) :
+	// modules are only stored because these can own objects used by injector
+	_modules{std::move(modules)},
+	_incremental{[this](const type &t){ instantiate_step(t); }}
+{
+	init(std::vector<injector_impl *>{}, QString{}, validation_mode::eager, &roots);
+}
+
 injector_impl::injector_impl(std::vector<injector_impl *> super_injectors, std::vector<std::unique_ptr<module>> modules) :
 	// modules are only stored because these can own objects used by injector
-	_modules{std::move(modules)}
+	_modules{std::move(modules)},
+	_incremental{[this](const type &t){ instantiate_step(t); }}
 {
 	init(super_injectors);
 }
 
-void injector_impl::init(std::vector<injector_impl *> super_injectors)
+injector_impl::~injector_impl()
 {
-	auto extract_provider_configurations_lambda = [](const std::unique_ptr<module> &m){ return m->_pimpl->provider_configurations(); };
-	auto extract_provider_configurations = std::function<std::vector<std::shared_ptr<provider_configuration>>(const std::unique_ptr<module> &)>{extract_provider_configurations_lambda};
-	auto provider_configurations = extract(_modules, extract_provider_configurations);
+	join_prewarm_thread();
+}
 
-	for (auto &&super_injector : super_injectors)
-		for (auto &&provided_type : super_injector->provided_types())
-			provider_configurations.push_back(std::make_shared<provider_by_parent_injector_configuration>(super_injector, provided_type));
+void injector_impl::init(std::vector<injector_impl *> super_injectors, const QString &types_model_cache_file_name,
+	validation_mode validation, const injector_roots *roots)
+{
+	injector_builder builder{_modules, super_injectors};
 
-	auto extract_types_lamdba = [](const std::shared_ptr<provider_configuration> &pc){
-		auto result = std::vector<type>{};
-		for (auto &&t : pc->types())
+	if (roots)
+	{
+		auto root_type_names = std::vector<std::string>{};
+		for (auto &&root_type : roots->types)
+			root_type_names.push_back(root_type.name());
+		for (auto &&inject_into_type : roots->inject_into_types)
 		{
-			auto interfaces = extract_interfaces(t);
-			std::copy(std::begin(interfaces), std::end(interfaces), std::back_inserter(result));
+			auto dependency_type_names = extract_dependency_type_names(inject_into_type);
+			std::copy(std::begin(dependency_type_names), std::end(dependency_type_names), std::back_inserter(root_type_names));
 		}
-		return result;
-	};
-	auto extract_types = std::function<std::vector<type>(const std::shared_ptr<provider_configuration> &)>{extract_types_lamdba};
-	auto known_types = types_by_name{extract(provider_configurations, extract_types)};
 
-	auto create_provider_lambda = [&known_types](const std::shared_ptr<provider_configuration> &pc){ return pc->create_provider(known_types); };
-	auto create_provider = std::function<std::unique_ptr<provider>(std::shared_ptr<provider_configuration>)>{create_provider_lambda};
-	auto providers = transform(provider_configurations, create_provider);
+		_pruned_types = builder.prune(root_type_names, roots->type_roles);
+	}
+
+	auto known_types = builder.known_types();
+	_core = injector_core{known_types, builder.create_providers(known_types), types_model_cache_file_name, validation};
+}
+
+void injector_impl::add_modules(std::vector<std::unique_ptr<module>> modules)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	injector_builder builder{modules};
 
-	_core = injector_core{known_types, std::move(providers)};
+	auto all_known_types = _core.configuration()->known_types.sorted();
+	all_known_types.merge(builder.known_types());
+	auto known_types = types_by_name{std::move(all_known_types)};
+	_core.add_providers(known_types, builder.create_providers(known_types));
+
+	// modules are only stored because these can own objects used by injector
+	std::move(std::begin(modules), std::end(modules), std::back_inserter(_modules));
+}
+
+void injector_impl::remove_module(module *to_remove)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	auto module_it = std::find_if(std::begin(_modules), std::end(_modules),
+		[to_remove](const std::unique_ptr<module> &m){ return m.get() == to_remove; });
+	assert(module_it != std::end(_modules));
+
+	auto removed_types = std::vector<type>{};
+	for (auto &&pc : to_remove->_pimpl->provider_configurations())
+		removed_types.push_back(pc->provided_type());
+
+	_core.remove_providers(removed_types);
+
+	// destroys ready objects owned by module
+	_modules.erase(module_it);
+}
+
+void injector_impl::add_lazy_modules(std::vector<lazy_module> lazy_modules)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	std::move(std::begin(lazy_modules), std::end(lazy_modules), std::back_inserter(_lazy_modules));
+	_has_lazy_modules = !_lazy_modules.empty();
+}
+
+void injector_impl::load_lazy_modules_providing(const std::vector<std::string> &type_names)
+{
+	if (_lazy_modules.empty())
+		return;
+
+	load_lazy_modules(take_lazy_modules([&type_names](const lazy_module &lm){
+		return std::any_of(std::begin(type_names), std::end(type_names),
+			[&lm](const std::string &type_name){ return lm.provides(type_name); });
+	}));
+}
+
+void injector_impl::load_lazy_modules_with_type_role(const std::string &type_role)
+{
+	if (_lazy_modules.empty())
+		return;
+
+	load_lazy_modules(take_lazy_modules([&type_role](const lazy_module &lm){ return lm.has_type_role(type_role); }));
+}
+
+void injector_impl::load_lazy_modules_for_unknown(const std::vector<std::string> &type_names)
+{
+	if (_lazy_modules.empty())
+		return;
+
+	auto configuration = _core.configuration();
+	auto &known_types = configuration->known_types;
+	auto unknown_type_names = std::vector<std::string>{};
+	std::copy_if(std::begin(type_names), std::end(type_names), std::back_inserter(unknown_type_names),
+		[&known_types](const std::string &type_name){ return !known_types.contains_key(type_name); });
+
+	if (!unknown_type_names.empty())
+		load_lazy_modules_providing(unknown_type_names);
+}
+
+void injector_impl::load_lazy_modules(std::vector<lazy_module> to_load)
+{
+	if (to_load.empty())
+		return;
+
+	auto modules = std::vector<std::unique_ptr<module>>{};
+	while (!to_load.empty())
+	{
+		auto loaded = to_load.back().load();
+		to_load.pop_back();
+
+		// types required by loaded module can come from other lazy modules
+		auto required_type_names = std::vector<std::string>{};
+		for (auto &&pc : loaded->_pimpl->provider_configurations())
+			for (auto &&t : pc->types())
+			{
+				required_type_names.push_back(t.name());
+				auto dependency_type_names = extract_dependency_type_names(t);
+				std::copy(std::begin(dependency_type_names), std::end(dependency_type_names), std::back_inserter(required_type_names));
+			}
+
+		modules.push_back(std::move(loaded));
+
+		auto required = take_lazy_modules([&required_type_names](const lazy_module &lm){
+			return std::any_of(std::begin(required_type_names), std::end(required_type_names),
+				[&lm](const std::string &type_name){ return lm.provides(type_name); });
+		});
+		std::move(std::begin(required), std::end(required), std::back_inserter(to_load));
+	}
+
+	add_modules(std::move(modules));
+}
+
+std::vector<lazy_module> injector_impl::take_lazy_modules(const std::function<bool(const lazy_module &)> &predicate)
+{
+	auto taken_begin = std::stable_partition(std::begin(_lazy_modules), std::end(_lazy_modules),
+		[&predicate](const lazy_module &lm){ return !predicate(lm); });
+
+	auto result = std::vector<lazy_module>{};
+	std::move(taken_begin, std::end(_lazy_modules), std::back_inserter(result));
+	_lazy_modules.erase(taken_begin, std::end(_lazy_modules));
+	_has_lazy_modules = !_lazy_modules.empty();
+	return result;
 }
 
 std::vector<type> injector_impl::provided_types() const
 {
+	// snapshot is read atomically, no lock is needed
 	return _core.provided_types();
 }
 
+std::vector<type> injector_impl::pruned_types() const
+{
+	// set only in constructor, no lock is needed
+	return _pruned_types;
+}
+
 void injector_impl::instantiate(const type &interface_type)
 {
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
+	if (_core.ready_object(interface_type))
+		return;
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	load_lazy_modules_for_unknown(std::vector<std::string>{interface_type.name()});
 	_core.instantiate(interface_type);
+	publish_new_objects();
 }
 
 void injector_impl::instantiate_all_with_type_role(const std::string &type_role)
 {
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	load_lazy_modules_with_type_role(type_role);
 	_core.instantiate_all_with_type_role(type_role);
+	publish_new_objects();
+}
+
+std::vector<QObject *> injector_impl::get_all_with_type_role(const std::string &type_role)
+{
+	// lazy modules can add types with this role, so snapshot is used only when there are none
+	if (!_has_lazy_modules)
+	{
+		auto objects = _core.ready_objects_with_type_role(type_role);
+		if (!objects.empty())
+			return objects;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	load_lazy_modules_with_type_role(type_role);
+	auto result = _core.get_all_with_type_role(type_role);
+	publish_new_objects();
+	return result;
+}
+
+std::vector<QObject *> injector_impl::get_all(const type &interface_type)
+{
+	assert(!interface_type.is_empty());
+	assert(!interface_type.is_qobject());
+
+	if (!_has_lazy_modules)
+	{
+		auto objects = _core.ready_objects_of(interface_type);
+		if (!objects.empty())
+			return objects;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	// each lazy module can add new implementations, so all of them are loaded
+	load_lazy_modules_providing(std::vector<std::string>{interface_type.name()});
+	auto result = _core.get_all(interface_type);
+	publish_new_objects();
+	return result;
 }
 
 QObject * injector_impl::get(const type &interface_type)
@@ -108,14 +311,251 @@ QObject * injector_impl::get(const type &interface_type)
 	assert(!interface_type.is_empty());
 	assert(!interface_type.is_qobject());
 
-	return _core.get(interface_type);
+	// published objects are read from snapshot, so readers do not wait for reconfiguration or prewarm
+	auto object = _core.ready_object(interface_type);
+	if (object)
+		return object;
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	load_lazy_modules_for_unknown(std::vector<std::string>{interface_type.name()});
+	object = _core.get(interface_type);
+	publish_new_objects();
+	return object;
 }
 
 void injector_impl::inject_into(QObject *object)
 {
 	assert(object);
 
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	if (!_lazy_modules.empty())
+		load_lazy_modules_for_unknown(extract_dependency_type_names(type{object->metaObject()}));
 	_core.inject_into(object);
+	publish_new_objects();
+}
+
+void injector_impl::inject_into(const std::vector<QObject *> &objects)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	if (!_lazy_modules.empty())
+	{
+		auto type_names = std::vector<std::string>{};
+		for (auto &&object : objects)
+		{
+			auto dependency_type_names = extract_dependency_type_names(type{object->metaObject()});
+			std::copy(std::begin(dependency_type_names), std::end(dependency_type_names), std::back_inserter(type_names));
+		}
+		load_lazy_modules_for_unknown(type_names);
+	}
+
+	_core.inject_into(objects);
+	publish_new_objects();
+}
+
+void injector_impl::prewarm(std::vector<type> interface_types)
+{
+	assert(std::none_of(std::begin(interface_types), std::end(interface_types),
+		[](const type &t){ return t.is_empty() || t.is_qobject(); }));
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	auto type_names = std::vector<std::string>{};
+	for (auto &&interface_type : interface_types)
+		type_names.push_back(interface_type.name());
+	load_lazy_modules_for_unknown(type_names);
+
+	// unknown types are reported here, worker can only fail on instantiation
+	auto configuration = _core.configuration();
+	for (auto &&interface_type : interface_types)
+		if (!configuration->model.available_types().contains_key(interface_type))
+			throw exception::unknown_type{interface_type.name()};
+
+	start_prewarm(std::move(interface_types));
+}
+
+void injector_impl::prewarm_with_type_role(const std::string &type_role)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	load_lazy_modules_with_type_role(type_role);
+
+	auto configuration = _core.configuration();
+	auto role_types_it = configuration->types_by_role.find(type_role);
+	if (role_types_it != std::end(configuration->types_by_role))
+		start_prewarm(std::vector<type>{std::begin(role_types_it->second), std::end(role_types_it->second)});
+}
+
+void injector_impl::start_prewarm(std::vector<type> types_to_instantiate)
+{
+	auto owner_thread = QThread::currentThread();
+	for (auto &&type_to_instantiate : types_to_instantiate)
+		_prewarm_queue.emplace_back(type_to_instantiate, owner_thread);
+
+	if (_prewarm_running)
+		return;
+
+	// previous worker has already stopped and does not need mutex anymore
+	if (_prewarm_thread.joinable())
+		_prewarm_thread.join();
+	_prewarm_running = true;
+	_prewarm_thread = std::thread{[this](){ run_prewarm(); }};
+}
+
+void injector_impl::run_prewarm()
+{
+	std::unique_lock<std::recursive_mutex> lock{_mutex};
+	while (!_prewarm_queue.empty())
+	{
+		auto item = _prewarm_queue.front();
+		_prewarm_queue.pop_front();
+
+		_prewarm_owner_thread = item.second;
+		try
+		{
+			_core.instantiate(item.first);
+			publish_new_objects();
+		}
+		catch (...)
+		{
+			publish_new_objects();
+			if (!_prewarm_error)
+				_prewarm_error = std::current_exception();
+			_prewarm_queue.clear();
+		}
+		_prewarm_owner_thread = nullptr;
+
+		// let other threads in between types
+		lock.unlock();
+		lock.lock();
+	}
+
+	_prewarm_running = false;
+	_prewarm_finished.notify_all();
+}
+
+void injector_impl::publish_new_objects()
+{
+	// owner thread is set only while worker holds mutex, so only worker can see it
+	_core.publish_new_objects(_prewarm_owner_thread);
+}
+
+void injector_impl::wait_for_prewarm()
+{
+	join_prewarm_thread();
+
+	auto error = std::exception_ptr{};
+	{
+		std::lock_guard<std::recursive_mutex> lock{_mutex};
+		std::swap(error, _prewarm_error);
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void injector_impl::join_prewarm_thread()
+{
+	auto prewarm_thread = std::thread{};
+	{
+		std::unique_lock<std::recursive_mutex> lock{_mutex};
+		_prewarm_finished.wait(lock, [this](){ return !_prewarm_running; });
+		std::swap(prewarm_thread, _prewarm_thread);
+	}
+
+	// worker does not take mutex after it stopped running
+	if (prewarm_thread.joinable())
+		prewarm_thread.join();
+}
+
+void injector_impl::start_profile_recording()
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	_core.set_profile_recording(true);
+}
+
+bool injector_impl::save_profile(const QString &file_name)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	_core.set_profile_recording(false);
+
+	QSaveFile file{file_name};
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	file.write(_core.recorded_profile().to_json());
+	return file.commit();
+}
+
+bool injector_impl::replay_profile(const QString &file_name)
+{
+	QFile file{file_name};
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	auto profile = instantiation_profile::from_json(file.readAll());
+	if (profile.is_empty())
+		return false;
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	// profile of other configuration could request types in wrong order or fail on unknown ones
+	if (profile.signature() != make_profile_signature(_core.provided_types()))
+		return false;
+
+	start_prewarm(_core.replay_order(profile));
+	return true;
+}
+
+startup_report injector_impl::analyze_startup()
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	return _core.recorded_startup_report();
+}
+
+void injector_impl::instantiate_incrementally(std::vector<type> interface_types, std::chrono::milliseconds slice_budget, std::function<void(std::exception_ptr)> finished)
+{
+	assert(std::none_of(std::begin(interface_types), std::end(interface_types),
+		[](const type &t){ return t.is_empty() || t.is_qobject(); }));
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+
+	auto type_names = std::vector<std::string>{};
+	for (auto &&interface_type : interface_types)
+		type_names.push_back(interface_type.name());
+	load_lazy_modules_for_unknown(type_names);
+
+	_incremental.add(_core.instantiation_order(interface_types), slice_budget, std::move(finished));
+}
+
+void injector_impl::instantiate_step(const type &implementation_type)
+{
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	// configuration could change between slices
+	if (_core.configuration()->model.available_types().contains_key(implementation_type))
+	{
+		_core.instantiate(implementation_type);
+		publish_new_objects();
+	}
+}
+
+void injector_impl::fast_exit()
+{
+	{
+		// queued types are not needed anymore, only type that is just being created is waited for
+		std::lock_guard<std::recursive_mutex> lock{_mutex};
+		_prewarm_queue.clear();
+	}
+	join_prewarm_thread();
+
+	std::lock_guard<std::recursive_mutex> lock{_mutex};
+	_incremental.clear();
+	_core.fast_exit();
+
+	// modules can own ready objects, these are leaked as well
+	for (auto &&leaked_module : _modules)
+		leaked_module.release();
+	_modules.clear();
+	_lazy_modules.clear();
+	_has_lazy_modules = false;
 }
 
 }}
@@ -21,16 +21,31 @@
 #pragma once
 
 #include <injeqt/injeqt.h>
+#include <injeqt/injector-roots.h>
+#include <injeqt/lazy-module.h>
 #include <injeqt/type.h>
+#include <injeqt/validation-mode.h>
 
 #include "implementations.h"
+#include "incremental-instantiation.h"
 #include "injector-core.h"
 #include "providers.h"
 #include "types-by-name.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <QtCore/QObject>
 
+class QThread;
+
 /**
  * @file
  * @brief Contains classes and functions for implementation of injector.
@@ -42,6 +57,8 @@ namespace injeqt { namespace v1 {
 
 namespace injeqt { namespace internal {
 
+class provider_configuration;
+
 /**
  * @brief Implementation of injector class.
  * @see injector
@@ -49,6 +66,12 @@ namespace injeqt { namespace internal {
  *
  * Its main purpose is to own all modules passed to injector constructor and to pass everthing else
  * to injector_core class.
+ *
+ * All calls to injector_core that change its configuration or create objects are serialized with one
+ * recursive mutex, so objects can be prewarmed on worker thread while injector is used from its own
+ * thread. Objects that are already created are returned by get(), get_all() and get_all_with_type_role()
+ * from configuration snapshot without taking the mutex. State of prewarm worker is guarded by the same
+ * mutex.
  */
 class INJEQT_API injector_impl final
 {
@@ -81,6 +104,30 @@ public:
 	 */
 	explicit injector_impl(std::vector<std::unique_ptr<::injeqt::v1::module>> modules);
 
+	/**
+	 * @brief Create injector configured with set of modules, with validated types model cached in file.
+	 * @param modules set of modules containing configuration of injector
+	 * @param types_model_cache_file_name name of file with cached types model
+	 * @see injector::injector(std::vector<std::unique_ptr<module>>, const QString &)
+	 */
+	explicit injector_impl(std::vector<std::unique_ptr<::injeqt::v1::module>> modules, const QString &types_model_cache_file_name);
+
+	/**
+	 * @brief Create injector configured with set of modules, validated in given mode.
+	 * @param modules set of modules containing configuration of injector
+	 * @param validation when types are validated
+	 * @see injector::injector(std::vector<std::unique_ptr<module>>, validation_mode)
+	 */
+	explicit injector_impl(std::vector<std::unique_ptr<::injeqt::v1::module>> modules, validation_mode validation);
+
+	/**
+	 * @brief Create injector configured with types from set of modules reachable from @p roots.
+	 * @param modules set of modules containing configuration of injector
+	 * @param roots types, roles and types of objects used with inject_into() that will be requested
+	 * @see injector::injector(std::vector<std::unique_ptr<module>>, const injector_roots &)
+	 */
+	explicit injector_impl(std::vector<std::unique_ptr<::injeqt::v1::module>> modules, const injector_roots &roots);
+
 	/**
 	 * @brief Create injector configured with set of modules.
 	 * @param super_injectors list of injectors providing types for this one to use
@@ -101,6 +148,37 @@ public:
 	 */
 	explicit injector_impl(std::vector<injector_impl *> super_injectors, std::vector<std::unique_ptr<::injeqt::v1::module>> modules);
 
+	/**
+	 * @brief Wait for all prewarm threads and destroy injector_impl.
+	 */
+	~injector_impl();
+
+	/**
+	 * @brief Add configuration from @p modules to already working injector.
+	 * @param modules set of modules containing additional configuration of injector
+	 * @see injector::add_modules(std::vector<std::unique_ptr<module>>)
+	 * @see injector_core::add_providers(types_by_name, std::vector<std::unique_ptr<provider>> &&)
+	 *
+	 * Modules are stored only if configuration was successfully added.
+	 */
+	void add_modules(std::vector<std::unique_ptr<::injeqt::v1::module>> modules);
+
+	/**
+	 * @brief Remove configuration from @p to_remove from already working injector.
+	 * @param to_remove module to remove
+	 * @pre @p to_remove was passed to constructor or to add_modules(std::vector<std::unique_ptr<module>>)
+	 * @see injector::remove_module(module *)
+	 * @see injector_core::remove_providers(const std::vector<type> &)
+	 */
+	void remove_module(::injeqt::v1::module *to_remove);
+
+	/**
+	 * @brief Add descriptors of modules that will be loaded when one of its types is first needed.
+	 * @param lazy_modules descriptors of modules to load on demand
+	 * @see injector::add_lazy_modules(std::vector<lazy_module>)
+	 */
+	void add_lazy_modules(std::vector<::injeqt::v1::lazy_module> lazy_modules);
+
 	/**
 	 * @brief Returns list of all configured types.
 	 *
@@ -109,6 +187,12 @@ public:
 	 */
 	std::vector<type> provided_types() const;
 
+	/**
+	 * @brief Returns list of configured types that were not reachable from roots given in constructor.
+	 * @see injector::pruned_types()
+	 */
+	std::vector<type> pruned_types() const;
+
 	/**
 	 * @brief Instantiates object of given type @p interface_type
 	 * @param interface_type type of object to instantiate.
@@ -126,6 +210,18 @@ public:
 	 */
 	void instantiate_all_with_type_role(const std::string &type_role);
 
+	/**
+	 * @brief Returns all objects with given @p type_role.
+	 * @throw instantiation_failed if instantiation of one of found types failed
+	 */
+	std::vector<QObject *> get_all_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Returns all objects that implement @p interface_type.
+	 * @throw instantiation_failed if instantiation of one of found types failed
+	 */
+	std::vector<QObject *> get_all(const type &interface_type);
+
 	/**
 	 * @brief Returns pointer to object of given type @p interface_type
 	 * @param interface_type type of object to return.
@@ -153,11 +249,158 @@ public:
 	 */
 	void inject_into(QObject *object);
 
+	/**
+	 * @brief Inject dependencies into all @p objects.
+	 * @see injector::inject_into(const std::vector<QObject *> &)
+	 */
+	void inject_into(const std::vector<QObject *> &objects);
+
+	/**
+	 * @brief Instantiate @p interface_types on worker thread.
+	 * @param interface_types types of objects to instantiate
+	 * @throw unknown_type if any of @p interface_types was not configured in injector
+	 * @pre none of @p interface_types is empty or is qobject
+	 * @see injector::prewarm(std::vector<type>)
+	 */
+	void prewarm(std::vector<type> interface_types);
+
+	/**
+	 * @brief Instantiate all types with @p type_role on worker thread.
+	 * @see injector::prewarm_with_type_role(const std::string &)
+	 */
+	void prewarm_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Wait until all started prewarms are finished.
+	 * @throw instantiation_failed if instantiation of one of prewarmed types failed
+	 * @see injector::wait_for_prewarm()
+	 */
+	void wait_for_prewarm();
+
+	/**
+	 * @brief Start recording instantiation profile.
+	 * @see injector::start_profile_recording()
+	 */
+	void start_profile_recording();
+
+	/**
+	 * @brief Stop recording instantiation profile and save it to @p file_name.
+	 * @return true if profile was saved
+	 * @see injector::save_profile(const QString &)
+	 */
+	bool save_profile(const QString &file_name);
+
+	/**
+	 * @brief Prewarm types recorded in profile from @p file_name.
+	 * @return true if valid profile was found and prewarm was started
+	 * @see injector::replay_profile(const QString &)
+	 */
+	bool replay_profile(const QString &file_name);
+
+	/**
+	 * @brief Analyze critical path of recorded startup.
+	 * @see injector::analyze_startup()
+	 */
+	startup_report analyze_startup();
+
+	/**
+	 * @brief Instantiate @p interface_types in time slices from event loop.
+	 * @param interface_types types of objects to instantiate
+	 * @param slice_budget maximum time of one slice
+	 * @param finished function to call when all types are instantiated or when instantiation fails
+	 * @throw unknown_type if any of @p interface_types was not configured in injector
+	 * @pre none of @p interface_types is empty or is qobject
+	 * @see injector::instantiate_incrementally(std::vector<type>, std::chrono::milliseconds, std::function<void(std::exception_ptr)>)
+	 */
+	void instantiate_incrementally(std::vector<type> interface_types, std::chrono::milliseconds slice_budget, std::function<void(std::exception_ptr)> finished);
+
+	/**
+	 * @brief Prepare injector for fast process exit.
+	 * @see injector::fast_exit()
+	 *
+	 * Passes call to injector_core and then releases all modules without destroying them.
+	 */
+	void fast_exit();
+
 private:
+	std::recursive_mutex _mutex;
 	std::vector<std::unique_ptr<module>> _modules;
+	std::vector<lazy_module> _lazy_modules;
 	injector_core _core;
+	incremental_instantiation _incremental;
+	std::atomic<bool> _has_lazy_modules{false};
+	std::condition_variable_any _prewarm_finished;
+	std::deque<std::pair<type, QThread *>> _prewarm_queue;
+	std::thread _prewarm_thread;
+	bool _prewarm_running = false;
+	QThread *_prewarm_owner_thread = nullptr;
+	std::exception_ptr _prewarm_error;
+	std::vector<type> _pruned_types;
+
+	void init(std::vector<injector_impl *> super_injectors, const QString &types_model_cache_file_name = QString{},
+		validation_mode validation = validation_mode::eager, const injector_roots *roots = nullptr);
+
+	/**
+	 * @brief Instantiate @p implementation_type as one step of incremental instantiation.
+	 */
+	void instantiate_step(const type &implementation_type);
+
+	/**
+	 * @brief Queue @p types_to_instantiate for prewarm worker and start it if it is not running.
+	 *
+	 * One worker thread is used for all prewarms. Objects it creates are moved to thread that called
+	 * this method.
+	 */
+	void start_prewarm(std::vector<type> types_to_instantiate);
 
-	void init(std::vector<injector_impl *> super_injectors);
+	/**
+	 * @brief Instantiate queued types one by one until queue is empty or instantiation fails.
+	 *
+	 * Runs on prewarm worker thread. Mutex is taken for each type separately, so other threads wait
+	 * at most for instantiation of one type with its dependencies.
+	 */
+	void run_prewarm();
+
+	/**
+	 * @brief Wait until prewarm worker stops and join its thread.
+	 */
+	void join_prewarm_thread();
+
+	/**
+	 * @brief Publish objects created by last call to injector_core.
+	 *
+	 * Objects created by prewarm worker are moved to thread that requested prewarm first.
+	 */
+	void publish_new_objects();
+
+	/**
+	 * @brief Load all lazy modules providing at least one type from @p type_names.
+	 *
+	 * Lazy modules required by types from loaded modules are loaded as well. All of loaded modules
+	 * are then added in one add_modules(std::vector<std::unique_ptr<module>>) call.
+	 */
+	void load_lazy_modules_providing(const std::vector<std::string> &type_names);
+
+	/**
+	 * @brief Load all lazy modules with declared @p type_role.
+	 * @see load_lazy_modules_providing(const std::vector<std::string> &)
+	 */
+	void load_lazy_modules_with_type_role(const std::string &type_role);
+
+	/**
+	 * @brief Load all @p to_load lazy modules and lazy modules required by them.
+	 */
+	void load_lazy_modules(std::vector<lazy_module> to_load);
+
+	/**
+	 * @brief Remove and return all lazy modules matching @p predicate.
+	 */
+	std::vector<lazy_module> take_lazy_modules(const std::function<bool(const lazy_module &)> &predicate);
+
+	/**
+	 * @brief Load lazy modules providing types not known to injector_core from @p type_names.
+	 */
+	void load_lazy_modules_for_unknown(const std::vector<std::string> &type_names);
 
 };
 
@@ -0,0 +1,250 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "instantiation-profile.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMetaMethod>
+#include <QtCore/QMetaObject>
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+const int profile_version = 1;
+
+struct weight_frame
+{
+	type implementation_type;
+	const std::vector<type> *required_types;
+	std::size_t next_index;
+	qint64 max_dependency_weight;
+};
+
+qint64 critical_path_weight(const type &implementation_type, const std::map<type, std::vector<type>> &dependencies,
+	const instantiation_profile &profile, std::map<type, qint64> &weights)
+{
+	auto weight_it = weights.find(implementation_type);
+	if (weight_it != std::end(weights))
+		return weight_it->second;
+
+	// post-order walk with explicit stack, as dependency chains can be deeper than call stack
+	auto no_dependencies = std::vector<type>{};
+	auto stack = std::vector<weight_frame>{};
+	auto push = [&](const type &t){
+		// mark as visited, so cycles are broken here
+		weights.insert(std::make_pair(t, qint64{0}));
+		auto dependencies_it = dependencies.find(t);
+		auto required_types = dependencies_it != std::end(dependencies) ? &dependencies_it->second : &no_dependencies;
+		stack.push_back(weight_frame{t, required_types, 0, 0});
+	};
+
+	auto result = qint64{0};
+	push(implementation_type);
+	while (!stack.empty())
+	{
+		auto &current = stack.back();
+		if (current.next_index < current.required_types->size())
+		{
+			auto &required_type = (*current.required_types)[current.next_index++];
+			auto required_weight_it = weights.find(required_type);
+			if (required_weight_it != std::end(weights))
+				current.max_dependency_weight = std::max(current.max_dependency_weight, required_weight_it->second);
+			else
+				push(required_type);
+			continue;
+		}
+
+		result = profile.cost_of(current.implementation_type.name()) + current.max_dependency_weight;
+		weights[current.implementation_type] = result;
+		stack.pop_back();
+		if (!stack.empty())
+			stack.back().max_dependency_weight = std::max(stack.back().max_dependency_weight, result);
+	}
+
+	return result;
+}
+
+}
+
+instantiation_profile::instantiation_profile()
+{
+}
+
+instantiation_profile::instantiation_profile(QByteArray signature, std::vector<type_timing> timings) :
+	_signature{std::move(signature)}
+{
+	_timings.reserve(timings.size());
+	for (auto &&timing : timings)
+		add_timing(std::move(timing));
+}
+
+const QByteArray & instantiation_profile::signature() const
+{
+	return _signature;
+}
+
+const std::vector<type_timing> & instantiation_profile::timings() const
+{
+	return _timings;
+}
+
+bool instantiation_profile::is_empty() const
+{
+	return _timings.empty();
+}
+
+void instantiation_profile::set_signature(QByteArray signature)
+{
+	_signature = std::move(signature);
+}
+
+void instantiation_profile::add_timing(type_timing timing)
+{
+	auto summary_it = _summaries.find(timing.type_name);
+	if (summary_it == std::end(_summaries))
+		summary_it = _summaries.insert(std::make_pair(timing.type_name, type_summary{0, 0})).first;
+
+	summary_it->second.last_timing = _timings.size();
+	summary_it->second.cost += timing.build_ns + timing.init_ns;
+	_timings.push_back(std::move(timing));
+}
+
+void instantiation_profile::add_build(const type &implementation_type, qint64 build_ns)
+{
+	add_timing(type_timing{implementation_type.name(), build_ns, 0});
+}
+
+void instantiation_profile::add_init(const type &implementation_type, qint64 init_ns)
+{
+	auto summary_it = _summaries.find(implementation_type.name());
+	if (summary_it == std::end(_summaries))
+		return;
+
+	_timings[summary_it->second.last_timing].init_ns += init_ns;
+	summary_it->second.cost += init_ns;
+}
+
+qint64 instantiation_profile::cost_of(const std::string &type_name) const
+{
+	auto summary_it = _summaries.find(type_name);
+	return summary_it != std::end(_summaries) ? summary_it->second.cost : 0;
+}
+
+QByteArray instantiation_profile::to_json() const
+{
+	auto timings = QJsonArray{};
+	for (auto &&timing : _timings)
+	{
+		auto item = QJsonObject{};
+		item.insert("type", QString::fromStdString(timing.type_name));
+		item.insert("build_ns", static_cast<double>(timing.build_ns));
+		item.insert("init_ns", static_cast<double>(timing.init_ns));
+		timings.append(item);
+	}
+
+	auto root = QJsonObject{};
+	root.insert("version", profile_version);
+	root.insert("signature", QString::fromLatin1(_signature.toHex()));
+	root.insert("types", timings);
+	return QJsonDocument{root}.toJson(QJsonDocument::Compact);
+}
+
+instantiation_profile instantiation_profile::from_json(const QByteArray &json)
+{
+	auto document = QJsonDocument::fromJson(json);
+	if (!document.isObject())
+		return instantiation_profile{};
+
+	auto root = document.object();
+	if (root.value("version").toInt() != profile_version || !root.value("types").isArray())
+		return instantiation_profile{};
+
+	auto timings = std::vector<type_timing>{};
+	for (auto &&item : root.value("types").toArray())
+	{
+		auto timing = item.toObject();
+		auto type_name = timing.value("type").toString();
+		if (type_name.isEmpty())
+			return instantiation_profile{};
+		timings.push_back(type_timing{type_name.toStdString(),
+			static_cast<qint64>(timing.value("build_ns").toDouble()),
+			static_cast<qint64>(timing.value("init_ns").toDouble())});
+	}
+
+	return instantiation_profile{QByteArray::fromHex(root.value("signature").toString().toLatin1()), std::move(timings)};
+}
+
+QByteArray make_profile_signature(const std::vector<type> &provided_types)
+{
+	auto names = std::vector<std::pair<std::string, const QMetaObject *>>{};
+	for (auto &&provided_type : provided_types)
+		names.emplace_back(provided_type.name(), provided_type.meta_object());
+	std::sort(std::begin(names), std::end(names));
+
+	auto hash = QCryptographicHash{QCryptographicHash::Sha1};
+	for (auto &&name : names)
+	{
+		hash.addData(name.first.data(), static_cast<int>(name.first.size() + 1));
+		auto method_count = name.second->methodCount();
+		for (decltype(method_count) i = 0; i < method_count; i++)
+		{
+			auto method = name.second->method(i);
+			hash.addData(method.methodSignature());
+			hash.addData(method.tag(), static_cast<int>(qstrlen(method.tag()) + 1));
+		}
+	}
+	return hash.result();
+}
+
+std::vector<qint64> critical_path_weights(const std::vector<type> &implementation_types,
+	const std::map<type, std::vector<type>> &dependencies, const instantiation_profile &profile)
+{
+	auto weights = std::map<type, qint64>{};
+	auto result = std::vector<qint64>{};
+	result.reserve(implementation_types.size());
+	for (auto &&implementation_type : implementation_types)
+		result.push_back(critical_path_weight(implementation_type, dependencies, profile, weights));
+	return result;
+}
+
+std::vector<type> critical_path_order(const std::vector<type> &implementation_types,
+	const std::map<type, std::vector<type>> &dependencies, const instantiation_profile &profile)
+{
+	auto weights = critical_path_weights(implementation_types, dependencies, profile);
+
+	auto indexes = std::vector<std::size_t>(implementation_types.size());
+	std::iota(std::begin(indexes), std::end(indexes), std::size_t{0});
+	std::stable_sort(std::begin(indexes), std::end(indexes), [&weights](std::size_t x, std::size_t y){ return weights[x] > weights[y]; });
+
+	auto result = std::vector<type>{};
+	result.reserve(implementation_types.size());
+	for (auto &&index : indexes)
+		result.push_back(implementation_types[index]);
+	return result;
+}
+
+}}
@@ -0,0 +1,185 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QtGlobal>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for recording and replaying instantiation profiles.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Measured cost of instantiation of one type.
+ */
+struct type_timing
+{
+	/**
+	 * @brief Name of implementation type.
+	 */
+	std::string type_name;
+
+	/**
+	 * @brief Time spent in provider::provide(), in nanoseconds.
+	 *
+	 * Time of objects created by nested calls to injector (for example from factory) is not included.
+	 */
+	qint64 build_ns;
+
+	/**
+	 * @brief Time spent in INJEQT_INIT methods, in nanoseconds.
+	 *
+	 * Time of objects created by nested calls to injector is not included.
+	 */
+	qint64 init_ns;
+};
+
+/**
+ * @brief Recorded order and costs of instantiation of types.
+ *
+ * Profile is recorded by injector_core and can be saved to file with to_json() and read back with
+ * from_json(). Signature identifies configuration profile was recorded with (see make_profile_signature()),
+ * profile with other signature than current configuration is stale and should not be used.
+ */
+class INJEQT_INTERNAL_API instantiation_profile final
+{
+
+public:
+	/**
+	 * @brief Create empty profile.
+	 */
+	instantiation_profile();
+
+	/**
+	 * @brief Create profile with given @p signature and @p timings.
+	 */
+	explicit instantiation_profile(QByteArray signature, std::vector<type_timing> timings);
+
+	/**
+	 * @return signature of configuration profile was recorded with
+	 */
+	const QByteArray & signature() const;
+
+	/**
+	 * @return costs of types in order of instantiation
+	 */
+	const std::vector<type_timing> & timings() const;
+
+	/**
+	 * @return true if no type was recorded
+	 */
+	bool is_empty() const;
+
+	/**
+	 * @brief Set signature of configuration.
+	 */
+	void set_signature(QByteArray signature);
+
+	/**
+	 * @brief Record that @p implementation_type was provided in @p build_ns nanoseconds.
+	 */
+	void add_build(const type &implementation_type, qint64 build_ns);
+
+	/**
+	 * @brief Record that INJEQT_INIT methods of @p implementation_type took @p init_ns nanoseconds.
+	 *
+	 * Does nothing if build of @p implementation_type was not recorded.
+	 */
+	void add_init(const type &implementation_type, qint64 init_ns);
+
+	/**
+	 * @return total recorded cost of type with @p type_name, 0 if it was not recorded
+	 *
+	 * Costs are summed per type when timings are recorded, so this is a single lookup.
+	 */
+	qint64 cost_of(const std::string &type_name) const;
+
+	/**
+	 * @brief Serialize profile to JSON document.
+	 */
+	QByteArray to_json() const;
+
+	/**
+	 * @brief Read profile from JSON document.
+	 *
+	 * Returns empty profile if @p json is not a valid profile.
+	 */
+	static instantiation_profile from_json(const QByteArray &json);
+
+private:
+	struct type_summary
+	{
+		std::size_t last_timing;
+		qint64 cost;
+	};
+
+	QByteArray _signature;
+	std::vector<type_timing> _timings;
+	std::map<std::string, type_summary> _summaries;
+
+	void add_timing(type_timing timing);
+
+};
+
+/**
+ * @brief Create signature of configuration consisting of @p provided_types.
+ *
+ * Signature depends on names of types and on signatures of all theirs methods, so it changes when types
+ * are added, removed or changed.
+ */
+INJEQT_INTERNAL_API QByteArray make_profile_signature(const std::vector<type> &provided_types);
+
+/**
+ * @brief Return weight of longest dependency chain starting in each of @p implementation_types.
+ * @param implementation_types types to compute weights of
+ * @param dependencies types required by each type to be ready before it - implementations of its setter
+ *        dependencies and types required by its provider
+ * @param profile source of costs of types
+ *
+ * Weight of type is its cost from @p profile plus maximum weight of types it requires. Dependencies are
+ * walked iteratively, so long chains do not exhaust call stack. Cyclic dependencies are broken where walk
+ * first enters a cycle: dependency leading back to a type that is still being computed counts as weight 0.
+ */
+INJEQT_INTERNAL_API std::vector<qint64> critical_path_weights(const std::vector<type> &implementation_types,
+	const std::map<type, std::vector<type>> &dependencies, const instantiation_profile &profile);
+
+/**
+ * @brief Order @p implementation_types so types with longest dependency chains come first.
+ * @see critical_path_weights(const std::vector<type> &, const std::map<type, std::vector<type>> &, const instantiation_profile &)
+ *
+ * Types with equal weights keep theirs relative order.
+ */
+INJEQT_INTERNAL_API std::vector<type> critical_path_order(const std::vector<type> &implementation_types,
+	const std::map<type, std::vector<type>> &dependencies, const instantiation_profile &profile);
+
+}}
@@ -41,7 +41,7 @@ types extract_interfaces(const type &for_type)
 {
 	assert(!for_type.is_empty());
 
-	auto result = std::vector<type>{};
+	auto result = types::storage_type{};
 	auto meta_object = for_type.meta_object();
 	while (meta_object && !is_qobject(meta_object))
 	{
@@ -49,7 +49,7 @@ types extract_interfaces(const type &for_type)
 		meta_object = meta_object->superClass();
 	}
 
-	return types{result};
+	return types{std::move(result)};
 }
 
 bool implements(const type &implementation, const type &interface)
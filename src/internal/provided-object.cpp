@@ -33,7 +33,7 @@ provided_object::provided_object(provider *provided_by, implementation object) :
 	assert(_provided_by);
 	assert(!_provided_by->provided_type().is_empty());
 	assert(!_provided_by->provided_type().is_qobject());
-	assert(_provided_by->provided_type() == object.interface_type());
+	assert(_provided_by->provided_type() == _object.interface_type());
 }
 
 provider * provided_object::provided_by() const
@@ -38,6 +38,9 @@ class provider;
 
 /**
  * @brief Connects implementation objet with provider that created it.
+ *
+ * Provider itself is referenced instead of its provider_entry, as entries can be moved when
+ * objects created by provider add new modules to injector.
  */
 class INJEQT_INTERNAL_API provided_object final
 {
@@ -45,12 +48,12 @@ class INJEQT_INTERNAL_API provided_object final
 public:
 	/**
 	 * @brief Create new instance.
-	 * @param interface_type type that object implements
+	 * @param provided_by provider that created object
 	 * @param object object that should implement interface_type
-	 * @pre provider != nullptr
-	 * @pre !provider->provided_type().is_empty()
-	 * @pre !provider->provided_type().is_qobject()
-	 * @pre provider->provided_type() == object->implementation_type()
+	 * @pre provided_by != nullptr
+	 * @pre !provided_by->provided_type().is_empty()
+	 * @pre !provided_by->provided_type().is_qobject()
+	 * @pre provided_by->provided_type() == object->implementation_type()
 	 */
 	explicit provided_object(provider *provided_by, implementation object);
 
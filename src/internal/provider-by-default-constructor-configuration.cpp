@@ -45,6 +45,11 @@ std::vector<type> provider_by_default_constructor_configuration::types() const
 	return {_object_type};
 }
 
+type provider_by_default_constructor_configuration::provided_type() const
+{
+	return _object_type;
+}
+
 std::unique_ptr<provider> provider_by_default_constructor_configuration::create_provider(const types_by_name &) const
 {
 	if (_object_type.is_qobject())
@@ -62,4 +62,9 @@ bool provider_by_default_constructor::require_resolving() const
 	return true;
 }
 
+void provider_by_default_constructor::reset()
+{
+	_object.reset();
+}
+
 }}
@@ -86,6 +86,11 @@ public:
 	 */
 	virtual bool require_resolving() const;
 
+	/**
+	 * @brief Destroy created object.
+	 */
+	virtual void reset() override;
+
 	/**
 	 * @return constructor object passed in constructor
 	 */
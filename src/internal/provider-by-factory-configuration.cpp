@@ -47,6 +47,11 @@ std::vector<type> provider_by_factory_configuration::types() const
 	return {_object_type, _factory_type};
 }
 
+type provider_by_factory_configuration::provided_type() const
+{
+	return _object_type;
+}
+
 std::unique_ptr<provider> provider_by_factory_configuration::create_provider(const types_by_name &known_types) const
 {
 	if (_object_type.is_qobject())
@@ -68,4 +68,9 @@ bool provider_by_factory::require_resolving() const
 	return false;
 }
 
+void provider_by_factory::reset()
+{
+	_object.reset();
+}
+
 }}
@@ -89,6 +89,11 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @brief Destroy object created by factory.
+	 */
+	virtual void reset() override;
+
 	/**
 	 * @return factory method object passed in constructor
 	 */
@@ -43,6 +43,11 @@ std::vector<type> provider_by_parent_injector_configuration::types() const
 	return {_object_type};
 }
 
+type provider_by_parent_injector_configuration::provided_type() const
+{
+	return _object_type;
+}
+
 std::unique_ptr<provider> provider_by_parent_injector_configuration::create_provider(const types_by_name &) const
 {
 	return std::unique_ptr<provider>{new provider_by_parent_injector{_parent_injector, _object_type}};
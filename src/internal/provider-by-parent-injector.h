@@ -80,6 +80,11 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @brief Does nothing, parent injector takes care of object.
+	 */
+	virtual void reset() override {}
+
 private:
 	injector_impl *_parent_injector;
 	type _provided_type;
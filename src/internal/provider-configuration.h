@@ -68,6 +68,11 @@ public:
 	 */
 	virtual std::vector<type> types() const = 0;
 
+	/**
+	 * @return type of objects that providers created by this configuration provide
+	 */
+	virtual type provided_type() const = 0;
+
 	/**
 	 * @param known_types list of all types known to injector
 	 * @return new provider object
@@ -0,0 +1,100 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+#include "provider.h"
+#include "types.h"
+
+#include <memory>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing provider together with its precomputed metadata.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Provider stored by value with its metadata.
+ *
+ * Values returned by provider::provided_type(), provider::required_types() and provider::require_resolving()
+ * never change during lifetime of a provider, so they are read once in constructor and stored inline. Instances
+ * of this class are kept contiguously in @see providers and code on instantiation paths uses these values
+ * without calling virtual methods or allocating a new types set on each call. Only provider::provide(injector_core &)
+ * and provider::reset() are called on the provider itself.
+ *
+ * Adding modules moves entries, and objects created by providers can add modules, so references to entries
+ * and to theirs required types must not be held while providers are called. Pointer returned by get() is stable.
+ */
+class INJEQT_INTERNAL_API provider_entry final
+{
+
+public:
+	/**
+	 * @brief Create entry for provider @p p.
+	 * @param p provider to store
+	 * @pre p != nullptr
+	 */
+	explicit provider_entry(std::unique_ptr<provider> p);
+
+	provider_entry(provider_entry &&) = default;
+	provider_entry & operator = (provider_entry &&) = default;
+
+	/**
+	 * @return value of provider::provided_type() of stored provider
+	 */
+	const type & provided_type() const { return _provided_type; }
+
+	/**
+	 * @return value of provider::required_types() of stored provider
+	 */
+	const types & required_types() const { return _required_types; }
+
+	/**
+	 * @return value of provider::require_resolving() of stored provider
+	 */
+	bool require_resolving() const { return _require_resolving; }
+
+	/**
+	 * @return stored provider
+	 * @post result != nullptr
+	 */
+	provider * get() const { return _provider.get(); }
+
+	/**
+	 * @brief Give up ownership of stored provider.
+	 * @return stored provider
+	 */
+	provider * release() { return _provider.release(); }
+
+private:
+	type _provided_type;
+	types _required_types;
+	bool _require_resolving;
+	std::unique_ptr<provider> _provider;
+
+};
+
+}}
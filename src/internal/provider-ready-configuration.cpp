@@ -42,6 +42,11 @@ std::vector<type> provider_ready_configuration::types() const
 	return {_object_type};
 }
 
+type provider_ready_configuration::provided_type() const
+{
+	return _object_type;
+}
+
 std::unique_ptr<provider> provider_ready_configuration::create_provider(const types_by_name &) const
 {
 	auto i = internal::make_implementation(_object_type, _object);
@@ -59,6 +59,11 @@ public:
 	 */
 	virtual std::vector<type> types() const override;
 
+	/**
+	 * @return object_type param passed to constructor
+	 */
+	virtual type provided_type() const override;
+
 	/**
 	 * @param known_types list of all types known to injector, not used
 	 * @return pointer to new @see provider_ready object
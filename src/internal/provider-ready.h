@@ -75,6 +75,11 @@ public:
 	 */
 	virtual bool require_resolving() const override;
 
+	/**
+	 * @brief Does nothing, ready object is owned by module.
+	 */
+	virtual void reset() override {}
+
 	/**
 	 * @return implementation object passed in constructor
 	 */
@@ -87,6 +87,14 @@ public:
 	 */
 	virtual bool require_resolving() const = 0;
 
+	/**
+	 * @brief Forget provided object, so next call to provide(injector_core &) will return new one.
+	 *
+	 * Providers that own provided object destroy it. This is used when an object must be recreated,
+	 * because one of its dependencies was removed from injector.
+	 */
+	virtual void reset() = 0;
+
 };
 
 }}
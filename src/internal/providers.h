@@ -23,7 +23,7 @@
 #include <injeqt/injeqt.h>
 #include <injeqt/type.h>
 
-#include "provider.h"
+#include "provider-entry.h"
 #include "sorted-unique-vector.h"
 
 #include <memory>
@@ -36,22 +36,36 @@
 namespace injeqt { namespace internal {
 
 /**
- * @brief Extract provided_type from pointer to provider for storting purposes.
+ * @brief Extract provided_type from provider entry for storting purposes.
  */
-inline type type_from_provider(const std::unique_ptr<provider> &c)
+inline type type_from_provider(const provider_entry &c)
 {
-	return c->provided_type();
+	return c.provided_type();
 }
 
 /**
  * @brief Abstraction of Injeqt set of providers.
  *
- * As provider is an abstract class it stores set of pointers to it.
+ * As provider is an abstract class it stores set of pointers to it, each wrapped in provider_entry
+ * with precomputed metadata, so entries are kept contiguously.
  *
  * This set is used to represent all providers available to module and injector. It is
  * not possible to store two providers with the same provider::provided_type() values in it.
  * Set is sorted by provider::provided_type().
  */
-using providers = sorted_unique_vector<type, std::unique_ptr<provider>, type_from_provider>;
+using providers = sorted_unique_vector<type, provider_entry, type_from_provider>;
+
+/**
+ * @brief Create set of providers from list of pointers to providers.
+ * @param all_providers providers to store
+ */
+inline providers make_providers(std::vector<std::unique_ptr<provider>> all_providers)
+{
+	auto result = std::vector<provider_entry>{};
+	result.reserve(all_providers.size());
+	for (auto &&p : all_providers)
+		result.emplace_back(std::move(p));
+	return providers{std::move(result)};
+}
 
 }}
@@ -0,0 +1,81 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "reachability.h"
+
+#include "dependencies.h"
+#include "interfaces-utils.h"
+#include "provider-configuration.h"
+#include "type-role.h"
+
+#include <map>
+
+namespace injeqt { namespace internal {
+
+pruned_provider_configurations prune_provider_configurations(
+	const std::vector<const provider_configuration *> &provider_configurations,
+	const std::vector<std::string> &root_type_names, const std::vector<std::string> &root_type_roles)
+{
+	auto configurations_by_interface = std::map<std::string, std::vector<std::size_t>>{};
+	for (auto i = std::size_t{0}; i < provider_configurations.size(); i++)
+		for (auto &&interface_type : extract_interfaces(provider_configurations[i]->provided_type()))
+			configurations_by_interface[interface_type.name()].push_back(i);
+
+	auto reachable = std::vector<bool>(provider_configurations.size(), false);
+	auto to_visit = std::vector<std::size_t>{};
+	auto visit_name = [&](const std::string &name){
+		auto configurations_it = configurations_by_interface.find(name);
+		if (configurations_it != std::end(configurations_by_interface))
+			std::copy(std::begin(configurations_it->second), std::end(configurations_it->second), std::back_inserter(to_visit));
+	};
+
+	for (auto &&root_type_name : root_type_names)
+		visit_name(root_type_name);
+	for (auto i = std::size_t{0}; i < provider_configurations.size(); i++)
+		for (auto &&root_type_role : root_type_roles)
+			if (has_type_role(provider_configurations[i]->provided_type(), root_type_role))
+				to_visit.push_back(i);
+
+	while (!to_visit.empty())
+	{
+		auto index = to_visit.back();
+		to_visit.pop_back();
+		if (reachable[index])
+			continue;
+		reachable[index] = true;
+
+		auto configuration = provider_configurations[index];
+		for (auto &&known_type : configuration->types())
+			if (known_type != configuration->provided_type())
+				visit_name(known_type.name());
+		for (auto &&dependency_type_name : extract_dependency_type_names(configuration->provided_type()))
+			visit_name(dependency_type_name);
+	}
+
+	auto result = pruned_provider_configurations{};
+	for (auto i = std::size_t{0}; i < provider_configurations.size(); i++)
+		if (reachable[i])
+			result.reachable.push_back(provider_configurations[i]);
+		else
+			result.pruned_types.push_back(provider_configurations[i]->provided_type());
+	return result;
+}
+
+}}
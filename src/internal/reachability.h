@@ -0,0 +1,71 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains functions for pruning provider configurations not reachable from set of roots.
+ */
+
+namespace injeqt { namespace internal {
+
+class provider_configuration;
+
+/**
+ * @brief Result of prune_provider_configurations().
+ */
+struct pruned_provider_configurations
+{
+	/**
+	 * @brief Configurations reachable from roots, in original order.
+	 */
+	std::vector<const provider_configuration *> reachable;
+
+	/**
+	 * @brief Provided types of configurations not reachable from roots, in original order.
+	 */
+	std::vector<type> pruned_types;
+};
+
+/**
+ * @brief Split @p provider_configurations into ones reachable from roots and the rest.
+ * @param provider_configurations all configurations
+ * @param root_type_names names of types (or interfaces of types) that are requested directly
+ * @param root_type_roles roles of types that are requested directly
+ *
+ * Configuration is reachable if its provided type implements one of @p root_type_names, has one of
+ * @p root_type_roles or is required by reachable configuration. Configuration requires types of setters
+ * of its provided type (all implementations for INJEQT_SET_ALL setters) and other types it knows about,
+ * like factory type. Only names of setter parameters are read, setters are not validated.
+ */
+INJEQT_INTERNAL_API pruned_provider_configurations prune_provider_configurations(
+	const std::vector<const provider_configuration *> &provider_configurations,
+	const std::vector<std::string> &root_type_names, const std::vector<std::string> &root_type_roles);
+
+}}
@@ -0,0 +1,54 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ready-objects.h"
+
+#include <cassert>
+
+namespace injeqt { namespace internal {
+
+ready_objects::ready_objects(std::size_t size) :
+	_size{size},
+	_objects{new std::atomic<QObject *>[size]}
+{
+	for (auto i = std::size_t{0}; i < _size; i++)
+		_objects[i].store(nullptr, std::memory_order_relaxed);
+}
+
+std::size_t ready_objects::size() const
+{
+	return _size;
+}
+
+QObject * ready_objects::get(std::size_t index) const
+{
+	assert(index < _size);
+
+	return _objects[index].load(std::memory_order_acquire);
+}
+
+void ready_objects::set(std::size_t index, QObject *object)
+{
+	assert(index < _size);
+
+	_objects[index].store(object, std::memory_order_release);
+}
+
+}}
@@ -0,0 +1,82 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include "internal.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing table of objects readable without locking.
+ */
+
+class QObject;
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Fixed size table of objects that can be read and written concurrently.
+ *
+ * Each slot is written at most once, with object that is fully created and initialized. Slots are written
+ * with release semantics and read with acquire semantics, so thread that reads object from slot also sees
+ * everything that was done to that object before it was stored.
+ */
+class INJEQT_INTERNAL_API ready_objects final
+{
+
+public:
+	/**
+	 * @brief Create table with @p size empty slots.
+	 */
+	explicit ready_objects(std::size_t size = 0);
+
+	ready_objects(const ready_objects &) = delete;
+	ready_objects & operator = (const ready_objects &) = delete;
+
+	/**
+	 * @return number of slots
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @return object stored in slot @p index or nullptr if slot is empty
+	 * @pre index < size()
+	 */
+	QObject * get(std::size_t index) const;
+
+	/**
+	 * @brief Store @p object in slot @p index.
+	 * @pre index < size()
+	 */
+	void set(std::size_t index, QObject *object);
+
+private:
+	std::size_t _size;
+	std::unique_ptr<std::atomic<QObject *>[]> _objects;
+
+};
+
+}}
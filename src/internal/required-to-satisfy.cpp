@@ -25,47 +25,64 @@
 #include "interfaces-utils.h"
 
 #include <cassert>
-#include <set>
 
 namespace injeqt { namespace internal {
 
-types required_to_satisfy(const dependencies &dependencies_to_satisfy, const types_model &model, const implementations &objects)
+types required_to_satisfy(const dependencies &dependencies_to_satisfy, const types_model &model, const node_set &ready)
 {
 	assert(model.get_unresolvable_dependencies().empty());
 
+	auto &graph = model.graph();
+	assert(ready.size() == graph.size());
+
+	auto required = node_set{graph.size()};
+	auto add_interface_to_check = [&](const type &interface_type){
+		auto implementation_it = model.available_types().get(interface_type);
+		if (implementation_it == std::end(model.available_types()))
+			return;
+
+		auto id = graph.find(implementation_it->implementation_type());
+		if (ready.test(id) || required.test(id))
+			return;
+
+		required.set(id);
+		required |= graph.closure(id);
+	};
+
+	for (auto &&d : dependencies_to_satisfy)
+		if (d.setter().is_all())
+			for (auto &&implementation_type : model.all_implementations_of(d.required_type()))
+				add_interface_to_check(implementation_type);
+		else
+			add_interface_to_check(d.required_type());
+
+	required.and_not(ready);
+
 	auto result = std::vector<type>{};
-	auto ready = std::set<type>{};
-	std::transform(std::begin(objects), std::end(objects), std::inserter(ready, std::end(ready)),
-		[](const implementation &i){ return i.interface_type(); });
+	for (auto id : required.ids())
+		result.push_back(graph.node_type(id));
+	return types{std::move(result)};
+}
+
+node_set ready_nodes(const types_model &model, const implementations &objects)
+{
+	auto result = node_set{model.graph().size()};
+	mark_ready(result, model, objects.content());
+	return result;
+}
 
-	auto interfaces_to_check = std::vector<type>{};
-	std::transform(std::begin(dependencies_to_satisfy), std::end(dependencies_to_satisfy), std::back_inserter(interfaces_to_check),
-		[](const dependency &d){ return d.required_type(); });
+void mark_ready(node_set &ready, const types_model &model, const std::vector<implementation> &objects)
+{
+	auto &graph = model.graph();
+	assert(ready.size() == graph.size());
 
-	while (!interfaces_to_check.empty())
+	// objects contain entries for theirs implementation types as well, so these nodes are marked
+	for (auto &&object : objects)
 	{
-		auto current_interface_type = interfaces_to_check.back();
-		interfaces_to_check.pop_back();
-
-		auto current_implementation_type_it = model.available_types().get(current_interface_type);
-		if (current_implementation_type_it == std::end(model.available_types()))
-			continue;
-
-		auto current_implementation_type = current_implementation_type_it->implementation_type();
-		if (ready.find(current_implementation_type) != std::end(ready))
-			continue;
-		ready.insert(current_implementation_type);
-		result.push_back(current_implementation_type);
-
-		if (model.mapped_dependencies().contains_key(current_implementation_type))
-		{
-			auto dependencies = model.mapped_dependencies().get(current_implementation_type)->dependency_list();
-			std::transform(std::begin(dependencies), std::end(dependencies), std::back_inserter(interfaces_to_check),
-				[](const dependency &d){ return d.required_type(); });
-		}
+		auto id = graph.find(object.interface_type());
+		if (id != graph.size())
+			ready.set(id);
 	}
-
-	return types{result};
 }
 
 }}
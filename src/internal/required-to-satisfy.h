@@ -38,13 +38,35 @@ namespace injeqt { namespace internal {
  * @brief Return list of types required to properly satisfy provided dependnecies.
  * @param dependencies_to_satisfy list of dependencies to satisfy
  * @param model model of all types in system, must be valid
- * @param objects list of available interfaces, must be valid
+ * @param ready set of nodes of model.graph() that already have objects, created with ready_nodes()
  * @pre model.get_unresolvable_dependencies().empty()
+ * @pre ready.size() == model.graph().size()
  *
  * This function computes list of all types that must be instantiated in order to properly resolve all
- * provided dependencies. It means it recursively traverses dependency tree and returns all nodes that
- * are not found in @p objects set.
+ * provided dependencies. Dependencies with setters tagged with INJEQT_SET_ALL require all implementations
+ * of theirs type.
+ *
+ * Result is union of memoized closures of dependency_graph of all required types that are not ready,
+ * without nodes from @p ready, computed in one pass. Injector instantiates whole closure of each object,
+ * so closures of ready nodes are ready as well. If they are not (for example objects of providers that
+ * do not resolve them), result can contain types reachable only through ready nodes.
+ */
+INJEQT_INTERNAL_API types required_to_satisfy(const dependencies &dependencies_to_satisfy, const types_model &model, const node_set &ready);
+
+/**
+ * @brief Return set of nodes of model.graph() that have objects in @p objects.
+ * @param model model of all types in system
+ * @param objects list of available interfaces
+ *
+ * This function is linear in size of @p objects, so injector calls it only when graph changes and
+ * updates returned set with mark_ready() when new objects are created.
+ */
+INJEQT_INTERNAL_API node_set ready_nodes(const types_model &model, const implementations &objects);
+
+/**
+ * @brief Add nodes of model.graph() that have objects in @p objects to @p ready.
+ * @pre ready.size() == model.graph().size()
  */
-INJEQT_INTERNAL_API types required_to_satisfy(const dependencies &dependencies_to_satisfy, const types_model &model, const implementations &objects);
+INJEQT_INTERNAL_API void mark_ready(node_set &ready, const types_model &model, const std::vector<implementation> &objects);
 
 }}
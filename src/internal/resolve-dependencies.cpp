@@ -20,6 +20,9 @@
 
 #include "resolve-dependencies.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "dependency.h"
 #include "implementations.h"
 #include "resolved-dependency.h"
@@ -28,13 +31,18 @@ namespace injeqt { namespace internal {
 
 resolve_dependencies_result resolve_dependencies(const dependencies &to_resolve, const implementations &resolve_with)
 {
-	auto match_result = match(to_resolve, resolve_with, type_from_dependency, type_from_implementation, match_increment_mode::left);
+	auto unresolved = std::vector<dependency>{};
 	auto resolved = std::vector<resolved_dependency>{};
+	resolved.reserve(to_resolve.size());
 
-	for (auto &&match : match_result.matched)
-		resolved.emplace_back(match.second, match.first.setter());
+	// skipping INJEQT_SET_ALL dependencies does not change result of matching others in left increment mode
+	match_visit(to_resolve, resolve_with, type_from_dependency, type_from_implementation,
+		[&](const dependency &d, const implementation &i){ if (!d.setter().is_all()) resolved.emplace_back(i, d.setter()); },
+		[&](const dependency &d){ if (!d.setter().is_all()) unresolved.push_back(d); },
+		ignore_match{},
+		match_increment_mode::left);
 
-	return {dependencies{match_result.unmatched_1}, resolved};
+	return {dependencies{already_sorted_unique, std::move(unresolved)}, std::move(resolved)};
 }
 
 }}
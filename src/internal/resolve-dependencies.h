@@ -64,6 +64,8 @@ struct resolve_dependencies_result
  * have corresponding object - it is added to resolve_dependencies_result::unresolved field. All matching dependency -
  * implementation pairs are added to resolve_dependencies_result::resolved field.
  *
+ * Dependencies with setters tagged with INJEQT_SET_ALL are skipped, as they are resolved with list of objects.
+ *
  * This function requires that all items in both sets are valid. In other case its behavior is undefined.
  * This function returns only valid objects.
  */
@@ -44,7 +44,7 @@ const setter_method & resolved_dependency::setter() const
 	return _setter;
 }
 
-bool resolved_dependency::apply_on(QObject *on)
+bool resolved_dependency::apply_on(QObject *on) const
 {
 	assert(on != nullptr);
 	assert(implements(type{on->metaObject()}, _setter.object_type()));
@@ -72,7 +72,7 @@ public:
 	 *
 	 * This method can only be called on valid resolved_dependency object.
 	 */
-	bool apply_on(QObject *on);
+	bool apply_on(QObject *on) const;
 
 private:
 	implementation _resolved_with;
@@ -25,15 +25,43 @@
 
 #include "interfaces-utils.h"
 
+#include <QtCore/QList>
+#include <QtCore/QMetaType>
 #include <cassert>
 
 namespace injeqt { namespace internal {
 
+namespace {
+
+int parameter_list_type_id(const QMetaMethod &meta_method)
+{
+	auto meta_object = meta_method.enclosingMetaObject();
+	if (!meta_object || meta_method.parameterCount() != 1)
+		return QMetaType::UnknownType;
+
+	auto result = meta_method.parameterType(0);
+	if (result != QMetaType::UnknownType)
+		return result;
+
+	// moc registers QList of pointers to QObject-derived types when asked for argument metatype
+	auto argument_index = 0;
+	void *arguments[] = {&result, &argument_index};
+	meta_object->static_metacall(QMetaObject::RegisterMethodArgumentMetaType, meta_method.methodIndex() - meta_object->methodOffset(), arguments);
+	return result > 0 ? result : static_cast<int>(QMetaType::UnknownType);
+}
+
+}
+
 bool setter_method::is_setter_tag(const std::string &tag)
 {
 	return tag == "INJEQT_SET" || tag == "INJEQT_SETTER";
 }
 
+bool setter_method::is_setter_all_tag(const std::string &tag)
+{
+	return tag == "INJEQT_SET_ALL";
+}
+
 bool setter_method::validate_setter_method(type parameter_type, const QMetaMethod &meta_method)
 {
 	auto meta_object = meta_method.enclosingMetaObject();
@@ -43,7 +71,7 @@ bool setter_method::validate_setter_method(type parameter_type, const QMetaMetho
 		throw exception::invalid_setter{std::string{"setter is signal: "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
 	if (meta_method.methodType() == QMetaMethod::Constructor)
 		throw exception::invalid_setter{std::string{"setter is constructor: "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
-	if (!is_setter_tag(meta_method.tag()))
+	if (!is_setter_tag(meta_method.tag()) && !is_setter_all_tag(meta_method.tag()))
 		throw exception::invalid_setter{std::string{"setter does not have valid tag: "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
 	if (meta_method.parameterCount() != 1)
 		throw exception::invalid_setter{std::string{"invalid parameter count: "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
@@ -51,21 +79,28 @@ bool setter_method::validate_setter_method(type parameter_type, const QMetaMetho
 		throw exception::invalid_setter{std::string{"invalid parameter (empty): "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
 	if (parameter_type.is_empty())
 		throw exception::invalid_setter{std::string{"invalid parameter (qobject): "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
-	if (parameter_type.name() + "*" != std::string{meta_method.parameterTypes()[0].data()})
+	auto expected_parameter_type_name = is_setter_all_tag(meta_method.tag())
+		? "QList<" + parameter_type.name() + "*>"
+		: parameter_type.name() + "*";
+	if (expected_parameter_type_name != std::string{meta_method.parameterTypes()[0].data()})
 		throw exception::invalid_setter{std::string{"invalid parameter (type): "} + meta_object->className() + "::" + meta_method.methodSignature().data()};
 	return true;
 }
 
-setter_method::setter_method()
+setter_method::setter_method() :
+	_all{false},
+	_parameter_list_type_id{QMetaType::UnknownType}
 {
 }
 
 setter_method::setter_method(type parameter_type, QMetaMethod meta_method) :
 	_object_type{meta_method.enclosingMetaObject()},
 	_parameter_type{std::move(parameter_type)},
-	_meta_method{std::move(meta_method)}
+	_meta_method{std::move(meta_method)},
+	_all{is_setter_all_tag(_meta_method.tag())},
+	_parameter_list_type_id{_all ? parameter_list_type_id(_meta_method) : static_cast<int>(QMetaType::UnknownType)}
 {
-	assert(validate_setter_method(parameter_type, meta_method));
+	assert(validate_setter_method(_parameter_type, _meta_method));
 }
 
 bool setter_method::is_empty() const
@@ -73,6 +108,11 @@ bool setter_method::is_empty() const
 	return !_meta_method.isValid();
 }
 
+bool setter_method::is_all() const
+{
+	return _all;
+}
+
 const type & setter_method::object_type() const
 {
 	return _object_type;
@@ -105,6 +145,48 @@ bool setter_method::invoke(QObject *on, QObject *parameter) const
 	return _meta_method.invoke(on, Q_ARG(QObject *, parameter));
 }
 
+bool setter_method::invoke(QObject *on, const std::vector<QObject *> &parameters) const
+{
+	assert(!is_empty());
+	assert(is_all());
+	assert(on != nullptr);
+	assert(implements(type{on->metaObject()}, _object_type));
+
+	return invoke(on, make_parameter_list(parameters));
+}
+
+QList<void *> setter_method::make_parameter_list(const std::vector<QObject *> &objects) const
+{
+	assert(is_all());
+
+	auto result = QList<void *>{};
+	result.reserve(static_cast<int>(objects.size()));
+	for (auto &&object : objects)
+	{
+		assert(object != nullptr);
+		assert(implements(type{object->metaObject()}, _parameter_type));
+		auto parameter = object->qt_metacast(_parameter_type.name().c_str());
+		assert(parameter != nullptr);
+		result.append(parameter);
+	}
+	return result;
+}
+
+bool setter_method::invoke(QObject *on, const QList<void *> &parameters) const
+{
+	assert(!is_empty());
+	assert(is_all());
+	assert(on != nullptr);
+	assert(implements(type{on->metaObject()}, _object_type));
+
+	// list holds T * pointers for parameter type T, so it has representation of QList<T *>
+	if (_parameter_list_type_id != QMetaType::UnknownType)
+		return _meta_method.invoke(on, QGenericArgument{QMetaType::typeName(_parameter_list_type_id), &parameters});
+
+	auto type_name = _meta_method.parameterTypes()[0];
+	return _meta_method.invoke(on, QGenericArgument{type_name.constData(), &parameters});
+}
+
 bool operator == (const setter_method &x, const setter_method &y)
 {
 	if (x.object_type() != y.object_type())
@@ -158,9 +240,11 @@ bool operator >= (const setter_method &x, const setter_method &y)
 
 setter_method make_setter_method(const types_by_name &known_types, const QMetaMethod &meta_method)
 {
-	auto parameter_type = meta_method.parameterCount() == 1
-		? type_by_pointer(known_types, meta_method.parameterTypes()[0].data())
-		: type{nullptr};
+	auto parameter_type = meta_method.parameterCount() != 1
+		? type{nullptr}
+		: setter_method::is_setter_all_tag(meta_method.tag())
+			? type_by_pointer_list(known_types, meta_method.parameterTypes()[0].data())
+			: type_by_pointer(known_types, meta_method.parameterTypes()[0].data());
 	setter_method::validate_setter_method(parameter_type, meta_method);
 
 	return setter_method{parameter_type, meta_method};
@@ -27,6 +27,7 @@
 #include "internal.h"
 #include "types-by-name.h"
 
+#include <QtCore/QList>
 #include <QtCore/QMetaMethod>
 
 /**
@@ -61,12 +62,23 @@ namespace injeqt { namespace internal {
  *     };
  *
  * Object with setter method must not take ownership of passed object.
+ *
+ * Setter method tagged with INJEQT_SET_ALL receives objects of all configured types that implement
+ * its parameter type. Its only parameter must be a QList of pointers to type inherited from QObject:
+ *
+ *     class with_setter_all : public QObject
+ *     {
+ *         Q_OBJECT
+ *     public slots:
+ *         INJEQT_SET_ALL void setter(QList<set_object *> objs) { ... }
+ *     };
  */
 class INJEQT_INTERNAL_API setter_method final
 {
 
 public:
 	static bool is_setter_tag(const std::string &tag);
+	static bool is_setter_all_tag(const std::string &tag);
 
 	static bool validate_setter_method(type parameter_type, const QMetaMethod &meta_method);
 
@@ -93,6 +105,11 @@ public:
 	 */
 	bool is_empty() const;
 
+	/**
+	 * @return true if setter method is tagged with INJEQT_SET_ALL and accepts list of all implementations of parameter_type()
+	 */
+	bool is_all() const;
+
 	/**
 	 * @return Type of objects that owns this setter method.
 	 *
@@ -139,10 +156,43 @@ public:
 	 */
 	bool invoke(QObject *on, QObject *parameter) const;
 
+	/**
+	 * @param on object to call this method on
+	 * @param parameters parmeters to be passed in invocation as one list
+	 * @return true if invoke was successfull
+	 * @pre !is_empty()
+	 * @pre is_all()
+	 * @pre on != nullptr
+	 * @pre type{on->metaObject()} == object_type()
+	 * @pre each of parameters implements _parameter_type
+	 */
+	bool invoke(QObject *on, const std::vector<QObject *> &parameters) const;
+
+	/**
+	 * @return list of pointers to parameter_type() parts of @p objects, ready to be passed to invoke(QObject *, const QList<void *> &)
+	 * @pre is_all()
+	 * @pre each of objects implements _parameter_type
+	 *
+	 * Each pointer is obtained with QObject::qt_metacast, so it points to the same address as QList<T *> of
+	 * parameter type T would contain, even for types where QObject is not at start of object.
+	 */
+	QList<void *> make_parameter_list(const std::vector<QObject *> &objects) const;
+
+	/**
+	 * @brief Invoke setter with list prepared by make_parameter_list(const std::vector<QObject *> &).
+	 * @see invoke(QObject *, const std::vector<QObject *> &)
+	 *
+	 * List is passed as argument of QList<T *> metatype registered for parameter of setter. QList is implicitly
+	 * shared, so passing the same list to many objects does not copy it.
+	 */
+	bool invoke(QObject *on, const QList<void *> &parameters) const;
+
 private:
 	type _object_type;
 	type _parameter_type;
 	QMetaMethod _meta_method;
+	bool _all;
+	int _parameter_list_type_id;
 
 };
 
@@ -0,0 +1,320 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing vectors with inline storage for few items.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @addtogroup Misc
+ * @{
+ */
+
+/**
+ * @class small_vector
+ * @short Vector that stores up to N items inline, without heap allocation.
+ * @tparam T type of data
+ * @tparam N number of items stored inline
+ *
+ * Used as storage of sorted_unique_vector for small per-type lists, like interfaces or
+ * dependencies of a type. When more than N items are stored, all of them are moved to heap,
+ * like in std::vector. Provides subset of std::vector interface used by sorted_unique_vector.
+ */
+template<typename T, std::size_t N>
+class small_vector
+{
+	static_assert(N > 0, "small_vector must have inline storage for at least one item");
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T &;
+	using const_reference = const T &;
+	using pointer = T *;
+	using const_pointer = const T *;
+	using iterator = T *;
+	using const_iterator = const T *;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	small_vector() {}
+
+	small_vector(std::initializer_list<T> values)
+	{
+		append(std::begin(values), std::end(values));
+	}
+
+	small_vector(const std::vector<T> &values)
+	{
+		append(std::begin(values), std::end(values));
+	}
+
+	small_vector(std::vector<T> &&values)
+	{
+		append(std::make_move_iterator(std::begin(values)), std::make_move_iterator(std::end(values)));
+	}
+
+	small_vector(const small_vector &other)
+	{
+		append(std::begin(other), std::end(other));
+	}
+
+	// inline items of other fit into inline storage, so only moving them could throw
+	small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		take(other);
+	}
+
+	~small_vector()
+	{
+		clear();
+		deallocate();
+	}
+
+	small_vector & operator = (const small_vector &other)
+	{
+		if (this != &other)
+		{
+			clear();
+			append(std::begin(other), std::end(other));
+		}
+		return *this;
+	}
+
+	small_vector & operator = (small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		if (this != &other)
+		{
+			clear();
+			deallocate();
+			take(other);
+		}
+		return *this;
+	}
+
+	iterator begin() { return _data; }
+	iterator end() { return _data + _size; }
+	const_iterator begin() const { return _data; }
+	const_iterator end() const { return _data + _size; }
+	reverse_iterator rbegin() { return reverse_iterator{end()}; }
+	reverse_iterator rend() { return reverse_iterator{begin()}; }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+	const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+
+	pointer data() { return _data; }
+	const_pointer data() const { return _data; }
+
+	reference operator [] (size_type i) { return _data[i]; }
+	const_reference operator [] (size_type i) const { return _data[i]; }
+
+	reference back() { return _data[_size - 1]; }
+	const_reference back() const { return _data[_size - 1]; }
+
+	bool empty() const { return _size == 0; }
+	size_type size() const { return _size; }
+	size_type capacity() const { return _capacity; }
+
+	/**
+	 * @return true if items are stored inline
+	 */
+	bool is_inline() const { return _data == inline_data(); }
+
+	void reserve(size_type capacity)
+	{
+		if (capacity > _capacity)
+			reallocate(capacity);
+	}
+
+	void clear()
+	{
+		for (auto it = begin(); it != end(); ++it)
+			it->~T();
+		_size = 0;
+	}
+
+	void push_back(const T &item)
+	{
+		emplace_back(item);
+	}
+
+	void push_back(T &&item)
+	{
+		emplace_back(std::move(item));
+	}
+
+	template<typename... Args>
+	void emplace_back(Args &&... args)
+	{
+		if (_size == _capacity)
+		{
+			// args can refer to one of items
+			auto item = T(std::forward<Args>(args)...);
+			reallocate(2 * _capacity);
+			new (_data + _size) T(std::move(item));
+		}
+		else
+			new (_data + _size) T(std::forward<Args>(args)...);
+		++_size;
+	}
+
+	template<typename... Args>
+	iterator emplace(const_iterator position, Args &&... args)
+	{
+		auto index = position - begin();
+		if (index == static_cast<difference_type>(_size))
+		{
+			emplace_back(std::forward<Args>(args)...);
+			return begin() + index;
+		}
+
+		auto item = T(std::forward<Args>(args)...);
+		emplace_back(std::move(back()));
+		std::move_backward(begin() + index, end() - 2, end() - 1);
+		*(begin() + index) = std::move(item);
+		return begin() + index;
+	}
+
+	template<typename InputIterator>
+	iterator insert(const_iterator position, InputIterator first, InputIterator last)
+	{
+		auto index = position - begin();
+		auto old_size = _size;
+		append(first, last);
+		std::rotate(begin() + index, begin() + old_size, end());
+		return begin() + index;
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		auto index = first - begin();
+		auto count = last - first;
+		if (count == 0)
+			return begin() + index;
+
+		auto new_end = std::move(begin() + index + count, end(), begin() + index);
+		for (auto it = new_end; it != end(); ++it)
+			it->~T();
+		_size -= count;
+		return begin() + index;
+	}
+
+	iterator erase(const_iterator position)
+	{
+		return erase(position, position + 1);
+	}
+
+private:
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type _inline[N];
+	T *_data = inline_data();
+	size_type _size = 0;
+	size_type _capacity = N;
+
+	T * inline_data()
+	{
+		return reinterpret_cast<T *>(_inline);
+	}
+
+	const T * inline_data() const
+	{
+		return reinterpret_cast<const T *>(_inline);
+	}
+
+	template<typename InputIterator>
+	void append(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+
+	void reallocate(size_type capacity)
+	{
+		auto data = static_cast<T *>(::operator new(capacity * sizeof(T)));
+		for (auto i = size_type{0}; i < _size; i++)
+		{
+			new (data + i) T(std::move(_data[i]));
+			_data[i].~T();
+		}
+		deallocate();
+		_data = data;
+		_capacity = capacity;
+	}
+
+	void deallocate()
+	{
+		if (!is_inline())
+			::operator delete(_data);
+		_data = inline_data();
+		_capacity = N;
+	}
+
+	void take(small_vector &other)
+	{
+		if (other.is_inline())
+		{
+			append(std::make_move_iterator(std::begin(other)), std::make_move_iterator(std::end(other)));
+			other.clear();
+		}
+		else
+		{
+			_data = other._data;
+			_size = other._size;
+			_capacity = other._capacity;
+			other._data = other.inline_data();
+			other._size = 0;
+			other._capacity = N;
+		}
+	}
+
+};
+
+template<typename T, std::size_t N>
+bool operator == (const small_vector<T, N> &x, const small_vector<T, N> &y)
+{
+	return x.size() == y.size() && std::equal(std::begin(x), std::end(x), std::begin(y));
+}
+
+template<typename T, std::size_t N>
+bool operator != (const small_vector<T, N> &x, const small_vector<T, N> &y)
+{
+	return !(x == y);
+}
+
+/**
+ * @}
+ */
+
+}}
@@ -23,7 +23,9 @@
 #include <injeqt/injeqt.h>
 
 #include <algorithm>
+#include <cassert>
 #include <functional>
+#include <iterator>
 #include <vector>
 
 namespace injeqt { namespace internal {
@@ -33,22 +35,33 @@ namespace injeqt { namespace internal {
  * @{
  */
 
+/**
+ * @short Tag type for constructing sorted_unique_vector from data that is already sorted and unique.
+ */
+struct already_sorted_unique_t {};
+
+/**
+ * @short Tag value for constructing sorted_unique_vector from data that is already sorted and unique.
+ */
+constexpr already_sorted_unique_t already_sorted_unique{};
+
 /**
  * @class sorted_unique_vector
  * @short Vector that stored only unique values thata are always sorted.
- * @tparam T type of data
- * @tparam LessThanComparator comparator used for sorting
- * @tparam EqualityComparator comparator used for uniqueness testing
+ * @tparam K type of key
+ * @tparam V type of data
+ * @tparam KeyExtractor function returning key of item used for sorting and uniqueness testing
+ * @tparam Storage type of underlying storage, std::vector or small_vector for small per-type lists
  */
-template<typename K, typename V, K (*KeyExtractor)(const V &)>
+template<typename K, typename V, K (*KeyExtractor)(const V &), typename Storage = std::vector<V>>
 class sorted_unique_vector
 {
 
 public:
-	using type = sorted_unique_vector<K, V, KeyExtractor>;
+	using type = sorted_unique_vector<K, V, KeyExtractor, Storage>;
 	using value_type = V;
 	using key_type = K;
-	using storage_type = std::vector<value_type>;
+	using storage_type = Storage;
 	using const_iterator = typename storage_type::const_iterator;
 	using size_type = typename storage_type::size_type;
 
@@ -74,6 +87,14 @@ private:
 	}
 
 public:
+	/**
+	 * @return key of @p v used for sorting and uniqueness testing
+	 */
+	static key_type key_of(const value_type &v)
+	{
+		return KeyExtractor(v);
+	}
+
 	/**
 	 * @short Create empty sorted_unique_vector.
 	 */
@@ -105,6 +126,20 @@ public:
 		ensure_unique(_content);
 	}
 
+	/**
+	 * @short Create sorted_unique_vector from given vector that is already sorted and without duplicates.
+	 * @param storage vector to get data from
+	 * @pre storage is sorted and does not contain items with equal keys
+	 *
+	 * Takes content of storage without sorting it again.
+	 */
+	explicit sorted_unique_vector(already_sorted_unique_t, storage_type storage) :
+			_content{std::move(storage)}
+	{
+		assert(std::is_sorted(std::begin(_content), std::end(_content), compare_keys));
+		assert(std::adjacent_find(std::begin(_content), std::end(_content), keys_equal) == std::end(_content));
+	}
+
 	const_iterator begin() const
 	{
 		return std::begin(_content);
@@ -136,22 +171,78 @@ public:
 			_content.emplace(upperBound, std::move(item));
 	}
 
+	/**
+	 * @short Add many items to sorted vector.
+	 * @param items new items, not necessarily sorted
+	 *
+	 * Items are sorted and merged into vector at once, which is cheaper than adding them one by one
+	 * with add(value_type). On duplicates item that was already in this vector is kept.
+	 */
+	void add_all(storage_type items)
+	{
+		merge(type{std::move(items)});
+	}
+
 	/**
 	 * @short Merge with another sorted vector.
 	 * @param sorted_vector vector to merge with
 	 *
-	 * All items from sorted_vector are added at proper places and duplicates are removed.
+	 * All items from sorted_vector are added at proper places and duplicates are removed. On duplicates
+	 * item that was already in this vector is kept. Merging is done in place, from the end of vector, so
+	 * only items that are greater than smallest item of sorted_vector are moved and no new storage is
+	 * allocated if capacity of this vector is big enough.
 	 */
 	void merge(const type &sorted_vector)
 	{
-		auto result = storage_type{};
+		if (&sorted_vector == this || sorted_vector._content.empty())
+			return;
 
-		std::merge(std::begin(_content), std::end(_content),
-			std::begin(sorted_vector._content), std::end(sorted_vector._content),
-			std::back_inserter(result), compare_keys);
-		ensure_unique(result);
+		_content.insert(std::end(_content), std::begin(sorted_vector._content), std::end(sorted_vector._content));
+		merge_backward(std::begin(sorted_vector._content), std::end(sorted_vector._content));
+	}
 
-		_content = std::move(result);
+	/**
+	 * @short Merge with another sorted vector, moving its items.
+	 * @param sorted_vector vector to merge with
+	 *
+	 * Works like merge(const type &), but can be used with move-only items.
+	 */
+	void merge(type &&sorted_vector)
+	{
+		if (&sorted_vector == this || sorted_vector._content.empty())
+			return;
+
+		if (_content.empty())
+		{
+			std::swap(_content, sorted_vector._content);
+			return;
+		}
+
+		// free places at the end are made of moved-from items, so move-only items can be merged as well
+		auto old_size = _content.size();
+		for (auto &&item : sorted_vector._content)
+			_content.emplace_back(std::move(item));
+		std::swap_ranges(std::begin(_content) + old_size, std::end(_content), std::begin(sorted_vector._content));
+
+		merge_backward(std::make_move_iterator(std::begin(sorted_vector._content)), std::make_move_iterator(std::end(sorted_vector._content)));
+		sorted_vector._content.clear();
+	}
+
+	/**
+	 * @short Reserve storage for @p size items.
+	 * @param size expected number of items
+	 */
+	void reserve(size_type size)
+	{
+		_content.reserve(size);
+	}
+
+	/**
+	 * @return number of items that can be stored without reallocation
+	 */
+	size_type capacity() const
+	{
+		return _content.capacity();
 	}
 
 	/**
@@ -187,11 +278,7 @@ public:
 	 */
 	bool contains_key(const key_type &k) const
 	{
-		auto lower_bound = std::lower_bound(begin(), end(), k, compare_with_key);
-		if (lower_bound == end())
-			return false;
-
-		return k == KeyExtractor(*lower_bound);
+		return get(k) != end();
 	}
 
 	/**
@@ -226,6 +313,19 @@ public:
 		_content.clear();
 	}
 
+	/**
+	 * @short Moves all items out of sorted vector.
+	 * @return all items that were stored in sorted vector
+	 *
+	 * Sorted vector is empty after this call.
+	 */
+	storage_type take()
+	{
+		auto result = storage_type{};
+		std::swap(result, _content);
+		return result;
+	}
+
 private:
 	storage_type _content;
 
@@ -234,13 +334,53 @@ private:
 		storage.erase(std::unique(std::begin(storage), std::end(storage), keys_equal), std::end(storage));
 	}
 
+	/**
+	 * @short Merge items from @p other_begin to @p other_end into this vector, starting from largest ones.
+	 * @pre last std::distance(other_begin, other_end) items of _content are free places
+	 * @pre items from @p other_begin to @p other_end are sorted and unique
+	 *
+	 * Item that was already in this vector is kept on duplicates. Free places left by duplicates are
+	 * removed from beginning of vector at the end.
+	 */
+	template<typename BidirectionalIterator>
+	void merge_backward(BidirectionalIterator other_begin, BidirectionalIterator other_end)
+	{
+		auto content_begin = std::begin(_content);
+		auto write_it = std::end(_content);
+		auto content_it = write_it - std::distance(other_begin, other_end);
+		auto other_it = other_end;
+
+		// write_it is always after content_it while there are items left in other
+		while (content_it != content_begin && other_it != other_begin)
+		{
+			if (compare_keys(*(content_it - 1), *(other_it - 1)))
+				*--write_it = *--other_it;
+			else if (compare_keys(*(other_it - 1), *(content_it - 1)))
+				*--write_it = std::move(*--content_it);
+			else
+			{
+				*--write_it = std::move(*--content_it);
+				--other_it;
+			}
+		}
+
+		while (other_it != other_begin)
+			*--write_it = *--other_it;
+
+		if (write_it != content_it)
+		{
+			write_it = std::move_backward(content_begin, content_it, write_it);
+			_content.erase(content_begin, write_it);
+		}
+	}
+
 };
 
 /**
  * @return begin iterator to content of sorted_unique_vector.
  */
-template<typename K, typename V, K (*KeyExtractor)(const V &)>
-typename sorted_unique_vector<K, V, KeyExtractor>::const_iterator begin(const sorted_unique_vector<K, V, KeyExtractor> &sorted_vector)
+template<typename K, typename V, K (*KeyExtractor)(const V &), typename S>
+typename sorted_unique_vector<K, V, KeyExtractor, S>::const_iterator begin(const sorted_unique_vector<K, V, KeyExtractor, S> &sorted_vector)
 {
 	return std::begin(sorted_vector.content());
 }
@@ -248,30 +388,31 @@ typename sorted_unique_vector<K, V, KeyExtractor>::const_iterator begin(const so
 /**
  * @return end iterator to content of sorted_unique_vector.
  */
-template<typename K, typename V, K (*KeyExtractor)(const V &)>
-typename sorted_unique_vector<K, V, KeyExtractor>::const_iterator end(const sorted_unique_vector<K, V, KeyExtractor> &sorted_vector)
+template<typename K, typename V, K (*KeyExtractor)(const V &), typename S>
+typename sorted_unique_vector<K, V, KeyExtractor, S>::const_iterator end(const sorted_unique_vector<K, V, KeyExtractor, S> &sorted_vector)
 {
 	return std::end(sorted_vector.content());
 }
 
-template<typename K, typename V, K (*KeyExtractor)(const V &)>
-bool operator == (const sorted_unique_vector<K, V, KeyExtractor> &x, const sorted_unique_vector<K, V, KeyExtractor> &y)
+template<typename K, typename V, K (*KeyExtractor)(const V &), typename S>
+bool operator == (const sorted_unique_vector<K, V, KeyExtractor, S> &x, const sorted_unique_vector<K, V, KeyExtractor, S> &y)
 {
 	return x.content() == y.content();
 }
 
-template<typename K, typename V, K (*KeyExtractor)(const V &)>
-bool operator != (const sorted_unique_vector<K, V, KeyExtractor> &x, const sorted_unique_vector<K, V, KeyExtractor> &y)
+template<typename K, typename V, K (*KeyExtractor)(const V &), typename S>
+bool operator != (const sorted_unique_vector<K, V, KeyExtractor, S> &x, const sorted_unique_vector<K, V, KeyExtractor, S> &y)
 {
 	return !(x == y);
 }
 
-template<typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &)>
+template<typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &),
+	typename S1 = std::vector<V1>, typename S2 = std::vector<V2>>
 struct match_result
 {
 	std::vector<std::pair<V1, V2>> matched;
-	sorted_unique_vector<K1, V1, KeyExtractor1> unmatched_1;
-	sorted_unique_vector<K2, V2, KeyExtractor2> unmatched_2;
+	sorted_unique_vector<K1, V1, KeyExtractor1, S1> unmatched_1;
+	sorted_unique_vector<K2, V2, KeyExtractor2, S2> unmatched_2;
 };
 
 enum class match_increment_mode
@@ -280,19 +421,41 @@ enum class match_increment_mode
 	left
 };
 
-template<typename K, typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &)>
-match_result<K1, K2, V1, V2, KeyExtractor1, KeyExtractor2>
-match(
-	const sorted_unique_vector<K1, V1, KeyExtractor1> &suv_1,
-	const sorted_unique_vector<K2, V2, KeyExtractor2> &suv_2,
+/**
+ * @short Callback for match_visit() that ignores its arguments.
+ */
+struct ignore_match
+{
+	template<typename... T>
+	void operator () (const T &...) const {}
+};
+
+/**
+ * @short Match items of two sorted vectors without copying them.
+ * @param suv_1 first vector
+ * @param suv_2 second vector
+ * @param ke1 key extractor used for items of first vector
+ * @param ke2 key extractor used for items of second vector
+ * @param on_matched called with pair of items with equal keys
+ * @param on_unmatched_1 called with each item of first vector without match
+ * @param on_unmatched_2 called with each item of second vector without match
+ * @param increment_mode if match_increment_mode::left then one item of second vector can match many items of first one
+ *
+ * Callbacks are called in order of keys, so items passed to each of them are sorted. Use ignore_match
+ * for results that are not needed.
+ */
+template<typename K, typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &),
+	typename S1, typename S2, typename OnMatched, typename OnUnmatched1, typename OnUnmatched2>
+void match_visit(
+	const sorted_unique_vector<K1, V1, KeyExtractor1, S1> &suv_1,
+	const sorted_unique_vector<K2, V2, KeyExtractor2, S2> &suv_2,
 	K(*ke1)(const V1 &),
 	K(*ke2)(const V2 &),
+	OnMatched on_matched,
+	OnUnmatched1 on_unmatched_1,
+	OnUnmatched2 on_unmatched_2,
 	match_increment_mode increment_mode = match_increment_mode::both)
 {
-	auto unmatched_1 = std::vector<V1>{};
-	auto unmatched_2 = std::vector<V2>{};
-	auto matched = std::vector<std::pair<V1, V2>>{};
-
 	auto suv_1_it = begin(suv_1);
 	auto suv_1_end = end(suv_1);
 	auto suv_2_it = begin(suv_2);
@@ -304,7 +467,7 @@ match(
 		auto suv_2_key = ke2(*suv_2_it);
 		if (suv_1_key == suv_2_key)
 		{
-			matched.emplace_back(*suv_1_it, *suv_2_it);
+			on_matched(*suv_1_it, *suv_2_it);
 			switch (increment_mode)
 			{
 				case match_increment_mode::both:
@@ -318,39 +481,73 @@ match(
 		}
 		else if (suv_1_key < suv_2_key)
 		{
-			unmatched_1.emplace_back(*suv_1_it);
+			on_unmatched_1(*suv_1_it);
 			++suv_1_it;
 		}
 		else if (suv_2_key < suv_1_key)
 		{
-			unmatched_2.emplace_back(*suv_2_it);
+			on_unmatched_2(*suv_2_it);
 			++suv_2_it;
 		}
 	}
 
 	while (suv_1_it != suv_1_end)
 	{
-		unmatched_1.emplace_back(*suv_1_it);
+		on_unmatched_1(*suv_1_it);
 		suv_1_it++;
 	}
 
 	while (suv_2_it != suv_2_end)
 	{
-		unmatched_2.emplace_back(*suv_2_it);
+		on_unmatched_2(*suv_2_it);
 		suv_2_it++;
 	}
+}
+
+template<typename K, typename K1, typename K2, typename V1, typename V2, K1 (*KeyExtractor1)(const V1 &), K2 (*KeyExtractor2)(const V2 &),
+	typename S1, typename S2>
+match_result<K1, K2, V1, V2, KeyExtractor1, KeyExtractor2, S1, S2>
+match(
+	const sorted_unique_vector<K1, V1, KeyExtractor1, S1> &suv_1,
+	const sorted_unique_vector<K2, V2, KeyExtractor2, S2> &suv_2,
+	K(*ke1)(const V1 &),
+	K(*ke2)(const V2 &),
+	match_increment_mode increment_mode = match_increment_mode::both)
+{
+	auto unmatched_1 = S1{};
+	auto unmatched_2 = S2{};
+	auto matched = std::vector<std::pair<V1, V2>>{};
+	matched.reserve(increment_mode == match_increment_mode::left ? suv_1.size() : std::min(suv_1.size(), suv_2.size()));
+
+	match_visit(suv_1, suv_2, ke1, ke2,
+		[&](const V1 &v1, const V2 &v2){ matched.emplace_back(v1, v2); },
+		[&](const V1 &v1){ unmatched_1.emplace_back(v1); },
+		[&](const V2 &v2){ unmatched_2.emplace_back(v2); },
+		increment_mode);
 
 	return
 	{
-		matched,
-		sorted_unique_vector<K1, V1, KeyExtractor1>{unmatched_1},
-		sorted_unique_vector<K2, V2, KeyExtractor2>{unmatched_2}
+		std::move(matched),
+		sorted_unique_vector<K1, V1, KeyExtractor1, S1>{already_sorted_unique, std::move(unmatched_1)},
+		sorted_unique_vector<K2, V2, KeyExtractor2, S2>{already_sorted_unique, std::move(unmatched_2)}
 	};
 }
 
-template<typename K, typename V1, typename V2, K (*KeyExtractor1)(const V1 &), K (*KeyExtractor2)(const V2 &)>
-match_result<K, K, V1, V2, KeyExtractor1, KeyExtractor2>
-match(const sorted_unique_vector<K, V1, KeyExtractor1> &suv_1, const sorted_unique_vector<K, V2, KeyExtractor2> &suv_2)
+template<typename K, typename V1, typename V2, K (*KeyExtractor1)(const V1 &), K (*KeyExtractor2)(const V2 &),
+	typename S1, typename S2, typename OnMatched, typename OnUnmatched1, typename OnUnmatched2>
+void match_visit(
+	const sorted_unique_vector<K, V1, KeyExtractor1, S1> &suv_1,
+	const sorted_unique_vector<K, V2, KeyExtractor2, S2> &suv_2,
+	OnMatched on_matched,
+	OnUnmatched1 on_unmatched_1,
+	OnUnmatched2 on_unmatched_2)
+{
+	match_visit(suv_1, suv_2, KeyExtractor1, KeyExtractor2, std::move(on_matched), std::move(on_unmatched_1), std::move(on_unmatched_2));
+}
+
+template<typename K, typename V1, typename V2, K (*KeyExtractor1)(const V1 &), K (*KeyExtractor2)(const V2 &), typename S1, typename S2>
+match_result<K, K, V1, V2, KeyExtractor1, KeyExtractor2, S1, S2>
+match(const sorted_unique_vector<K, V1, KeyExtractor1, S1> &suv_1, const sorted_unique_vector<K, V2, KeyExtractor2, S2> &suv_2)
 {
 	return match(suv_1, suv_2, KeyExtractor1, KeyExtractor2);
 }
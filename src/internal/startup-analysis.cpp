@@ -0,0 +1,148 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "startup-analysis.h"
+
+#include <algorithm>
+#include <set>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+struct analysis_frame
+{
+	type current;
+	std::vector<type> candidates;
+	std::size_t next_index;
+};
+
+std::vector<type> dependencies_of(const type &t, const std::map<type, std::vector<type>> &dependencies, const std::set<type> &analyzed)
+{
+	auto result = std::vector<type>{};
+	auto dependencies_it = dependencies.find(t);
+	if (dependencies_it != std::end(dependencies))
+		std::copy_if(std::begin(dependencies_it->second), std::end(dependencies_it->second), std::back_inserter(result),
+			[&](const type &d){ return d != t && analyzed.find(d) != std::end(analyzed); });
+	return result;
+}
+
+}
+
+startup_report analyze_startup(const std::vector<type> &implementation_types,
+	const std::map<type, std::vector<type>> &dependencies, const instantiation_profile &profile)
+{
+	auto analyzed = std::set<type>{std::begin(implementation_types), std::end(implementation_types)};
+
+	// topological order (dependencies first) with depth-first search, back edges are ignored
+	auto order = std::vector<type>{};
+	auto edges = std::map<type, std::vector<type>>{};
+	auto state = std::map<type, int>{}; // 1 - on stack, 2 - done
+	for (auto &&root : implementation_types)
+	{
+		if (state[root] != 0)
+			continue;
+
+		// candidates of each type are computed once, when it is pushed
+		auto stack = std::vector<analysis_frame>{};
+		stack.push_back(analysis_frame{root, dependencies_of(root, dependencies, analyzed), 0});
+		state[root] = 1;
+		edges[root];
+
+		while (!stack.empty())
+		{
+			auto &frame = stack.back();
+			if (frame.next_index == frame.candidates.size())
+			{
+				state[frame.current] = 2;
+				order.push_back(frame.current);
+				stack.pop_back();
+				continue;
+			}
+
+			auto current = frame.current;
+			auto candidate = frame.candidates[frame.next_index++];
+			if (state[candidate] == 1)
+				continue; // closes a cycle
+
+			edges[current].push_back(candidate);
+			if (state[candidate] == 0)
+			{
+				state[candidate] = 1;
+				edges[candidate];
+				stack.push_back(analysis_frame{candidate, dependencies_of(candidate, dependencies, analyzed), 0});
+			}
+		}
+	}
+
+	auto cost = std::map<type, qint64>{};
+	for (auto &&t : implementation_types)
+		cost[t] = profile.cost_of(t.name());
+
+	auto earliest_finish = std::map<type, qint64>{};
+	for (auto &&t : order)
+	{
+		auto start = qint64{0};
+		for (auto &&d : edges[t])
+			start = std::max(start, earliest_finish[d]);
+		earliest_finish[t] = start + cost[t];
+	}
+
+	auto result = startup_report{};
+	result.critical_path_ns = 0;
+	result.total_ns = 0;
+	for (auto &&t : implementation_types)
+	{
+		result.critical_path_ns = std::max(result.critical_path_ns, earliest_finish[t]);
+		result.total_ns += cost[t];
+	}
+
+	// latest finish: type must be ready before latest start of each of its dependents
+	auto latest_finish = std::map<type, qint64>{};
+	for (auto &&t : implementation_types)
+		latest_finish[t] = result.critical_path_ns;
+	for (auto i = order.rbegin(), e = order.rend(); i != e; ++i)
+		for (auto &&d : edges[*i])
+			latest_finish[d] = std::min(latest_finish[d], latest_finish[*i] - cost[*i]);
+
+	for (auto &&t : implementation_types)
+		result.types.push_back(startup_report_entry{t.name(), cost[t], earliest_finish[t], latest_finish[t] - earliest_finish[t]});
+
+	if (!implementation_types.empty())
+	{
+		auto last = *std::max_element(std::begin(implementation_types), std::end(implementation_types),
+			[&](const type &x, const type &y){ return earliest_finish[x] < earliest_finish[y]; });
+		auto path = std::vector<std::string>{};
+		while (true)
+		{
+			path.push_back(last.name());
+			auto &last_edges = edges[last];
+			if (last_edges.empty())
+				break;
+			last = *std::max_element(std::begin(last_edges), std::end(last_edges),
+				[&](const type &x, const type &y){ return earliest_finish[x] < earliest_finish[y]; });
+		}
+		result.critical_path.assign(path.rbegin(), path.rend());
+	}
+
+	return result;
+}
+
+}}
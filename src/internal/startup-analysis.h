@@ -0,0 +1,53 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/startup-report.h>
+#include <injeqt/type.h>
+
+#include "instantiation-profile.h"
+#include "internal.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for analysis of startup critical path.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Compute critical path, slack and bounds of startup.
+ * @param implementation_types analyzed types, in order of report
+ * @param dependencies types required by each type to be ready before it, types not in @p implementation_types are ignored
+ * @param profile source of costs of types
+ *
+ * Earliest finish of type is its cost plus maximum earliest finish of its dependencies. Latest finish is
+ * computed backwards from types nothing depends on, which must finish at critical path length. Slack is
+ * the difference of both. Cyclic dependencies are broken on first edge that closes a cycle.
+ */
+INJEQT_INTERNAL_API startup_report analyze_startup(const std::vector<type> &implementation_types,
+	const std::map<type, std::vector<type>> &dependencies, const instantiation_profile &profile);
+
+}}
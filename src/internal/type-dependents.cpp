@@ -0,0 +1,118 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "type-dependents.h"
+
+#include "interfaces-utils.h"
+#include "types-model.h"
+
+#include <algorithm>
+#include <set>
+
+namespace injeqt { namespace internal {
+
+void add_type_dependents(type_dependents &index, const types_dependencies &dependencies)
+{
+	for (auto &&type_dependencies : dependencies)
+		for (auto &&dependency : type_dependencies.dependency_list())
+			add_type_dependent(index, dependency.required_type(), type_dependencies.dependent_type());
+}
+
+void add_type_dependent(type_dependents &index, const type &required_type, const type &dependent_type)
+{
+	auto &dependents = index[required_type];
+	if (std::find(std::begin(dependents), std::end(dependents), dependent_type) == std::end(dependents))
+		dependents.push_back(dependent_type);
+}
+
+void remove_type_dependent(type_dependents &index, const type &required_type, const type &dependent_type)
+{
+	auto dependents_it = index.find(required_type);
+	if (dependents_it == std::end(index))
+		return;
+
+	auto &dependents = dependents_it->second;
+	dependents.erase(std::remove(std::begin(dependents), std::end(dependents), dependent_type), std::end(dependents));
+	if (dependents.empty())
+		index.erase(dependents_it);
+}
+
+void remove_type_dependents(type_dependents &index, const type_dependencies &dependencies)
+{
+	for (auto &&dependency : dependencies.dependency_list())
+		remove_type_dependent(index, dependency.required_type(), dependencies.dependent_type());
+}
+
+namespace {
+
+std::vector<type> direct_dependents(const type_dependents &index, const types_model &model, const type &changed_type)
+{
+	auto result = std::vector<type>{};
+	for (auto &&interface_type : extract_interfaces(changed_type))
+	{
+		auto dependents_it = index.find(interface_type);
+		if (dependents_it == std::end(index))
+			continue;
+
+		for (auto &&dependent_type : dependents_it->second)
+			for (auto &&implementation_type : model.all_implementations_of(dependent_type))
+				result.push_back(implementation_type);
+	}
+	return result;
+}
+
+}
+
+std::vector<type> transitive_dependents(const type_dependents &index, const types_model &model, const std::vector<type> &changed_types)
+{
+	// depth-first search with explicit stack; type is added to result after all of its dependents,
+	// so reversed result lists each type before types that depend on it
+	auto result = std::vector<type>{};
+	auto found = std::set<type>{};
+	auto stack = std::vector<std::pair<type, std::vector<type>>>{};
+
+	for (auto i = changed_types.rbegin(), e = changed_types.rend(); i != e; ++i)
+	{
+		if (!found.insert(*i).second)
+			continue;
+
+		stack.emplace_back(*i, direct_dependents(index, model, *i));
+		while (!stack.empty())
+		{
+			auto &pending = stack.back().second;
+			if (pending.empty())
+			{
+				result.push_back(stack.back().first);
+				stack.pop_back();
+				continue;
+			}
+
+			auto dependent_type = pending.back();
+			pending.pop_back();
+			if (found.insert(dependent_type).second)
+				stack.emplace_back(dependent_type, direct_dependents(index, model, dependent_type));
+		}
+	}
+
+	std::reverse(std::begin(result), std::end(result));
+	return result;
+}
+
+}}
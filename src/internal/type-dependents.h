@@ -0,0 +1,87 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+#include "types-dependencies.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains classes and functions for representing reverse dependency index.
+ */
+
+namespace injeqt { namespace internal {
+
+class types_model;
+
+/**
+ * @brief Reverse dependency index - maps required interface type to all types that depend on it.
+ *
+ * Dependent types are stored as keys of types_dependencies, so these can be supertypes of configured
+ * types. Use types_model::all_implementations_of(const type &) to get configured types from them.
+ * Types that require other types to be instantiated before them (like types created by factories)
+ * are also stored in this index.
+ */
+using type_dependents = std::map<type, std::vector<type>>;
+
+/**
+ * @brief Add all dependencies from @p dependencies to @p index.
+ */
+INJEQT_INTERNAL_API void add_type_dependents(type_dependents &index, const types_dependencies &dependencies);
+
+/**
+ * @brief Add single @p dependent_type of @p required_type to @p index.
+ */
+INJEQT_INTERNAL_API void add_type_dependent(type_dependents &index, const type &required_type, const type &dependent_type);
+
+/**
+ * @brief Remove single @p dependent_type of @p required_type from @p index.
+ */
+INJEQT_INTERNAL_API void remove_type_dependent(type_dependents &index, const type &required_type, const type &dependent_type);
+
+/**
+ * @brief Remove dependent type of @p dependencies from index.
+ * @param index index to remove from
+ * @param dependencies dependencies of type to remove, used to find entries to remove
+ */
+INJEQT_INTERNAL_API void remove_type_dependents(type_dependents &index, const type_dependencies &dependencies);
+
+/**
+ * @brief Find all configured types that transitively depend on @p changed_types.
+ * @param index reverse dependency index
+ * @param model model used to map dependent types to configured types
+ * @param changed_types configured types to start from
+ * @return @p changed_types and all theirs transitive dependents in topological order
+ *
+ * Each type is listed before all types that depend on it, so reversed result can be used to finish
+ * dependents before theirs dependencies. Order of types in dependency cycle is unspecified.
+ *
+ * Cost of this function is proportional to size of found subgraph, not to size of whole index.
+ */
+INJEQT_INTERNAL_API std::vector<type> transitive_dependents(const type_dependents &index, const types_model &model, const std::vector<type> &changed_types);
+
+}}
@@ -22,6 +22,7 @@
 
 #include <injeqt/exception/ambiguous-types.h>
 
+#include "containers.h"
 #include "interfaces-utils.h"
 
 #include <map>
@@ -32,9 +33,10 @@ type_relations::type_relations()
 {
 }
 
-type_relations::type_relations(implemented_by_mapping unique, types ambiguous) :
+type_relations::type_relations(implemented_by_mapping unique, types ambiguous, implemented_by_all_mapping all) :
 	_unique{std::move(unique)},
-	_ambiguous{std::move(ambiguous)}
+	_ambiguous{std::move(ambiguous)},
+	_all{std::move(all)}
 {
 }
 
@@ -48,30 +50,35 @@ const types & type_relations::ambiguous() const
 	return _ambiguous;
 }
 
+const implemented_by_all_mapping & type_relations::all() const
+{
+	return _all;
+}
+
 type_relations make_type_relations(const std::vector<type> &main_types)
 {
-	auto type_count = std::map<type, std::size_t>{};
-	auto implemented_by_type = std::map<type, type>{};
+	// reflection is done in parallel, merge is done in order of main_types
+	auto all_interface_types = parallel_transform(main_types, extract_interfaces);
 
-	for (auto &&main_type : main_types)
-	{
-		auto interface_types = extract_interfaces(main_type);
-		for (auto &&interface_type : interface_types)
-		{
-			type_count[interface_type]++;
-			implemented_by_type.insert({interface_type, main_type});
-		}
-	}
+	auto implemented_by_types = std::map<type, std::vector<type>>{};
+	for (auto i = std::size_t{0}; i < main_types.size(); i++)
+		for (auto &&interface_type : all_interface_types[i])
+			implemented_by_types[interface_type].push_back(main_types[i]);
 
 	auto unique = std::vector<implemented_by>{};
 	auto ambiguous = std::vector<type>{};
-	for (auto &&counted_type : type_count)
-		if (counted_type.second == 1)
-			unique.push_back(implemented_by{counted_type.first, implemented_by_type.at(counted_type.first)});
-		else if (counted_type.second > 1)
-			ambiguous.push_back(counted_type.first);
+	auto all = std::vector<implemented_by_all>{};
+	for (auto &&implemented_by_type : implemented_by_types)
+	{
+		// the same type configured twice is also ambiguous, so count before removing duplicates
+		if (implemented_by_type.second.size() == 1)
+			unique.push_back(implemented_by{implemented_by_type.first, implemented_by_type.second.front()});
+		else
+			ambiguous.push_back(implemented_by_type.first);
+		all.push_back(implemented_by_all{implemented_by_type.first, types{implemented_by_type.second}});
+	}
 
-	return type_relations{implemented_by_mapping{unique}, types{ambiguous}};
+	return type_relations{implemented_by_mapping{unique}, types{ambiguous}, implemented_by_all_mapping{all}};
 }
 
 void validate_non_ambiguous(const std::vector<type> &types, const type_relations &relations)
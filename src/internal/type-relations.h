@@ -22,6 +22,7 @@
 
 #include <injeqt/injeqt.h>
 
+#include "implemented-by-all-mapping.h"
 #include "implemented-by-mapping.h"
 #include "internal.h"
 #include "types.h"
@@ -58,11 +59,12 @@ public:
 	 * @brief Create new type_relations object.
 	 * @param unique unique mappings
 	 * @param ambiguous set of ambiguous types
+	 * @param all mappings of all types to all of theirs implementations
 	 *
 	 * This constructor does not check for validity of data. Use make_type_relations(const std::vector<type> &)
 	 * factory function to ensure that data is valid.
 	 */
-	explicit type_relations(implemented_by_mapping unique, types ambiguous);
+	explicit type_relations(implemented_by_mapping unique, types ambiguous, implemented_by_all_mapping all = implemented_by_all_mapping{});
 
 	/**
 	 * @return mappings of unique types.
@@ -74,9 +76,15 @@ public:
 	 */
 	const types & ambiguous() const;
 
+	/**
+	 * @return mappings of all types (unique and ambiguous) to all of theirs implementations.
+	 */
+	const implemented_by_all_mapping & all() const;
+
 private:
 	implemented_by_mapping _unique;
 	types _ambiguous;
+	implemented_by_all_mapping _all;
 
 };
 
@@ -88,7 +96,8 @@ private:
  * base types between T (including) and QObject (excluding). All types that are unique in set
  * are added to unique() set of result object as implemented_by object with interface_type set
  * to this base type and implementation_type set to T. All non unique types are added to
- * ambiguous() set of result object.
+ * ambiguous() set of result object. Each type, unique or not, is also added to all() set with
+ * list of all types from main_types that implement it.
  */
 INJEQT_INTERNAL_API type_relations make_type_relations(const std::vector<type> &main_types);
 
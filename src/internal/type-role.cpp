@@ -22,6 +22,9 @@
 
 #include <QtCore/QMetaClassInfo>
 #include <QtCore/QMetaObject>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 namespace injeqt { namespace internal {
 
@@ -32,13 +35,30 @@ bool has_type_role(type for_type, const std::string &role)
 	for (decltype(class_info_count) i = 0; i < class_info_count; i++)
 	{
 		auto class_info = meta_object->classInfo(i);
-		auto name = std::string{class_info.name()};
-		auto value = std::string{class_info.value()};
-		if (name == INJEQT_TYPE_ROLE_CLASSINFO_NAME && value == role)
+		if (std::strcmp(class_info.name(), INJEQT_TYPE_ROLE_CLASSINFO_NAME) == 0 && role == class_info.value())
 			return true;
 	}
 
 	return false;
 }
 
+std::vector<std::string> extract_type_roles(const type &for_type)
+{
+	assert(!for_type.is_empty());
+
+	auto result = std::vector<std::string>{};
+	auto meta_object = for_type.meta_object();
+	auto class_info_count = meta_object->classInfoCount();
+	for (decltype(class_info_count) i = 0; i < class_info_count; i++)
+	{
+		auto class_info = meta_object->classInfo(i);
+		if (std::strcmp(class_info.name(), INJEQT_TYPE_ROLE_CLASSINFO_NAME) == 0)
+			result.emplace_back(class_info.value());
+	}
+
+	std::sort(std::begin(result), std::end(result));
+	result.erase(std::unique(std::begin(result), std::end(result)), std::end(result));
+	return result;
+}
+
 }}
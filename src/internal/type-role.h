@@ -25,15 +25,30 @@
 #include "internal.h"
 
 #include <string>
+#include <vector>
 
 namespace injeqt { namespace internal {
 
 INJEQT_INTERNAL_API bool has_type_role(type for_type, const std::string &role);
 
+/**
+ * @return list of all roles declared with INJEQT_TYPE_ROLE in @p for_type and its supertypes
+ * @pre !for_type.is_empty()
+ *
+ * Each role is returned only once, even if declared many times.
+ */
+INJEQT_INTERNAL_API std::vector<std::string> extract_type_roles(const type &for_type);
+
 template<typename T>
 inline bool has_type_role(const std::string &role)
 {
 	return has_type_role(make_type<T>(), role);
 }
 
+template<typename T>
+inline std::vector<std::string> extract_type_roles()
+{
+	return extract_type_roles(make_type<T>());
+}
+
 }}
@@ -36,4 +36,16 @@ type type_by_pointer(const types_by_name &known_types, const std::string &pointe
 		return *item;
 }
 
+type type_by_pointer_list(const types_by_name &known_types, const std::string &list_name)
+{
+	auto prefix = std::string{"QList<"};
+	if (list_name.length() < prefix.length() + 1)
+		return type{};
+	if (list_name.compare(0, prefix.length(), prefix) != 0)
+		return type{};
+	if (list_name[list_name.length() - 1] != '>')
+		return type{};
+	return type_by_pointer(known_types, list_name.substr(prefix.length(), list_name.length() - prefix.length() - 1));
+}
+
 }}
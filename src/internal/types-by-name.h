@@ -25,6 +25,7 @@
 
 #include "internal.h"
 
+#include "frozen-sorted-vector.h"
 #include "sorted-unique-vector.h"
 
 namespace injeqt { namespace internal {
@@ -34,8 +35,21 @@ inline std::string name_from_type(const type &t)
 	return t.name();
 }
 
-using types_by_name = sorted_unique_vector<std::string, type, name_from_type>;
+/**
+ * @brief Sorted list of types that can be modified, used to build types_by_name.
+ */
+using sorted_types_by_name = sorted_unique_vector<std::string, type, name_from_type>;
+
+/**
+ * @brief Read-only list of all known types, indexed by name.
+ */
+using types_by_name = frozen_sorted_vector<sorted_types_by_name>;
 
 INJEQT_INTERNAL_API type type_by_pointer(const types_by_name &known_types, const std::string &pointer_name);
 
+/**
+ * @return type of items of list of pointers with name @p list_name (like QList<T*>) or empty type
+ */
+INJEQT_INTERNAL_API type type_by_pointer_list(const types_by_name &known_types, const std::string &list_name);
+
 }}
@@ -0,0 +1,276 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "types-model-cache.h"
+
+#include "interfaces-utils.h"
+#include "setter-method.h"
+
+#include <injeqt/exception/invalid-setter.h>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QMetaMethod>
+#include <QtCore/QMetaObject>
+#include <map>
+
+namespace injeqt { namespace internal {
+
+namespace {
+
+const quint32 cache_magic = 0x494a514d;
+const quint32 cache_version = 1;
+
+class type_indexes
+{
+
+public:
+	quint32 index_of(const type &t)
+	{
+		auto index_it = _indexes.find(t);
+		if (index_it != std::end(_indexes))
+			return index_it->second;
+
+		auto result = static_cast<quint32>(_types.size());
+		_indexes.insert(std::make_pair(t, result));
+		_types.push_back(t);
+		return result;
+	}
+
+	const std::vector<type> & all() const
+	{
+		return _types;
+	}
+
+private:
+	std::map<type, quint32> _indexes;
+	std::vector<type> _types;
+
+};
+
+bool is_setter(const QMetaMethod &meta_method)
+{
+	return setter_method::is_setter_tag(meta_method.tag()) || setter_method::is_setter_all_tag(meta_method.tag());
+}
+
+int setters_count(const QMetaObject *meta_object)
+{
+	auto result = 0;
+	auto method_count = meta_object->methodCount();
+	for (decltype(method_count) i = 0; i < method_count; i++)
+		if (is_setter(meta_object->method(i)))
+			result++;
+	return result;
+}
+
+bool is_cached_setter(const type &required_type, const QMetaMethod &meta_method)
+{
+	try
+	{
+		return setter_method::validate_setter_method(required_type, meta_method);
+	}
+	catch (exception::invalid_setter &)
+	{
+		return false;
+	}
+}
+
+}
+
+QByteArray make_types_model_cache_key(const std::vector<type> &all_types, const std::vector<type> &need_dependencies)
+{
+	auto hash = QCryptographicHash{QCryptographicHash::Sha1};
+	hash.addData(QByteArray::number(QT_VERSION));
+	hash.addData(QByteArray::number(cache_version));
+	// only setters are hashed with theirs signatures, adding a tag to existing slot changes key as well
+	for (auto &&t : all_types)
+		for (auto meta_object = t.meta_object(); meta_object; meta_object = meta_object->superClass())
+		{
+			hash.addData(meta_object->className(), static_cast<int>(qstrlen(meta_object->className()) + 1));
+			hash.addData(QByteArray::number(meta_object->methodCount()));
+			for (auto i = meta_object->methodOffset(); i < meta_object->methodCount(); i++)
+			{
+				auto meta_method = meta_object->method(i);
+				if (!is_setter(meta_method))
+					continue;
+				hash.addData(QByteArray::number(i));
+				hash.addData(meta_method.tag(), static_cast<int>(qstrlen(meta_method.tag()) + 1));
+				hash.addData(meta_method.methodSignature());
+			}
+		}
+	hash.addData("need_dependencies", 18);
+	for (auto &&t : need_dependencies)
+		hash.addData(t.name().data(), static_cast<int>(t.name().size() + 1));
+	return hash.result();
+}
+
+QByteArray write_types_model_cache(const types_model &model, const QByteArray &key)
+{
+	auto indexes = type_indexes{};
+	auto body = QByteArray{};
+	{
+		QDataStream stream{&body, QIODevice::WriteOnly};
+		stream.setVersion(QDataStream::Qt_5_0);
+
+		stream << static_cast<quint32>(model.available_types().size());
+		for (auto &&ib : model.available_types())
+			stream << indexes.index_of(ib.interface_type()) << indexes.index_of(ib.implementation_type());
+
+		stream << static_cast<quint32>(model.all_implementations().size());
+		for (auto &&iba : model.all_implementations())
+		{
+			stream << indexes.index_of(iba.interface_type()) << static_cast<quint32>(iba.implementation_types().size());
+			for (auto &&implementation_type : iba.implementation_types())
+				stream << indexes.index_of(implementation_type);
+		}
+
+		stream << static_cast<quint32>(model.mapped_dependencies().size());
+		for (auto &&td : model.mapped_dependencies())
+		{
+			stream << indexes.index_of(td.dependent_type()) << static_cast<quint32>(td.dependency_list().size());
+			for (auto &&d : td.dependency_list())
+				stream << indexes.index_of(d.required_type()) << static_cast<qint32>(d.setter().meta_method().methodIndex());
+		}
+	}
+
+	auto result = QByteArray{};
+	QDataStream stream{&result, QIODevice::WriteOnly};
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << cache_magic << cache_version << key;
+	stream << static_cast<quint32>(indexes.all().size());
+	for (auto &&t : indexes.all())
+		stream << QByteArray{t.name().data()};
+	stream << body;
+	return result;
+}
+
+types_model read_types_model_cache(const char *data, qint64 size, const QByteArray &key, const types_by_name &known_types)
+{
+	// no copy of data is made, but all of it is deserialized into new model
+	auto raw = QByteArray::fromRawData(data, static_cast<int>(size));
+	QDataStream stream{raw};
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	auto magic = quint32{};
+	auto version = quint32{};
+	auto stored_key = QByteArray{};
+	stream >> magic >> version >> stored_key;
+	if (stream.status() != QDataStream::Ok || magic != cache_magic || version != cache_version || stored_key != key)
+		return types_model{};
+
+	auto types_count = quint32{};
+	stream >> types_count;
+	auto all_types = std::vector<type>{};
+	for (auto i = quint32{0}; i < types_count && stream.status() == QDataStream::Ok; i++)
+	{
+		auto name = QByteArray{};
+		stream >> name;
+		auto type_it = known_types.get(std::string{name.constData(), static_cast<std::string::size_type>(name.size())});
+		if (type_it == std::end(known_types))
+			return types_model{};
+		all_types.push_back(*type_it);
+	}
+
+	// size of serialized body, body itself follows up to end of data
+	auto body_size = quint32{};
+	stream >> body_size;
+	if (stream.status() != QDataStream::Ok || static_cast<qint64>(body_size) != size - stream.device()->pos())
+		return types_model{};
+
+	auto ok = true;
+	auto read_type = [&]() -> type {
+		auto index = quint32{};
+		stream >> index;
+		if (stream.status() != QDataStream::Ok || index >= all_types.size())
+		{
+			ok = false;
+			return type{};
+		}
+		return all_types[index];
+	};
+
+	auto count = quint32{};
+	stream >> count;
+	auto unique = std::vector<implemented_by>{};
+	for (auto i = quint32{0}; i < count && ok; i++)
+	{
+		auto interface_type = read_type();
+		auto implementation_type = read_type();
+		if (!ok || !implements(implementation_type, interface_type))
+			return types_model{};
+		unique.push_back(implemented_by{interface_type, implementation_type});
+	}
+
+	stream >> count;
+	auto all = std::vector<implemented_by_all>{};
+	for (auto i = quint32{0}; i < count && ok; i++)
+	{
+		auto interface_type = read_type();
+		auto implementations_count = quint32{};
+		stream >> implementations_count;
+		if (!ok || stream.status() != QDataStream::Ok)
+			return types_model{};
+		auto implementation_types = std::vector<type>{};
+		for (auto j = quint32{0}; j < implementations_count; j++)
+		{
+			auto implementation_type = read_type();
+			if (!ok || !implements(implementation_type, interface_type))
+				return types_model{};
+			implementation_types.push_back(implementation_type);
+		}
+		all.push_back(implemented_by_all{interface_type, types{implementation_types}});
+	}
+
+	stream >> count;
+	auto all_dependencies = std::vector<type_dependencies>{};
+	for (auto i = quint32{0}; i < count && ok; i++)
+	{
+		auto dependent_type = read_type();
+		auto dependencies_count = quint32{};
+		stream >> dependencies_count;
+		if (!ok || stream.status() != QDataStream::Ok)
+			return types_model{};
+		auto dependency_list = std::vector<dependency>{};
+		for (auto j = quint32{0}; j < dependencies_count; j++)
+		{
+			auto required_type = read_type();
+			auto method_index = qint32{};
+			stream >> method_index;
+			if (!ok || stream.status() != QDataStream::Ok || method_index < 0 || method_index >= dependent_type.meta_object()->methodCount())
+				return types_model{};
+			auto meta_method = dependent_type.meta_object()->method(method_index);
+			if (!is_cached_setter(required_type, meta_method))
+				return types_model{};
+			dependency_list.push_back(dependency{setter_method{required_type, meta_method}});
+		}
+		// setter not in cache means that stale cache was read with matching key
+		auto unique_dependencies = dependencies{dependency_list};
+		if (static_cast<int>(unique_dependencies.size()) != setters_count(dependent_type.meta_object()))
+			return types_model{};
+		all_dependencies.push_back(type_dependencies{dependent_type, std::move(unique_dependencies)});
+	}
+
+	if (stream.status() != QDataStream::Ok || !stream.atEnd())
+		return types_model{};
+
+	return types_model{implemented_by_mapping{unique}, types_dependencies{all_dependencies}, implemented_by_all_mapping{all}};
+}
+
+}}
@@ -0,0 +1,77 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <injeqt/injeqt.h>
+#include <injeqt/type.h>
+
+#include "internal.h"
+#include "types-by-name.h"
+#include "types-model.h"
+
+#include <vector>
+#include <QtCore/QByteArray>
+
+/**
+ * @file
+ * @brief Contains functions for storing validated types_model in binary cache.
+ */
+
+namespace injeqt { namespace internal {
+
+/**
+ * @brief Create key of types model cache for given configuration.
+ * @param all_types set of types model is made from
+ * @param need_dependencies list of types that have dependencies extracted
+ * @return SHA1 hash of names, superclasses, method counts and setters of all types
+ *
+ * Key changes when any type is added, removed, or gets other superclasses, number of methods or
+ * setters. Only tags and signatures of methods tagged with INJEQT_SET or INJEQT_SET_ALL are hashed,
+ * other methods are only counted. Setters of model read with this key are checked against meta objects
+ * by read_types_model_cache() as well.
+ */
+INJEQT_INTERNAL_API QByteArray make_types_model_cache_key(const std::vector<type> &all_types, const std::vector<type> &need_dependencies);
+
+/**
+ * @brief Serialize @p model into compact binary form.
+ * @param model validated model to serialize
+ * @param key key of configuration @p model was made from
+ *
+ * Types are stored as indexes into table of names and setters as method indexes of theirs meta objects.
+ */
+INJEQT_INTERNAL_API QByteArray write_types_model_cache(const types_model &model, const QByteArray &key);
+
+/**
+ * @brief Read types_model from data created by write_types_model_cache().
+ * @param data pointer to serialized data, for example memory mapped file; it is not copied, but
+ *        whole model is deserialized from it
+ * @param size size of @p data
+ * @param key expected key of configuration
+ * @param known_types list of all known types
+ * @return read model or empty model if data is invalid, has different key or refers to unknown types
+ *
+ * Returned model is not validated again. Only methods stored as setters are looked up by index and
+ * checked to still be valid setters of stored types. Data is rejected if any type with stored
+ * dependencies has a setter that was not stored. Corrupted or stale data never creates partial model.
+ */
+INJEQT_INTERNAL_API types_model read_types_model_cache(const char *data, qint64 size, const QByteArray &key, const types_by_name &known_types);
+
+}}
@@ -23,43 +23,103 @@
 #include <injeqt/exception/ambiguous-types.h>
 #include <injeqt/exception/unresolvable-dependencies.h>
 
+#include "containers.h"
+#include "interfaces-utils.h"
 #include "type-relations.h"
 
+#include <algorithm>
 #include <cassert>
+#include <map>
 
 namespace injeqt { namespace internal {
 
-types_model::types_model()
+namespace {
+
+template<typename T>
+std::shared_ptr<const frozen_sorted_vector<T>> freeze(T &&table)
+{
+	// model is never modified after construction
+	return std::make_shared<const frozen_sorted_vector<T>>(std::move(table));
+}
+
+}
+
+types_model::types_model() :
+	types_model{implemented_by_mapping{}, types_dependencies{}, implemented_by_all_mapping{}}
+{
+}
+
+types_model::types_model(implemented_by_mapping available_types, types_dependencies mapped_dependencies, implemented_by_all_mapping all_implementations) :
+	types_model{freeze(std::move(available_types)), freeze(std::move(mapped_dependencies)), freeze(std::move(all_implementations))}
 {
 }
 
-types_model::types_model(implemented_by_mapping available_types, types_dependencies mapped_dependencies) :
+types_model::types_model(std::shared_ptr<const frozen_implemented_by_mapping> available_types, std::shared_ptr<const frozen_types_dependencies> mapped_dependencies,
+	std::shared_ptr<const frozen_implemented_by_all_mapping> all_implementations) :
 	_available_types{std::move(available_types)},
-	_mapped_dependencies{std::move(mapped_dependencies)}
+	_mapped_dependencies{std::move(mapped_dependencies)},
+	_all_implementations{std::move(all_implementations)},
+	_graph{std::make_shared<const dependency_graph>(*_available_types, *_mapped_dependencies, *_all_implementations)}
+{
+	assert(_available_types && _mapped_dependencies && _all_implementations);
+}
+
+types_model::types_model(std::shared_ptr<const frozen_implemented_by_mapping> available_types, std::shared_ptr<const frozen_types_dependencies> mapped_dependencies,
+	std::shared_ptr<const frozen_implemented_by_all_mapping> all_implementations, std::shared_ptr<const dependency_graph> graph) :
+	_available_types{std::move(available_types)},
+	_mapped_dependencies{std::move(mapped_dependencies)},
+	_all_implementations{std::move(all_implementations)},
+	_graph{std::move(graph)}
+{
+	assert(_available_types && _mapped_dependencies && _all_implementations && _graph);
+}
+
+const frozen_implemented_by_mapping & types_model::available_types() const
+{
+	return *_available_types;
+}
+
+const frozen_types_dependencies & types_model::mapped_dependencies() const
 {
+	return *_mapped_dependencies;
 }
 
-const implemented_by_mapping & types_model::available_types() const
+const frozen_implemented_by_all_mapping & types_model::all_implementations() const
 {
-	return _available_types;
+	return *_all_implementations;
 }
 
-const types_dependencies & types_model::mapped_dependencies() const
+const dependency_graph & types_model::graph() const
 {
-	return _mapped_dependencies;
+	return *_graph;
+}
+
+const types & types_model::all_implementations_of(const type &interface_type) const
+{
+	static const auto no_implementations = types{};
+
+	auto all_implementations_it = _all_implementations->get(interface_type);
+	return all_implementations_it != end(*_all_implementations)
+		? all_implementations_it->implementation_types()
+		: no_implementations;
 }
 
 bool types_model::contains(const type &interface_type) const
 {
-	return _available_types.get(interface_type) != end(_available_types);
+	return _available_types->get(interface_type) != end(*_available_types);
 }
 
 std::vector<dependency> types_model::get_unresolvable_dependencies() const
+{
+	return get_unresolvable_dependencies(*_mapped_dependencies);
+}
+
+std::vector<dependency> types_model::get_unresolvable_dependencies(const types_dependencies &to_check) const
 {
 	auto result = std::vector<dependency>{};
-	for (auto &&mapped_type_dependency : _mapped_dependencies)
+	for (auto &&mapped_type_dependency : to_check)
 		for (auto &&dependency : mapped_type_dependency.dependency_list())
-			if (!contains(dependency.required_type()))
+			if (!dependency.setter().is_all() && !contains(dependency.required_type()))
 				result.push_back(dependency);
 	return result;
 }
@@ -69,21 +129,150 @@ types_model make_types_model(const types_by_name &known_types, const std::vector
 	auto relations = make_type_relations(all_types);
 	validate_non_ambiguous(all_types, relations);
 
-	auto all_dependencies = std::vector<type_dependencies>{};
-	std::transform(std::begin(need_dependencies), std::end(need_dependencies), std::back_inserter(all_dependencies),
+	auto all_dependencies = parallel_transform(need_dependencies,
 		[&](const type &t){ return make_type_dependencies(known_types, t); });
 
 	auto available_types = relations.unique();
 	auto mapped_dependencies = types_dependencies{all_dependencies};
-	auto result = types_model(available_types, mapped_dependencies);
+	auto result = types_model(available_types, mapped_dependencies, relations.all());
 	validate_non_unresolvable(result);
 
 	return result;
 }
 
+types_model extend_types_model(const types_model &base, const types_by_name &known_types,
+	const std::vector<type> &new_types, const std::vector<type> &need_dependencies)
+{
+	auto implemented_by_types = std::map<type, std::vector<type>>{};
+	for (auto &&new_type : new_types)
+		for (auto &&interface_type : extract_interfaces(new_type))
+		{
+			auto &implementation_types = implemented_by_types[interface_type];
+			if (implementation_types.empty())
+			{
+				auto &base_implementation_types = base.all_implementations_of(interface_type);
+				implementation_types.assign(std::begin(base_implementation_types), std::end(base_implementation_types));
+			}
+			implementation_types.push_back(new_type);
+		}
+
+	auto unique = std::vector<implemented_by>{};
+	auto ambiguous = std::vector<type>{};
+	auto all = std::vector<implemented_by_all>{};
+	for (auto &&implemented_by_type : implemented_by_types)
+	{
+		if (implemented_by_type.second.size() == 1)
+			unique.push_back(implemented_by{implemented_by_type.first, implemented_by_type.second.front()});
+		else
+		{
+			// configured type can not be ambiguous, just like in make_types_model
+			if (std::find(std::begin(implemented_by_type.second), std::end(implemented_by_type.second), implemented_by_type.first) != std::end(implemented_by_type.second))
+				throw exception::ambiguous_types{implemented_by_type.first.name()};
+			if (base.contains(implemented_by_type.first))
+				ambiguous.push_back(implemented_by_type.first);
+		}
+		all.push_back(implemented_by_all{implemented_by_type.first, types{implemented_by_type.second}});
+	}
+
+	auto available_types = implemented_by_mapping{unique};
+	if (ambiguous.empty())
+		available_types.merge(base.available_types());
+	else
+	{
+		auto still_available = std::vector<implemented_by>{};
+		std::copy_if(std::begin(base.available_types()), std::end(base.available_types()), std::back_inserter(still_available),
+			[&](const implemented_by &ib){ return std::find(std::begin(ambiguous), std::end(ambiguous), ib.interface_type()) == std::end(ambiguous); });
+		available_types.merge(implemented_by_mapping{still_available});
+	}
+
+	auto all_implementations = implemented_by_all_mapping{all};
+	all_implementations.merge(base.all_implementations());
+
+	auto new_dependencies = parallel_transform(need_dependencies,
+		[&](const type &t){ return make_type_dependencies(known_types, t); });
+	auto added_dependencies = types_dependencies{new_dependencies};
+
+	auto mapped_dependencies = std::shared_ptr<const frozen_types_dependencies>{};
+	if (added_dependencies.empty())
+		mapped_dependencies = base._mapped_dependencies;
+	else
+	{
+		auto merged_dependencies = added_dependencies;
+		merged_dependencies.merge(base.mapped_dependencies());
+		mapped_dependencies = freeze(std::move(merged_dependencies));
+	}
+
+	auto result = types_model{freeze(std::move(available_types)), mapped_dependencies, freeze(std::move(all_implementations))};
+	// existing dependencies could only break if some of theirs types become ambiguous
+	validate_non_unresolvable(result, ambiguous.empty() ? added_dependencies : result.mapped_dependencies());
+
+	return result;
+}
+
+types_model extend_types_dependencies(const types_model &base, const types_dependencies &added_dependencies)
+{
+	if (added_dependencies.empty())
+		return base;
+
+	validate_non_unresolvable(base, added_dependencies);
+
+	auto mapped_dependencies = added_dependencies;
+	mapped_dependencies.merge(base.mapped_dependencies());
+	base._graph->add_edges(added_dependencies, base.available_types(), base.all_implementations());
+
+	return types_model{base._available_types, freeze(std::move(mapped_dependencies)), base._all_implementations, base._graph};
+}
+
+types_model reduce_types_model(const types_model &base, const std::vector<type> &removed_types)
+{
+	auto implemented_by_types = std::map<type, std::vector<type>>{};
+	for (auto &&removed_type : removed_types)
+		for (auto &&interface_type : extract_interfaces(removed_type))
+			if (implemented_by_types.find(interface_type) == std::end(implemented_by_types))
+			{
+				auto &implementation_types = implemented_by_types[interface_type];
+				for (auto &&implementation_type : base.all_implementations_of(interface_type))
+					if (std::find(std::begin(removed_types), std::end(removed_types), implementation_type) == std::end(removed_types))
+						implementation_types.push_back(implementation_type);
+			}
+
+	auto is_touched = [&](const type &interface_type){ return implemented_by_types.find(interface_type) != std::end(implemented_by_types); };
+	auto is_removed = [&](const type &interface_type){
+		auto implemented_by_type = implemented_by_types.find(interface_type);
+		return implemented_by_type != std::end(implemented_by_types) && implemented_by_type->second.empty();
+	};
+
+	auto unique = std::vector<implemented_by>{};
+	std::copy_if(std::begin(base.available_types()), std::end(base.available_types()), std::back_inserter(unique),
+		[&](const implemented_by &ib){ return !is_touched(ib.interface_type()); });
+	auto all = std::vector<implemented_by_all>{};
+	std::copy_if(std::begin(base.all_implementations()), std::end(base.all_implementations()), std::back_inserter(all),
+		[&](const implemented_by_all &iba){ return !is_touched(iba.interface_type()); });
+
+	for (auto &&implemented_by_type : implemented_by_types)
+	{
+		if (implemented_by_type.second.empty())
+			continue;
+		if (implemented_by_type.second.size() == 1)
+			unique.push_back(implemented_by{implemented_by_type.first, implemented_by_type.second.front()});
+		all.push_back(implemented_by_all{implemented_by_type.first, types{implemented_by_type.second}});
+	}
+
+	auto dependencies = std::vector<type_dependencies>{};
+	std::copy_if(std::begin(base.mapped_dependencies()), std::end(base.mapped_dependencies()), std::back_inserter(dependencies),
+		[&](const type_dependencies &td){ return !is_removed(td.dependent_type()); });
+
+	return types_model{implemented_by_mapping{unique}, types_dependencies{dependencies}, implemented_by_all_mapping{all}};
+}
+
 void validate_non_unresolvable(const types_model &model)
 {
-	auto unresolvable_dependencies = model.get_unresolvable_dependencies();
+	validate_non_unresolvable(model, model.mapped_dependencies());
+}
+
+void validate_non_unresolvable(const types_model &model, const types_dependencies &to_check)
+{
+	auto unresolvable_dependencies = model.get_unresolvable_dependencies(to_check);
 
 	if (!unresolvable_dependencies.empty())
 	{
@@ -23,11 +23,15 @@
 #include <injeqt/injeqt.h>
 #include <injeqt/type.h>
 
+#include "dependency-graph.h"
+#include "implemented-by-all-mapping.h"
 #include "implemented-by-mapping.h"
 #include "internal.h"
 #include "types-by-name.h"
 #include "types-dependencies.h"
 
+#include <memory>
+
 /**
  * @file
  * @brief Contains classes and functions for representing model of Injeqt types.
@@ -35,6 +39,21 @@
 
 namespace injeqt { namespace internal {
 
+/**
+ * @brief Read-only implemented_by_mapping of types_model.
+ */
+using frozen_implemented_by_mapping = frozen_sorted_vector<implemented_by_mapping>;
+
+/**
+ * @brief Read-only types_dependencies of types_model.
+ */
+using frozen_types_dependencies = frozen_sorted_vector<types_dependencies>;
+
+/**
+ * @brief Read-only implemented_by_all_mapping of types_model.
+ */
+using frozen_implemented_by_all_mapping = frozen_sorted_vector<implemented_by_all_mapping>;
+
 /**
  * @brief Model of all types, their dependencies and relations.
  *
@@ -58,21 +77,48 @@ public:
 	 * @brief Create new instance of types_model.
 	 * @param available_types set of all interfaces in model mapped to implementation types
 	 * @param mapped_dependencies set of all dependencies of implementation types
+	 * @param all_implementations set of all interfaces in model (including ambiguous) mapped to all implementation types
 	 *
-	 * Both @p available_types and @p mapped_dependencies should be created from the same set of
-	 * types for types_model to be usefull.
+	 * All of @p available_types, @p mapped_dependencies and @p all_implementations should be created from
+	 * the same set of types for types_model to be usefull. All of them are stored as frozen_sorted_vector,
+	 * as model is not modified after construction. Compact dependency_graph of model is built as well.
 	 */
-	explicit types_model(implemented_by_mapping available_types, types_dependencies mapped_dependencies);
+	explicit types_model(implemented_by_mapping available_types, types_dependencies mapped_dependencies,
+		implemented_by_all_mapping all_implementations = implemented_by_all_mapping{});
+
+	/**
+	 * @brief Create new instance of types_model from already frozen parts.
+	 *
+	 * Parts are immutable, so they can be shared with other models. Models made from other ones
+	 * reuse parts that did not change instead of copying them. Graph is shared by copies of model.
+	 */
+	explicit types_model(std::shared_ptr<const frozen_implemented_by_mapping> available_types, std::shared_ptr<const frozen_types_dependencies> mapped_dependencies,
+		std::shared_ptr<const frozen_implemented_by_all_mapping> all_implementations);
 
 	/**
 	 * @return set of all interfaces in model mapped to implementation types.
 	 */
-	const implemented_by_mapping & available_types() const;
+	const frozen_implemented_by_mapping & available_types() const;
 
 	/**
 	 * @return set of all dependencies of implementation types
 	 */
-	const types_dependencies & mapped_dependencies() const;
+	const frozen_types_dependencies & mapped_dependencies() const;
+
+	/**
+	 * @return set of all interfaces in model (including ambiguous) mapped to all implementation types
+	 */
+	const frozen_implemented_by_all_mapping & all_implementations() const;
+
+	/**
+	 * @return graph of dependencies between implementation types of model
+	 */
+	const dependency_graph & graph() const;
+
+	/**
+	 * @return all implementation types of @p interface_type, empty if none
+	 */
+	const types & all_implementations_of(const type &interface_type) const;
 
 	/**
 	 * @return true if model contains @p interface_type
@@ -81,12 +127,31 @@ public:
 
 	/**
 	 * @brief Return all unresolvable dependencies
+	 *
+	 * Dependencies with setters tagged with INJEQT_SET_ALL are always resolvable, even if no
+	 * type implements required interface.
 	 */
 	std::vector<dependency> get_unresolvable_dependencies() const;
 
+	/**
+	 * @brief Return unresolvable dependencies from @p to_check set
+	 *
+	 * Can be used to validate only part of model, for example types added with extend_types_model.
+	 */
+	std::vector<dependency> get_unresolvable_dependencies(const types_dependencies &to_check) const;
+
 private:
-	implemented_by_mapping _available_types;
-	types_dependencies _mapped_dependencies;
+	std::shared_ptr<const frozen_implemented_by_mapping> _available_types;
+	std::shared_ptr<const frozen_types_dependencies> _mapped_dependencies;
+	std::shared_ptr<const frozen_implemented_by_all_mapping> _all_implementations;
+	std::shared_ptr<const dependency_graph> _graph;
+
+	explicit types_model(std::shared_ptr<const frozen_implemented_by_mapping> available_types, std::shared_ptr<const frozen_types_dependencies> mapped_dependencies,
+		std::shared_ptr<const frozen_implemented_by_all_mapping> all_implementations, std::shared_ptr<const dependency_graph> graph);
+
+	friend types_model extend_types_model(const types_model &base, const types_by_name &known_types,
+		const std::vector<type> &new_types, const std::vector<type> &need_dependencies);
+	friend types_model extend_types_dependencies(const types_model &base, const types_dependencies &added_dependencies);
 
 };
 
@@ -107,6 +172,56 @@ private:
  */
 INJEQT_INTERNAL_API types_model make_types_model(const types_by_name &known_types, const std::vector<type> &all_types, const std::vector<type> &need_dependencies);
 
+/**
+ * @brief Create types_model from @p base with new set of types added.
+ * @param base model to extend
+ * @param known_types list of all known types, including new ones
+ * @param new_types set of types to add to model, all types must be valid and not already in @p base
+ * @param need_dependencies list of new types that will have dependencies extracted
+ * @throw ambiguous_types if one or more types is ambiguous after adding new types
+ * @throw unresolvable_dependencies if a new type has a dependency type not available in resulting model
+ * @throw unresolvable_dependencies if an existing dependency type is no longer available, because new type
+ *        made it ambiguous
+ * @throw dependency_on_self when type depends on self
+ * @throw dependency_on_subtype when type depends on own supertype
+ * @throw dependency_on_subtype when type depends on own subtype
+ * @throw invalid_setter if any tagged setter has invalid signature
+ *
+ * Only relations of interfaces of @p new_types are recomputed and only dependencies of new types are extracted
+ * and checked. Existing dependencies are checked only for interfaces that become ambiguous. Reflection and
+ * validation are therefore proportional to number of new types.
+ *
+ * Relations of new types are merged into sorted tables of @p base, which moves existing entries, and graph of
+ * dependencies is built again. This part is linear in size of @p base. Table of dependencies is shared with
+ * @p base when @p need_dependencies is empty.
+ */
+INJEQT_INTERNAL_API types_model extend_types_model(const types_model &base, const types_by_name &known_types,
+	const std::vector<type> &new_types, const std::vector<type> &need_dependencies);
+
+/**
+ * @brief Create types_model from @p base with dependencies of its types added.
+ * @param base model to extend
+ * @param added_dependencies dependencies of types of @p base that were not extracted before
+ * @throw unresolvable_dependencies if any of @p added_dependencies is unresolvable in @p base
+ *
+ * Used by lazy validation. Types and relations do not change, so tables of @p base and its graph of
+ * dependencies are shared with result. Graph is not built again: edges of @p added_dependencies are
+ * added to it with dependency_graph::add_edges() and closures computed before are kept. Only table of
+ * dependencies is merged, which moves existing entries.
+ */
+INJEQT_INTERNAL_API types_model extend_types_dependencies(const types_model &base, const types_dependencies &added_dependencies);
+
+/**
+ * @brief Create types_model from @p base with set of types removed.
+ * @param base model to reduce
+ * @param removed_types set of types to remove from model, all must be configured in @p base
+ *
+ * Only relations of interfaces of @p removed_types are recomputed. Interfaces that were ambiguous can
+ * become available, interfaces that have no implementations left are removed with theirs dependencies.
+ * Resulting model is not validated - dependencies of remaining types can be unresolvable.
+ */
+INJEQT_INTERNAL_API types_model reduce_types_model(const types_model &base, const std::vector<type> &removed_types);
+
 /**
  * @brief Check if types model do not have unresolvable types.
  * @param model model to check
@@ -114,4 +229,12 @@ INJEQT_INTERNAL_API types_model make_types_model(const types_by_name &known_type
  */
 INJEQT_INTERNAL_API void validate_non_unresolvable(const types_model &model);
 
+/**
+ * @brief Check if types model can resolve all dependencies in @p to_check.
+ * @param model model to check against
+ * @param to_check dependencies to check
+ * @throw unresolvable_dependencies if any of @p to_check is not resolvable with @p model
+ */
+INJEQT_INTERNAL_API void validate_non_unresolvable(const types_model &model, const types_dependencies &to_check);
+
 }}
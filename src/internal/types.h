@@ -23,6 +23,7 @@
 #include <injeqt/type.h>
 #include <injeqt/injeqt.h>
 
+#include "small-vector.h"
 #include "sorted-unique-vector.h"
 
 /**
@@ -42,7 +43,10 @@ inline type type_from_type(const type &i)
 
 /**
  * @brief Set of type objects.
+ *
+ * Most sets of types are short lists of interfaces or required types of one type, so up to eight
+ * types are stored inline, without heap allocation.
  */
-using types = sorted_unique_vector<type, type, type_from_type>;
+using types = sorted_unique_vector<type, type, type_from_type, small_vector<type, 8>>;
 
 }}
@@ -0,0 +1,65 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/lazy-module.h>
+
+#include <injeqt/module.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace injeqt { namespace v1 {
+
+lazy_module::lazy_module(std::vector<std::string> provided_type_names, loader load, std::vector<std::string> type_roles) :
+	_provided_type_names{std::move(provided_type_names)},
+	_load{std::move(load)},
+	_type_roles{std::move(type_roles)}
+{
+	assert(_load);
+}
+
+const std::vector<std::string> & lazy_module::provided_type_names() const
+{
+	return _provided_type_names;
+}
+
+const std::vector<std::string> & lazy_module::type_roles() const
+{
+	return _type_roles;
+}
+
+bool lazy_module::provides(const std::string &type_name) const
+{
+	return std::find(std::begin(_provided_type_names), std::end(_provided_type_names), type_name) != std::end(_provided_type_names);
+}
+
+bool lazy_module::has_type_role(const std::string &type_role) const
+{
+	return std::find(std::begin(_type_roles), std::end(_type_roles), type_role) != std::end(_type_roles);
+}
+
+std::unique_ptr<module> lazy_module::load() const
+{
+	auto result = _load();
+	assert(result);
+	return result;
+}
+
+}}
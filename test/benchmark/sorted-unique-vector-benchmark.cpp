@@ -0,0 +1,147 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/frozen-sorted-vector.h"
+#include "internal/sorted-unique-vector.h"
+
+#include <QtTest/QtTest>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace injeqt::internal;
+
+/**
+ * Compares lookups in sorted_unique_vector using binary search over content with lookups
+ * in frozen_sorted_vector using Eytzinger index. Configure with -DDISABLE_COVERAGE=ON and optimized build
+ * type to get meaningful results.
+ */
+class sorted_unique_vector_benchmark : public QObject
+{
+	Q_OBJECT
+
+	static int extract_key(const int &x)
+	{
+		return x;
+	}
+
+	static std::string extract_key_string(const std::string &x)
+	{
+		return x;
+	}
+
+	using suv_int = sorted_unique_vector<int, int, extract_key>;
+	using suv_string = sorted_unique_vector<std::string, std::string, extract_key_string>;
+
+	static const int lookups_count = 4096;
+
+	template<typename T>
+	static void lookup(const T &data, const std::vector<typename T::key_type> &keys)
+	{
+		auto found = 0;
+		QBENCHMARK
+		{
+			for (auto &&key : keys)
+				if (data.get(key) != end(data))
+					found++;
+		}
+		QVERIFY(found > 0);
+	}
+
+	static std::vector<int> make_int_keys(int size)
+	{
+		auto generator = std::mt19937{};
+		auto distribution = std::uniform_int_distribution<int>{0, 2 * size};
+		auto result = std::vector<int>{};
+		for (auto i = 0; i < lookups_count; i++)
+			result.push_back(distribution(generator));
+		return result;
+	}
+
+	static suv_int make_int_data(int size)
+	{
+		auto result = std::vector<int>{};
+		for (auto i = 0; i < size; i++)
+			result.push_back(2 * i);
+		return suv_int{result};
+	}
+
+	static std::vector<std::string> make_string_keys(int size)
+	{
+		auto result = std::vector<std::string>{};
+		for (auto &&key : make_int_keys(size))
+			result.push_back("type_" + std::to_string(key));
+		return result;
+	}
+
+	static suv_string make_string_data(int size)
+	{
+		auto result = std::vector<std::string>{};
+		for (auto i = 0; i < size; i++)
+			result.push_back("type_" + std::to_string(2 * i));
+		return suv_string{result};
+	}
+
+	static void add_sizes()
+	{
+		QTest::addColumn<int>("size");
+		QTest::newRow("100") << 100;
+		QTest::newRow("1000") << 1000;
+		QTest::newRow("10000") << 10000;
+	}
+
+private slots:
+	void lookup_int_sorted_data() { add_sizes(); }
+	void lookup_int_sorted();
+	void lookup_int_frozen_data() { add_sizes(); }
+	void lookup_int_frozen();
+	void lookup_string_sorted_data() { add_sizes(); }
+	void lookup_string_sorted();
+	void lookup_string_frozen_data() { add_sizes(); }
+	void lookup_string_frozen();
+
+};
+
+void sorted_unique_vector_benchmark::lookup_int_sorted()
+{
+	QFETCH(int, size);
+	lookup(make_int_data(size), make_int_keys(size));
+}
+
+void sorted_unique_vector_benchmark::lookup_int_frozen()
+{
+	QFETCH(int, size);
+	lookup(frozen_sorted_vector<suv_int>{make_int_data(size)}, make_int_keys(size));
+}
+
+void sorted_unique_vector_benchmark::lookup_string_sorted()
+{
+	QFETCH(int, size);
+	lookup(make_string_data(size), make_string_keys(size));
+}
+
+void sorted_unique_vector_benchmark::lookup_string_frozen()
+{
+	QFETCH(int, size);
+	lookup(frozen_sorted_vector<suv_string>{make_string_data(size)}, make_string_keys(size));
+}
+
+QTEST_APPLESS_MAIN(sorted_unique_vector_benchmark)
+#include "sorted-unique-vector-benchmark.moc"
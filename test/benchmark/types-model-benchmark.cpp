@@ -0,0 +1,138 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/type.h>
+
+#include "internal/implemented-by.h"
+#include "internal/implemented-by-all.h"
+#include "internal/types-by-name.h"
+#include "internal/types-model.h"
+
+#include <QtTest/QtTest>
+#include <vector>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class synthetic_type : public QObject
+{
+	Q_OBJECT
+};
+
+class added_type : public QObject
+{
+	Q_OBJECT
+};
+
+/**
+ * Compares creating types_model from scratch with extending already created model by one type, for
+ * models of different sizes. Types of base model are copies of one meta object, so each of them is
+ * a distinct type without setters. Configure with -DDISABLE_COVERAGE=ON and optimized build type to
+ * get meaningful results.
+ */
+class types_model_benchmark : public QObject
+{
+	Q_OBJECT
+
+	static std::vector<QMetaObject> make_meta_objects(int size)
+	{
+		return std::vector<QMetaObject>(static_cast<std::size_t>(size), synthetic_type::staticMetaObject);
+	}
+
+	static std::vector<type> make_types(const std::vector<QMetaObject> &meta_objects)
+	{
+		auto result = std::vector<type>{};
+		for (auto &&meta_object : meta_objects)
+			result.push_back(type{&meta_object});
+		return result;
+	}
+
+	static types_model make_base(const std::vector<type> &all_types)
+	{
+		auto unique = std::vector<implemented_by>{};
+		auto all = std::vector<implemented_by_all>{};
+		for (auto &&t : all_types)
+		{
+			unique.push_back(implemented_by{t, t});
+			all.push_back(implemented_by_all{t, types{t}});
+		}
+		return types_model{implemented_by_mapping{unique}, types_dependencies{}, implemented_by_all_mapping{all}};
+	}
+
+	static void add_sizes()
+	{
+		QTest::addColumn<int>("size");
+		QTest::newRow("100") << 100;
+		QTest::newRow("1000") << 1000;
+		QTest::newRow("10000") << 10000;
+	}
+
+private slots:
+	void make_model_data() { add_sizes(); }
+	void make_model();
+	void extend_model_data() { add_sizes(); }
+	void extend_model();
+	void extend_model_with_dependencies_data() { add_sizes(); }
+	void extend_model_with_dependencies();
+
+};
+
+void types_model_benchmark::make_model()
+{
+	QFETCH(int, size);
+	auto meta_objects = make_meta_objects(size);
+	auto all_types = make_types(meta_objects);
+	all_types.push_back(make_type<added_type>());
+	auto known_types = types_by_name{std::vector<type>{make_type<added_type>()}};
+
+	QBENCHMARK
+	{
+		make_types_model(known_types, all_types, all_types);
+	}
+}
+
+void types_model_benchmark::extend_model()
+{
+	QFETCH(int, size);
+	auto meta_objects = make_meta_objects(size);
+	auto base = make_base(make_types(meta_objects));
+	auto known_types = types_by_name{std::vector<type>{make_type<added_type>()}};
+
+	QBENCHMARK
+	{
+		extend_types_model(base, known_types, std::vector<type>{make_type<added_type>()}, std::vector<type>{});
+	}
+}
+
+void types_model_benchmark::extend_model_with_dependencies()
+{
+	QFETCH(int, size);
+	auto meta_objects = make_meta_objects(size);
+	auto base = make_base(make_types(meta_objects));
+	auto known_types = types_by_name{std::vector<type>{make_type<added_type>()}};
+
+	QBENCHMARK
+	{
+		extend_types_model(base, known_types, std::vector<type>{make_type<added_type>()}, std::vector<type>{make_type<added_type>()});
+	}
+}
+
+QTEST_APPLESS_MAIN(types_model_benchmark)
+#include "types-model-benchmark.moc"
@@ -0,0 +1,240 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/exception/ambiguous-types.h>
+#include <injeqt/exception/unresolvable-dependencies.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+
+injeqt::injector *extending_injector = nullptr;
+
+class base_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE base_service() {}
+
+};
+
+class feature_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE feature_service() {}
+	base_service *base = nullptr;
+
+private slots:
+	INJEQT_SET void set_base_service(base_service *service) { base = service; }
+
+};
+
+class plugin : public QObject
+{
+	Q_OBJECT
+
+public:
+	virtual ~plugin() {}
+
+};
+
+class plugin_1 : public plugin
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_1() {}
+
+};
+
+class plugin_2 : public plugin
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_2() {}
+
+};
+
+class plugin_user : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_user() {}
+
+private slots:
+	INJEQT_SET void set_plugin(plugin *) {}
+
+};
+
+class extended_product : public QObject
+{
+	Q_OBJECT
+
+};
+
+class extending_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE extending_factory();
+	Q_INVOKABLE extended_product * create_extended_product() const { return new extended_product{}; }
+
+};
+
+class extending_module : public injeqt::module
+{
+public:
+	extending_module()
+	{
+		add_type<extending_factory>();
+		add_factory<extended_product, extending_factory>();
+	}
+	virtual ~extending_module() {}
+};
+
+template<typename T>
+class single_type_module : public injeqt::module
+{
+public:
+	single_type_module()
+	{
+		add_type<T>();
+	}
+	virtual ~single_type_module() {}
+};
+
+template<typename T>
+std::vector<std::unique_ptr<injeqt::module>> make_modules()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<single_type_module<T>>{new single_type_module<T>{}});
+	return modules;
+}
+
+extending_factory::extending_factory()
+{
+	// enough new providers to move already configured ones
+	auto modules = make_modules<base_service>();
+	modules.emplace_back(std::unique_ptr<single_type_module<plugin_1>>{new single_type_module<plugin_1>{}});
+	modules.emplace_back(std::unique_ptr<single_type_module<plugin_2>>{new single_type_module<plugin_2>{}});
+	modules.emplace_back(std::unique_ptr<single_type_module<feature_service>>{new single_type_module<feature_service>{}});
+	extending_injector->add_modules(std::move(modules));
+}
+
+class add_modules_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_add_types_to_empty_injector();
+	void should_resolve_new_types_with_existing_objects();
+	void should_extend_all_implementations();
+	void should_throw_when_type_already_configured();
+	void should_throw_when_existing_dependency_becomes_ambiguous();
+	void should_add_modules_while_instantiating_required_types();
+
+};
+
+void add_modules_behavior_test::should_add_types_to_empty_injector()
+{
+	auto injector = injeqt::injector{};
+	injector.add_modules(make_modules<base_service>());
+
+	QVERIFY(injector.get<base_service>() != nullptr);
+}
+
+void add_modules_behavior_test::should_resolve_new_types_with_existing_objects()
+{
+	auto injector = injeqt::injector{make_modules<base_service>()};
+	auto base = injector.get<base_service>();
+
+	injector.add_modules(make_modules<feature_service>());
+
+	QCOMPARE(injector.get<base_service>(), base);
+	QCOMPARE(injector.get<feature_service>()->base, base);
+}
+
+void add_modules_behavior_test::should_extend_all_implementations()
+{
+	auto injector = injeqt::injector{make_modules<plugin_1>()};
+	QCOMPARE(injector.get_all<plugin>().size(), size_t{1});
+
+	injector.add_modules(make_modules<plugin_2>());
+	QCOMPARE(injector.get_all<plugin>().size(), size_t{2});
+}
+
+void add_modules_behavior_test::should_throw_when_type_already_configured()
+{
+	auto injector = injeqt::injector{make_modules<base_service>()};
+	auto base = injector.get<base_service>();
+
+	try
+	{
+		injector.add_modules(make_modules<base_service>());
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::ambiguous_types &)
+	{
+	}
+
+	QCOMPARE(injector.get<base_service>(), base);
+}
+
+void add_modules_behavior_test::should_throw_when_existing_dependency_becomes_ambiguous()
+{
+	auto modules = make_modules<plugin_1>();
+	modules.emplace_back(std::unique_ptr<single_type_module<plugin_user>>{new single_type_module<plugin_user>{}});
+	auto injector = injeqt::injector{std::move(modules)};
+
+	try
+	{
+		injector.add_modules(make_modules<plugin_2>());
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::unresolvable_dependencies &)
+	{
+	}
+
+	QVERIFY(injector.get<plugin_user>() != nullptr);
+	QCOMPARE(injector.get_all<plugin>().size(), size_t{1});
+}
+
+void add_modules_behavior_test::should_add_modules_while_instantiating_required_types()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<extending_module>{new extending_module{}});
+	auto injector = injeqt::injector{std::move(modules)};
+	extending_injector = &injector;
+
+	QVERIFY(injector.get<extended_product>() != nullptr);
+	QVERIFY(injector.get<extending_factory>() != nullptr);
+	QCOMPARE(injector.get_all<plugin>().size(), size_t{2});
+
+	extending_injector = nullptr;
+}
+
+QTEST_APPLESS_MAIN(add_modules_behavior_test)
+#include "add-modules-behavior-test.moc"
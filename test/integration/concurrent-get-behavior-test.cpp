@@ -0,0 +1,191 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+std::atomic<int> stable_service_count{0};
+std::promise<void> blocking_service_started;
+std::promise<void> blocking_service_released;
+bool blocking_service_was_released = false;
+
+class stable_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE stable_service() { stable_service_count++; }
+
+};
+
+class feature_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE feature_service() {}
+
+private slots:
+	INJEQT_SET void set_stable_service(stable_service *) {}
+
+};
+
+class blocking_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE blocking_service()
+	{
+		blocking_service_started.set_value();
+		auto released = blocking_service_released.get_future();
+		blocking_service_was_released = released.wait_for(std::chrono::seconds{5}) == std::future_status::ready;
+	}
+
+};
+
+class stable_module : public injeqt::module
+{
+public:
+	stable_module()
+	{
+		add_type<stable_service>();
+		add_type<blocking_service>();
+	}
+	virtual ~stable_module() {}
+};
+
+class feature_module : public injeqt::module
+{
+public:
+	feature_module()
+	{
+		add_type<feature_service>();
+	}
+	virtual ~feature_module() {}
+};
+
+class concurrent_get_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void should_return_same_object_to_concurrent_readers_during_reconfiguration();
+	void should_not_wait_for_instantiation_of_other_type();
+	void should_not_wait_for_instantiation_when_getting_all_objects();
+
+private:
+	injeqt::injector create_injector();
+
+};
+
+void concurrent_get_behavior_test::init()
+{
+	stable_service_count = 0;
+	blocking_service_started = std::promise<void>{};
+	blocking_service_released = std::promise<void>{};
+	blocking_service_was_released = false;
+}
+
+injeqt::injector concurrent_get_behavior_test::create_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new stable_module{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+void concurrent_get_behavior_test::should_return_same_object_to_concurrent_readers_during_reconfiguration()
+{
+	auto injector = create_injector();
+	std::atomic<int> readers_done{0};
+	auto readers = std::vector<std::thread>{};
+	auto results = std::vector<std::vector<stable_service *>>(4);
+
+	for (auto &&result : results)
+		readers.emplace_back([&injector, &readers_done, &result](){
+			for (auto i = 0; i < 1000; i++)
+				result.push_back(injector.get<stable_service>());
+			readers_done++;
+		});
+
+	// writer keeps replacing configuration while readers run
+	while (readers_done.load() < static_cast<int>(readers.size()))
+	{
+		auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+		modules.emplace_back(std::unique_ptr<injeqt::module>{new feature_module{}});
+		auto features = modules.back().get();
+		injector.add_modules(std::move(modules));
+		QVERIFY(injector.get<feature_service>() != nullptr);
+		injector.remove_module(features);
+	}
+
+	for (auto &&reader : readers)
+		reader.join();
+
+	auto stable = injector.get<stable_service>();
+	QCOMPARE(stable_service_count.load(), 1);
+	for (auto &&result : results)
+	{
+		QCOMPARE(result.size(), size_t{1000});
+		QVERIFY(std::all_of(std::begin(result), std::end(result), [stable](stable_service *s){ return s == stable; }));
+	}
+}
+
+void concurrent_get_behavior_test::should_not_wait_for_instantiation_of_other_type()
+{
+	auto injector = create_injector();
+	auto stable = injector.get<stable_service>();
+
+	// worker holds injector lock until blocking_service is released
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<blocking_service>()});
+	blocking_service_started.get_future().wait();
+
+	QCOMPARE(injector.get<stable_service>(), stable);
+	blocking_service_released.set_value();
+	injector.wait_for_prewarm();
+
+	QVERIFY(blocking_service_was_released);
+}
+
+void concurrent_get_behavior_test::should_not_wait_for_instantiation_when_getting_all_objects()
+{
+	auto injector = create_injector();
+	auto stable = injector.get<stable_service>();
+
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<blocking_service>()});
+	blocking_service_started.get_future().wait();
+
+	QCOMPARE(injector.get_all<stable_service>(), std::vector<stable_service *>{stable});
+	blocking_service_released.set_value();
+	injector.wait_for_prewarm();
+
+	QVERIFY(blocking_service_was_released);
+}
+
+QTEST_APPLESS_MAIN(concurrent_get_behavior_test)
+#include "concurrent-get-behavior-test.moc"
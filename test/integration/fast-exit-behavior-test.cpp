@@ -0,0 +1,143 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+
+int destroyed_count = 0;
+int done_count = 0;
+int done_on_fast_exit_count = 0;
+
+class ready_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	virtual ~ready_object() { destroyed_count++; }
+
+};
+
+class plain_object : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plain_object() {}
+	virtual ~plain_object() { destroyed_count++; }
+
+private slots:
+	INJEQT_DONE void done() { done_count++; }
+
+};
+
+class marked_object : public QObject
+{
+	Q_OBJECT
+	INJEQT_DONE_ON_FAST_EXIT
+
+public:
+	Q_INVOKABLE marked_object() {}
+	virtual ~marked_object() { destroyed_count++; }
+
+private slots:
+	INJEQT_DONE void done() { done_on_fast_exit_count++; }
+	INJEQT_SET void set_plain_object(plain_object *) {}
+
+};
+
+class fast_exit_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private:
+	injeqt::injector create_injector();
+
+private slots:
+	void should_call_only_marked_done_methods_and_not_destroy_objects();
+	void should_be_empty_after_fast_exit();
+
+};
+
+injeqt::injector fast_exit_behavior_test::create_injector()
+{
+	destroyed_count = 0;
+	done_count = 0;
+	done_on_fast_exit_count = 0;
+
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			_ready_object = std::unique_ptr<ready_object>(new ready_object{});
+			add_ready_object<ready_object>(_ready_object.get());
+			add_type<plain_object>();
+			add_type<marked_object>();
+		}
+		virtual ~m() {}
+	private:
+		std::unique_ptr<ready_object> _ready_object;
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+void fast_exit_behavior_test::should_call_only_marked_done_methods_and_not_destroy_objects()
+{
+	{
+		auto injector = create_injector();
+		injector.get<marked_object>();
+		injector.get<ready_object>();
+
+		injector.fast_exit();
+		QCOMPARE(done_on_fast_exit_count, 1);
+		QCOMPARE(done_count, 0);
+		QCOMPARE(destroyed_count, 0);
+	}
+
+	QCOMPARE(done_on_fast_exit_count, 1);
+	QCOMPARE(done_count, 0);
+	QCOMPARE(destroyed_count, 0);
+}
+
+void fast_exit_behavior_test::should_be_empty_after_fast_exit()
+{
+	auto injector = create_injector();
+	injector.fast_exit();
+
+	auto thrown = false;
+	try
+	{
+		injector.get<plain_object>();
+	}
+	catch (injeqt::exception::unknown_type &)
+	{
+		thrown = true;
+	}
+	QVERIFY(thrown);
+}
+
+QTEST_APPLESS_MAIN(fast_exit_behavior_test)
+#include "fast-exit-behavior-test.moc"
@@ -0,0 +1,162 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <string>
+#include <vector>
+
+std::vector<std::string> created;
+
+class storage : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE storage() { created.push_back("storage"); }
+
+};
+
+class network : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE network() { created.push_back("network"); }
+
+};
+
+class window : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE window() { created.push_back("window"); }
+	storage *s = nullptr;
+	network *n = nullptr;
+	bool initialized = false;
+
+private slots:
+	INJEQT_INIT void init() { initialized = s && n; }
+	INJEQT_SET void set_storage(storage *x) { s = x; }
+	INJEQT_SET void set_network(network *x) { n = x; }
+
+};
+
+class not_configured : public QObject
+{
+	Q_OBJECT
+
+};
+
+class window_module : public injeqt::module
+{
+public:
+	window_module()
+	{
+		add_type<storage>();
+		add_type<network>();
+		add_type<window>();
+	}
+	virtual ~window_module() {}
+};
+
+class incremental_instantiation_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void should_not_instantiate_before_event_loop();
+	void should_instantiate_dependencies_first();
+	void should_skip_objects_created_by_get();
+	void should_throw_for_unknown_type();
+
+private:
+	injeqt::injector create_injector();
+
+};
+
+void incremental_instantiation_behavior_test::init()
+{
+	created.clear();
+}
+
+injeqt::injector incremental_instantiation_behavior_test::create_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new window_module{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+void incremental_instantiation_behavior_test::should_not_instantiate_before_event_loop()
+{
+	auto injector = create_injector();
+	injector.instantiate_incrementally(std::vector<injeqt::type>{injeqt::make_type<window>()}, std::chrono::milliseconds{8});
+
+	QVERIFY(created.empty());
+}
+
+void incremental_instantiation_behavior_test::should_instantiate_dependencies_first()
+{
+	auto finished = false;
+	auto injector = create_injector();
+	injector.instantiate_incrementally(std::vector<injeqt::type>{injeqt::make_type<window>()}, std::chrono::milliseconds{8},
+		[&](std::exception_ptr error){ finished = !error; });
+
+	QTRY_VERIFY(finished);
+	QCOMPARE(created.size(), size_t{3});
+	QCOMPARE(created.back(), std::string{"window"});
+	QVERIFY(injector.get<window>()->initialized);
+	QCOMPARE(created.size(), size_t{3});
+}
+
+void incremental_instantiation_behavior_test::should_skip_objects_created_by_get()
+{
+	auto finished = false;
+	auto injector = create_injector();
+	injector.instantiate_incrementally(std::vector<injeqt::type>{injeqt::make_type<window>()}, std::chrono::milliseconds{8},
+		[&](std::exception_ptr error){ finished = !error; });
+
+	auto w = injector.get<window>();
+	QTRY_VERIFY(finished);
+	QCOMPARE(injector.get<window>(), w);
+	QCOMPARE(created.size(), size_t{3});
+}
+
+void incremental_instantiation_behavior_test::should_throw_for_unknown_type()
+{
+	auto injector = create_injector();
+
+	try
+	{
+		injector.instantiate_incrementally(std::vector<injeqt::type>{injeqt::make_type<not_configured>()}, std::chrono::milliseconds{8});
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::unknown_type &)
+	{
+	}
+}
+
+QTEST_GUILESS_MAIN(incremental_instantiation_behavior_test)
+#include "incremental-instantiation-behavior-test.moc"
@@ -18,6 +18,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <injeqt/exception/exception.h>
 #include <injeqt/injector.h>
 #include <injeqt/module.h>
 
@@ -73,16 +74,108 @@ public:
 
 };
 
+class initialized_service : public int_service
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE initialized_service() {}
+	int init_count = 0;
+
+private slots:
+	INJEQT_INIT void init() { init_count++; }
+
+};
+
+class extra_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE extra_type() {}
+
+};
+
+class extra_module : public injeqt::module
+{
+public:
+	extra_module()
+	{
+		add_type<extra_type>();
+	}
+	virtual ~extra_module() {}
+};
+
+class reconfiguring_service : public int_service
+{
+	Q_OBJECT
+
+public:
+	static injeqt::injector *reconfigured_injector;
+	static injeqt::module *added_module;
+
+	Q_INVOKABLE reconfiguring_service() {}
+	int init_count = 0;
+
+private slots:
+	INJEQT_INIT void init_reconfigure()
+	{
+		// each reconfiguration drops cached injection plans
+		if (added_module)
+		{
+			reconfigured_injector->remove_module(added_module);
+			added_module = nullptr;
+		}
+		else
+		{
+			auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+			modules.emplace_back(std::unique_ptr<injeqt::module>{new extra_module{}});
+			added_module = modules.back().get();
+			reconfigured_injector->add_modules(std::move(modules));
+		}
+		init_count++;
+	}
+
+	INJEQT_INIT void init_count_up() { init_count++; }
+
+};
+
+injeqt::injector *reconfiguring_service::reconfigured_injector = nullptr;
+injeqt::module *reconfiguring_service::added_module = nullptr;
+
+class not_configured : public QObject
+{
+	Q_OBJECT
+};
+
+class not_configured_service : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	INJEQT_SET void set_not_configured(not_configured *) {}
+
+};
+
 class inject_into_behavior_test : public QObject
 {
 	Q_OBJECT
 
+private:
+	injeqt::injector create_injector();
+
 private slots:
 	void should_properly_inject_into();
+	void should_properly_inject_into_many();
+	void should_not_inject_into_any_when_one_is_invalid();
+	void should_inject_into_the_same_type_repeatedly();
+	void should_throw_each_time_for_invalid_type();
+	void should_inject_into_when_init_reconfigures_injector();
+	void should_inject_into_many_when_init_reconfigures_injector();
 
 };
 
-void inject_into_behavior_test::should_properly_inject_into()
+injeqt::injector inject_into_behavior_test::create_injector()
 {
 	class m : public injeqt::module
 	{
@@ -96,7 +189,12 @@ void inject_into_behavior_test::should_properly_inject_into()
 
 	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
 	modules.emplace_back(std::unique_ptr<m>{new m{}});
-	auto injector = injeqt::injector{std::move(modules)};
+	return injeqt::injector{std::move(modules)};
+}
+
+void inject_into_behavior_test::should_properly_inject_into()
+{
+	auto injector = create_injector();
 
 	int_service service{};
 	injector.inject_into(&service);
@@ -107,5 +205,112 @@ void inject_into_behavior_test::should_properly_inject_into()
 	QCOMPARE(9, sub_service.value());
 }
 
+void inject_into_behavior_test::should_properly_inject_into_many()
+{
+	auto injector = create_injector();
+
+	int_service services[3];
+	int_sub_service sub_services[2];
+	initialized_service initialized_services[2];
+
+	injector.inject_into(std::vector<QObject *>{&services[0], &sub_services[0], &services[1],
+		&initialized_services[0], &services[2], &sub_services[1], &initialized_services[1]});
+
+	for (auto &&service : services)
+		QCOMPARE(9, service.value());
+	for (auto &&sub_service : sub_services)
+		QCOMPARE(9, sub_service.value());
+	for (auto &&initialized : initialized_services)
+	{
+		QCOMPARE(9, initialized.value());
+		QCOMPARE(1, initialized.init_count);
+	}
+}
+
+void inject_into_behavior_test::should_not_inject_into_any_when_one_is_invalid()
+{
+	auto injector = create_injector();
+
+	initialized_service initialized{};
+	not_configured_service invalid{};
+
+	try
+	{
+		injector.inject_into(std::vector<QObject *>{&initialized, &invalid});
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::exception &)
+	{
+	}
+
+	QCOMPARE(0, initialized.init_count);
+}
+
+void inject_into_behavior_test::should_inject_into_the_same_type_repeatedly()
+{
+	auto injector = create_injector();
+
+	for (auto i = 0; i < 3; i++)
+	{
+		initialized_service initialized{};
+		injector.inject_into(&initialized);
+		QCOMPARE(9, initialized.value());
+		QCOMPARE(1, initialized.init_count);
+	}
+}
+
+void inject_into_behavior_test::should_throw_each_time_for_invalid_type()
+{
+	auto injector = create_injector();
+
+	for (auto i = 0; i < 2; i++)
+	{
+		not_configured_service invalid{};
+		try
+		{
+			injector.inject_into(&invalid);
+			QFAIL("Exception not thrown");
+		}
+		catch (injeqt::exception::exception &)
+		{
+		}
+	}
+}
+
+void inject_into_behavior_test::should_inject_into_when_init_reconfigures_injector()
+{
+	auto injector = create_injector();
+	reconfiguring_service::reconfigured_injector = &injector;
+	reconfiguring_service::added_module = nullptr;
+
+	for (auto i = 0; i < 3; i++)
+	{
+		reconfiguring_service service{};
+		injector.inject_into(&service);
+		QCOMPARE(9, service.value());
+		QCOMPARE(2, service.init_count);
+	}
+
+	reconfiguring_service::reconfigured_injector = nullptr;
+}
+
+void inject_into_behavior_test::should_inject_into_many_when_init_reconfigures_injector()
+{
+	auto injector = create_injector();
+	reconfiguring_service::reconfigured_injector = &injector;
+	reconfiguring_service::added_module = nullptr;
+
+	reconfiguring_service services[3];
+	injector.inject_into(std::vector<QObject *>{&services[0], &services[1], &services[2]});
+
+	for (auto &&service : services)
+	{
+		QCOMPARE(9, service.value());
+		QCOMPARE(2, service.init_count);
+	}
+
+	reconfiguring_service::reconfigured_injector = nullptr;
+}
+
 QTEST_APPLESS_MAIN(inject_into_behavior_test)
 #include "inject-into-behavior-test.moc"
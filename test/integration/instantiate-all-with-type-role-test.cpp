@@ -63,15 +63,29 @@ private slots:
 
 };
 
+class role_1_and_2_type : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(ROLE_1)
+	INJEQT_TYPE_ROLE(ROLE_2)
+
+public:
+	Q_INVOKABLE role_1_and_2_type() { instantiated_types.insert(make_type<role_1_and_2_type>()); }
+};
+
 class instantiate_all_with_type_role_test : public QObject
 {
 	Q_OBJECT
 
 private:
 	injeqt::injector create_injector();
+	injeqt::injector create_multiple_roles_injector();
 
 private slots:
 	void should_create_all_role_instances_with_dependencied_when_requested();
+	void should_create_instances_with_multiple_roles();
+	void should_return_all_role_instances();
+	void should_return_nothing_for_unknown_role();
 
 };
 
@@ -96,6 +110,26 @@ injeqt::injector instantiate_all_with_type_role_test::create_injector()
 	return injeqt::injector{std::move(modules)};
 }
 
+injeqt::injector instantiate_all_with_type_role_test::create_multiple_roles_injector()
+{
+	instantiated_types.clear();
+
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<no_role_required_by_role_1>();
+			add_type<role_1_and_2_type>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	return injeqt::injector{std::move(modules)};
+}
+
 void instantiate_all_with_type_role_test::should_create_all_role_instances_with_dependencied_when_requested()
 {
 	auto injector = create_injector();
@@ -107,5 +141,35 @@ void instantiate_all_with_type_role_test::should_create_all_role_instances_with_
 	QCOMPARE((std::set<type>{make_type<role_2_type>(), make_type<no_role_required_by_role_1>(), make_type<role_1_type>()}), instantiated_types);
 }
 
+void instantiate_all_with_type_role_test::should_create_instances_with_multiple_roles()
+{
+	auto injector = create_multiple_roles_injector();
+	injector.instantiate_all_with_type_role(ROLE_2);
+	QCOMPARE((std::set<type>{make_type<role_1_and_2_type>()}), instantiated_types);
+
+	injector.instantiate_all_with_type_role(ROLE_1);
+	QCOMPARE((std::set<type>{make_type<role_1_and_2_type>(), make_type<no_role_required_by_role_1>()}), instantiated_types);
+}
+
+void instantiate_all_with_type_role_test::should_return_all_role_instances()
+{
+	auto injector = create_injector();
+	auto role_2_objects = injector.get_all_with_type_role(ROLE_2);
+	QCOMPARE(role_2_objects.size(), size_t{1});
+	QCOMPARE(role_2_objects[0], static_cast<QObject *>(injector.get<role_2_type>()));
+
+	auto role_1_objects = injector.get_all_with_type_role(ROLE_1);
+	QCOMPARE(role_1_objects.size(), size_t{1});
+	QCOMPARE(role_1_objects[0], static_cast<QObject *>(injector.get<no_role_required_by_role_1>()));
+	QCOMPARE((std::set<type>{make_type<role_2_type>(), make_type<no_role_required_by_role_1>()}), instantiated_types);
+}
+
+void instantiate_all_with_type_role_test::should_return_nothing_for_unknown_role()
+{
+	auto injector = create_injector();
+	QVERIFY(injector.get_all_with_type_role("unknown").empty());
+	QVERIFY(instantiated_types.empty());
+}
+
 QTEST_APPLESS_MAIN(instantiate_all_with_type_role_test)
 #include "instantiate-all-with-type-role-test.moc"
@@ -0,0 +1,230 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/lazy-module.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+
+#define PLUGIN_ROLE "plugin"
+
+class base_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE base_service() {}
+
+};
+
+class feature_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE feature_service() {}
+	base_service *base = nullptr;
+
+private slots:
+	INJEQT_SET void set_base_service(base_service *service) { base = service; }
+
+};
+
+class plugin : public QObject
+{
+	Q_OBJECT
+
+public:
+	virtual ~plugin() {}
+
+};
+
+class plugin_1 : public plugin
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(PLUGIN_ROLE)
+
+public:
+	Q_INVOKABLE plugin_1() {}
+
+};
+
+class plugin_2 : public plugin
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(PLUGIN_ROLE)
+
+public:
+	Q_INVOKABLE plugin_2() {}
+
+};
+
+class feature_user : public QObject
+{
+	Q_OBJECT
+
+public:
+	feature_service *feature = nullptr;
+
+private slots:
+	INJEQT_SET void set_feature_service(feature_service *service) { feature = service; }
+
+};
+
+template<typename T>
+class single_type_module : public injeqt::module
+{
+public:
+	single_type_module()
+	{
+		add_type<T>();
+	}
+	virtual ~single_type_module() {}
+};
+
+template<typename T>
+injeqt::lazy_module make_lazy_module(int &load_count, std::vector<std::string> type_names, std::vector<std::string> type_roles = std::vector<std::string>{})
+{
+	return injeqt::lazy_module{type_names, [&load_count](){
+		load_count++;
+		return std::unique_ptr<injeqt::module>{new single_type_module<T>{}};
+	}, type_roles};
+}
+
+class lazy_module_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_load_modules_when_added();
+	void should_load_module_on_get();
+	void should_load_module_only_once();
+	void should_load_required_lazy_modules();
+	void should_load_module_on_inject_into();
+	void should_load_all_modules_on_get_all();
+	void should_load_modules_on_type_role();
+
+};
+
+void lazy_module_behavior_test::should_not_load_modules_when_added()
+{
+	auto load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{make_lazy_module<base_service>(load_count, {"base_service"})});
+
+	QCOMPARE(load_count, 0);
+}
+
+void lazy_module_behavior_test::should_load_module_on_get()
+{
+	auto base_load_count = 0;
+	auto feature_load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{
+		make_lazy_module<base_service>(base_load_count, {"base_service"}),
+		make_lazy_module<plugin_1>(feature_load_count, {"plugin_1", "plugin"})
+	});
+
+	QVERIFY(injector.get<base_service>() != nullptr);
+	QCOMPARE(base_load_count, 1);
+	QCOMPARE(feature_load_count, 0);
+}
+
+void lazy_module_behavior_test::should_load_module_only_once()
+{
+	auto load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{make_lazy_module<base_service>(load_count, {"base_service"})});
+
+	auto base = injector.get<base_service>();
+	QCOMPARE(injector.get<base_service>(), base);
+	QCOMPARE(load_count, 1);
+}
+
+void lazy_module_behavior_test::should_load_required_lazy_modules()
+{
+	auto base_load_count = 0;
+	auto feature_load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{
+		make_lazy_module<base_service>(base_load_count, {"base_service"}),
+		make_lazy_module<feature_service>(feature_load_count, {"feature_service"})
+	});
+
+	auto feature = injector.get<feature_service>();
+	QCOMPARE(base_load_count, 1);
+	QCOMPARE(feature_load_count, 1);
+	QCOMPARE(feature->base, injector.get<base_service>());
+}
+
+void lazy_module_behavior_test::should_load_module_on_inject_into()
+{
+	auto base_load_count = 0;
+	auto feature_load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{
+		make_lazy_module<base_service>(base_load_count, {"base_service"}),
+		make_lazy_module<feature_service>(feature_load_count, {"feature_service"})
+	});
+
+	feature_user user;
+	injector.inject_into(&user);
+
+	QCOMPARE(base_load_count, 1);
+	QCOMPARE(feature_load_count, 1);
+	QCOMPARE(user.feature, injector.get<feature_service>());
+}
+
+void lazy_module_behavior_test::should_load_all_modules_on_get_all()
+{
+	auto plugin_1_load_count = 0;
+	auto plugin_2_load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{
+		make_lazy_module<plugin_1>(plugin_1_load_count, {"plugin_1", "plugin"}),
+		make_lazy_module<plugin_2>(plugin_2_load_count, {"plugin_2", "plugin"})
+	});
+
+	QCOMPARE(injector.get_all<plugin>().size(), size_t{2});
+	QCOMPARE(plugin_1_load_count, 1);
+	QCOMPARE(plugin_2_load_count, 1);
+}
+
+void lazy_module_behavior_test::should_load_modules_on_type_role()
+{
+	auto base_load_count = 0;
+	auto plugin_1_load_count = 0;
+	auto plugin_2_load_count = 0;
+	auto injector = injeqt::injector{};
+	injector.add_lazy_modules(std::vector<injeqt::lazy_module>{
+		make_lazy_module<base_service>(base_load_count, {"base_service"}),
+		make_lazy_module<plugin_1>(plugin_1_load_count, {"plugin_1", "plugin"}, {PLUGIN_ROLE}),
+		make_lazy_module<plugin_2>(plugin_2_load_count, {"plugin_2", "plugin"}, {PLUGIN_ROLE})
+	});
+
+	QCOMPARE(injector.get_all_with_type_role(PLUGIN_ROLE).size(), size_t{2});
+	QCOMPARE(base_load_count, 0);
+	QCOMPARE(plugin_1_load_count, 1);
+	QCOMPARE(plugin_2_load_count, 1);
+}
+
+QTEST_APPLESS_MAIN(lazy_module_behavior_test)
+#include "lazy-module-behavior-test.moc"
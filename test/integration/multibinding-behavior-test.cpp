@@ -0,0 +1,190 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <algorithm>
+
+class handler : public QObject
+{
+	Q_OBJECT
+
+public:
+	virtual ~handler() {}
+	virtual QString name() const = 0;
+};
+
+class handler_a : public handler
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE handler_a() {}
+	virtual ~handler_a() {}
+	virtual QString name() const override { return QString{"a"}; }
+};
+
+class handler_b : public handler
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE handler_b() {}
+	virtual ~handler_b() {}
+	virtual QString name() const override { return QString{"b"}; }
+};
+
+class not_a_handler : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE not_a_handler() {}
+};
+
+class dispatcher : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE dispatcher() {}
+
+	QList<handler *> handlers;
+
+private slots:
+	INJEQT_SET_ALL void set_handlers(QList<handler *> all_handlers) { handlers = all_handlers; }
+
+};
+
+class unused_interface : public QObject
+{
+	Q_OBJECT
+};
+
+class empty_dispatcher : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE empty_dispatcher() {}
+
+	bool set_called = false;
+	QList<unused_interface *> unused;
+
+private slots:
+	INJEQT_SET_ALL void set_unused(QList<unused_interface *> all_unused) { set_called = true; unused = all_unused; }
+
+};
+
+class multibinding_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private:
+	injeqt::injector create_injector();
+	QStringList names(const QList<handler *> &handlers);
+
+private slots:
+	void should_inject_all_implementations();
+	void should_inject_the_same_objects_as_get();
+	void should_inject_empty_list_when_no_implementations();
+	void should_return_all_implementations();
+	void should_return_nothing_for_type_without_implementations();
+
+};
+
+injeqt::injector multibinding_behavior_test::create_injector()
+{
+	class m : public injeqt::module
+	{
+	public:
+		m()
+		{
+			add_type<handler_a>();
+			add_type<handler_b>();
+			add_type<not_a_handler>();
+			add_type<dispatcher>();
+			add_type<empty_dispatcher>();
+		}
+		virtual ~m() {}
+	};
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<m>{new m{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+QStringList multibinding_behavior_test::names(const QList<handler *> &handlers)
+{
+	auto result = QStringList{};
+	for (auto &&h : handlers)
+		result.append(h->name());
+	result.sort();
+	return result;
+}
+
+void multibinding_behavior_test::should_inject_all_implementations()
+{
+	auto injector = create_injector();
+	auto d = injector.get<dispatcher>();
+
+	QCOMPARE(d->handlers.size(), 2);
+	QCOMPARE(names(d->handlers), (QStringList{"a", "b"}));
+}
+
+void multibinding_behavior_test::should_inject_the_same_objects_as_get()
+{
+	auto injector = create_injector();
+	auto d = injector.get<dispatcher>();
+
+	QVERIFY(d->handlers.contains(injector.get<handler_a>()));
+	QVERIFY(d->handlers.contains(injector.get<handler_b>()));
+}
+
+void multibinding_behavior_test::should_inject_empty_list_when_no_implementations()
+{
+	auto injector = create_injector();
+	auto d = injector.get<empty_dispatcher>();
+
+	QVERIFY(d->set_called);
+	QVERIFY(d->unused.isEmpty());
+}
+
+void multibinding_behavior_test::should_return_all_implementations()
+{
+	auto injector = create_injector();
+	auto handlers = injector.get_all<handler>();
+
+	QCOMPARE(handlers.size(), size_t{2});
+	QVERIFY(std::find(std::begin(handlers), std::end(handlers), injector.get<handler_a>()) != std::end(handlers));
+	QVERIFY(std::find(std::begin(handlers), std::end(handlers), injector.get<handler_b>()) != std::end(handlers));
+}
+
+void multibinding_behavior_test::should_return_nothing_for_type_without_implementations()
+{
+	auto injector = create_injector();
+
+	QVERIFY(injector.get_all<unused_interface>().empty());
+}
+
+QTEST_APPLESS_MAIN(multibinding_behavior_test)
+#include "multibinding-behavior-test.moc"
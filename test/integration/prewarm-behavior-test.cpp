@@ -0,0 +1,240 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/exception/instantiation-failed.h>
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtCore/QThread>
+#include <QtTest/QtTest>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define PREWARM_ROLE "prewarm"
+
+std::atomic<int> slow_service_count{0};
+std::thread::id slow_service_thread;
+std::thread::id second_service_thread;
+
+class fast_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE fast_service() {}
+
+};
+
+class slow_service : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(PREWARM_ROLE)
+
+public:
+	Q_INVOKABLE slow_service()
+	{
+		slow_service_count++;
+		slow_service_thread = std::this_thread::get_id();
+		std::this_thread::sleep_for(std::chrono::milliseconds{100});
+	}
+
+	fast_service *fast = nullptr;
+
+private slots:
+	INJEQT_SET void set_fast_service(fast_service *service) { fast = service; }
+
+};
+
+class second_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE second_service() { second_service_thread = std::this_thread::get_id(); }
+
+};
+
+class failing_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	failing_service() {}
+
+};
+
+class failing_service_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE failing_service_factory() {}
+	Q_INVOKABLE failing_service * create_service() { return nullptr; }
+
+};
+
+class not_configured_service : public QObject
+{
+	Q_OBJECT
+
+};
+
+class prewarm_module : public injeqt::module
+{
+public:
+	prewarm_module()
+	{
+		add_type<fast_service>();
+		add_type<slow_service>();
+		add_type<second_service>();
+		add_type<failing_service_factory>();
+		add_factory<failing_service, failing_service_factory>();
+	}
+	virtual ~prewarm_module() {}
+};
+
+class prewarm_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void should_prewarm_objects_with_dependencies();
+	void should_move_prewarmed_objects_to_caller_thread();
+	void should_not_create_object_twice_when_requested_during_prewarm();
+	void should_prewarm_type_role();
+	void should_use_one_worker_for_many_prewarms();
+	void should_throw_unknown_type_before_prewarm();
+	void should_report_prewarm_errors_in_wait();
+
+private:
+	injeqt::injector create_injector();
+
+};
+
+void prewarm_behavior_test::init()
+{
+	slow_service_count = 0;
+}
+
+injeqt::injector prewarm_behavior_test::create_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new prewarm_module{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+void prewarm_behavior_test::should_prewarm_objects_with_dependencies()
+{
+	auto injector = create_injector();
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<slow_service>()});
+	injector.wait_for_prewarm();
+
+	QCOMPARE(slow_service_count.load(), 1);
+	auto slow = injector.get<slow_service>();
+	QCOMPARE(slow->fast, injector.get<fast_service>());
+	QCOMPARE(slow_service_count.load(), 1);
+}
+
+void prewarm_behavior_test::should_move_prewarmed_objects_to_caller_thread()
+{
+	auto injector = create_injector();
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<slow_service>()});
+	injector.wait_for_prewarm();
+
+	QCOMPARE(injector.get<slow_service>()->thread(), QThread::currentThread());
+	QCOMPARE(injector.get<fast_service>()->thread(), QThread::currentThread());
+}
+
+void prewarm_behavior_test::should_not_create_object_twice_when_requested_during_prewarm()
+{
+	auto injector = create_injector();
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<slow_service>()});
+
+	auto slow = injector.get<slow_service>();
+	injector.wait_for_prewarm();
+
+	QVERIFY(slow != nullptr);
+	QCOMPARE(injector.get<slow_service>(), slow);
+	QCOMPARE(slow_service_count.load(), 1);
+}
+
+void prewarm_behavior_test::should_prewarm_type_role()
+{
+	auto injector = create_injector();
+	injector.prewarm_with_type_role(PREWARM_ROLE);
+	injector.wait_for_prewarm();
+
+	QCOMPARE(slow_service_count.load(), 1);
+	QCOMPARE(injector.get_all_with_type_role(PREWARM_ROLE).size(), size_t{1});
+	QCOMPARE(slow_service_count.load(), 1);
+}
+
+void prewarm_behavior_test::should_use_one_worker_for_many_prewarms()
+{
+	auto injector = create_injector();
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<slow_service>()});
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<second_service>()});
+	injector.wait_for_prewarm();
+
+	QVERIFY(slow_service_thread != std::this_thread::get_id());
+	QVERIFY(second_service_thread == slow_service_thread);
+	QCOMPARE(injector.get<second_service>()->thread(), QThread::currentThread());
+}
+
+void prewarm_behavior_test::should_throw_unknown_type_before_prewarm()
+{
+	auto injector = create_injector();
+
+	try
+	{
+		injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<slow_service>(), injeqt::make_type<not_configured_service>()});
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::unknown_type &)
+	{
+	}
+
+	injector.wait_for_prewarm();
+	QCOMPARE(slow_service_count.load(), 0);
+}
+
+void prewarm_behavior_test::should_report_prewarm_errors_in_wait()
+{
+	auto injector = create_injector();
+	injector.prewarm(std::vector<injeqt::type>{injeqt::make_type<failing_service>()});
+
+	try
+	{
+		injector.wait_for_prewarm();
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::instantiation_failed &)
+	{
+	}
+
+	// error is reported only once
+	injector.wait_for_prewarm();
+}
+
+QTEST_APPLESS_MAIN(prewarm_behavior_test)
+#include "prewarm-behavior-test.moc"
@@ -0,0 +1,239 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+int created_count = 0;
+injeqt::injector *current_injector = nullptr;
+
+class service_1 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_1() { created_count++; }
+
+};
+
+class service_2 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_2() { created_count++; }
+
+private slots:
+	INJEQT_SET void set_service_1(service_1 *) {}
+
+};
+
+class service_3 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_3() { created_count++; }
+
+};
+
+class slow_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE slow_service() { std::this_thread::sleep_for(std::chrono::milliseconds{50}); }
+
+};
+
+class nesting_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE nesting_service() {}
+
+private slots:
+	INJEQT_INIT void init() { current_injector->get<slow_service>(); }
+
+};
+
+class services_module : public injeqt::module
+{
+public:
+	services_module()
+	{
+		add_type<service_1>();
+		add_type<service_2>();
+	}
+	virtual ~services_module() {}
+};
+
+class other_services_module : public injeqt::module
+{
+public:
+	other_services_module()
+	{
+		add_type<service_1>();
+		add_type<service_2>();
+		add_type<service_3>();
+	}
+	virtual ~other_services_module() {}
+};
+
+class nesting_services_module : public injeqt::module
+{
+public:
+	nesting_services_module()
+	{
+		add_type<slow_service>();
+		add_type<nesting_service>();
+	}
+	virtual ~nesting_services_module() {}
+};
+
+template<typename M>
+injeqt::injector create_injector()
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new M{}});
+	return injeqt::injector{std::move(modules)};
+}
+
+class profile_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void cleanup();
+	void should_replay_recorded_profile();
+	void should_ignore_missing_profile();
+	void should_ignore_invalid_profile();
+	void should_ignore_stale_profile();
+	void should_not_count_nested_objects_in_cost();
+
+private:
+	QString profile_file_name() const;
+
+};
+
+QString profile_behavior_test::profile_file_name() const
+{
+	return QDir::temp().filePath("injeqt-profile-behavior-test.json");
+}
+
+void profile_behavior_test::init()
+{
+	created_count = 0;
+	QFile::remove(profile_file_name());
+}
+
+void profile_behavior_test::cleanup()
+{
+	QFile::remove(profile_file_name());
+}
+
+void profile_behavior_test::should_replay_recorded_profile()
+{
+	{
+		auto injector = create_injector<services_module>();
+		injector.start_profile_recording();
+		injector.get<service_2>();
+		QVERIFY(injector.save_profile(profile_file_name()));
+	}
+
+	created_count = 0;
+	auto injector = create_injector<services_module>();
+	QVERIFY(injector.replay_profile(profile_file_name()));
+	injector.wait_for_prewarm();
+	QCOMPARE(created_count, 2);
+
+	injector.get<service_2>();
+	QCOMPARE(created_count, 2);
+}
+
+void profile_behavior_test::should_ignore_missing_profile()
+{
+	auto injector = create_injector<services_module>();
+	QVERIFY(!injector.replay_profile(profile_file_name()));
+	injector.wait_for_prewarm();
+	QCOMPARE(created_count, 0);
+}
+
+void profile_behavior_test::should_ignore_invalid_profile()
+{
+	QFile file{profile_file_name()};
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write("{ broken");
+	file.close();
+
+	auto injector = create_injector<services_module>();
+	QVERIFY(!injector.replay_profile(profile_file_name()));
+	QCOMPARE(created_count, 0);
+}
+
+void profile_behavior_test::should_ignore_stale_profile()
+{
+	{
+		auto injector = create_injector<services_module>();
+		injector.start_profile_recording();
+		injector.get<service_2>();
+		QVERIFY(injector.save_profile(profile_file_name()));
+	}
+
+	created_count = 0;
+	auto injector = create_injector<other_services_module>();
+	QVERIFY(!injector.replay_profile(profile_file_name()));
+	injector.wait_for_prewarm();
+	QCOMPARE(created_count, 0);
+}
+
+void profile_behavior_test::should_not_count_nested_objects_in_cost()
+{
+	auto injector = create_injector<nesting_services_module>();
+	current_injector = &injector;
+	injector.start_profile_recording();
+	injector.get<nesting_service>();
+	auto report = injector.analyze_startup();
+	current_injector = nullptr;
+
+	auto cost_of = [&report](const std::string &type_name){
+		auto entry_it = std::find_if(std::begin(report.types), std::end(report.types),
+			[&type_name](const injeqt::startup_report_entry &e){ return e.type_name == type_name; });
+		return entry_it != std::end(report.types) ? entry_it->cost_ns : qint64{-1};
+	};
+
+	auto slow_ns = qint64{50} * 1000 * 1000;
+	QVERIFY(cost_of("slow_service") >= slow_ns);
+	QVERIFY(cost_of("nesting_service") >= 0);
+	QVERIFY(cost_of("nesting_service") < slow_ns);
+	QVERIFY(report.total_ns < 2 * slow_ns);
+}
+
+QTEST_APPLESS_MAIN(profile_behavior_test)
+#include "profile-behavior-test.moc"
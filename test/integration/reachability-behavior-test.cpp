@@ -0,0 +1,205 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/exception/unknown-type.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+
+#define ROOT_ROLE "root"
+
+class service_1 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_1() {}
+
+};
+
+class service_2 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_2() {}
+	service_1 *s1 = nullptr;
+
+private slots:
+	INJEQT_SET void set_service_1(service_1 *service) { s1 = service; }
+
+};
+
+class role_service : public QObject
+{
+	Q_OBJECT
+	INJEQT_TYPE_ROLE(ROOT_ROLE)
+
+public:
+	Q_INVOKABLE role_service() {}
+
+};
+
+class created_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	created_service() {}
+
+};
+
+class created_service_factory : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE created_service * create_service() const { return new created_service{}; }
+
+};
+
+class unused_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE unused_service() {}
+
+};
+
+class not_configured : public QObject
+{
+	Q_OBJECT
+};
+
+class broken_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE broken_service() {}
+
+private slots:
+	INJEQT_SET void set_not_configured(not_configured *) {}
+
+};
+
+class injected_into : public QObject
+{
+	Q_OBJECT
+
+public:
+	created_service *s = nullptr;
+
+private slots:
+	INJEQT_SET void set_created_service(created_service *service) { s = service; }
+
+};
+
+class services_module : public injeqt::module
+{
+public:
+	services_module()
+	{
+		_factory = std::unique_ptr<created_service_factory>(new created_service_factory{});
+		add_type<service_1>();
+		add_type<service_2>();
+		add_type<role_service>();
+		add_factory<created_service, created_service_factory>();
+		add_ready_object<created_service_factory>(_factory.get());
+		add_type<unused_service>();
+		add_type<broken_service>();
+	}
+	virtual ~services_module() {}
+
+private:
+	std::unique_ptr<created_service_factory> _factory;
+
+};
+
+injeqt::injector create_injector(const injeqt::injector_roots &roots)
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new services_module{}});
+	return injeqt::injector{std::move(modules), roots};
+}
+
+class reachability_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_prune_types_not_reachable_from_root_types();
+	void should_keep_types_with_root_roles();
+	void should_keep_dependencies_of_inject_into_types();
+
+};
+
+void reachability_behavior_test::should_prune_types_not_reachable_from_root_types()
+{
+	auto roots = injeqt::injector_roots{};
+	roots.types.push_back(injeqt::make_type<service_2>());
+	auto injector = create_injector(roots);
+
+	auto s2 = injector.get<service_2>();
+	QCOMPARE(s2->s1, injector.get<service_1>());
+
+	auto pruned = injector.pruned_types();
+	QCOMPARE(pruned.size(), size_t{5});
+	QVERIFY(std::find(std::begin(pruned), std::end(pruned), injeqt::make_type<unused_service>()) != std::end(pruned));
+	QVERIFY(std::find(std::begin(pruned), std::end(pruned), injeqt::make_type<broken_service>()) != std::end(pruned));
+
+	try
+	{
+		injector.get<unused_service>();
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::unknown_type &)
+	{
+	}
+}
+
+void reachability_behavior_test::should_keep_types_with_root_roles()
+{
+	auto roots = injeqt::injector_roots{};
+	roots.type_roles.push_back(ROOT_ROLE);
+	auto injector = create_injector(roots);
+
+	QCOMPARE(injector.get_all_with_type_role(ROOT_ROLE).size(), size_t{1});
+	QCOMPARE(injector.pruned_types().size(), size_t{6});
+}
+
+void reachability_behavior_test::should_keep_dependencies_of_inject_into_types()
+{
+	auto roots = injeqt::injector_roots{};
+	roots.inject_into_types.push_back(injeqt::make_type<injected_into>());
+	auto injector = create_injector(roots);
+
+	auto object = injected_into{};
+	injector.inject_into(&object);
+	QVERIFY(object.s != nullptr);
+
+	// factory is required by created_service
+	QCOMPARE(injector.pruned_types().size(), size_t{5});
+}
+
+QTEST_APPLESS_MAIN(reachability_behavior_test)
+#include "reachability-behavior-test.moc"
@@ -0,0 +1,251 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/exception/unresolvable-dependencies.h>
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtTest/QtTest>
+#include <string>
+#include <vector>
+
+int done_count = 0;
+std::vector<std::string> done_order;
+
+class base_service : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE base_service() {}
+
+};
+
+class plugin : public QObject
+{
+	Q_OBJECT
+
+public:
+	virtual ~plugin() {}
+
+};
+
+class plugin_1 : public plugin
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_1() {}
+
+private slots:
+	INJEQT_SET void set_base_service(base_service *) {}
+	INJEQT_DONE void done() { done_count++; done_order.push_back("plugin_1"); }
+
+};
+
+class plugin_registry : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_registry() {}
+	QList<plugin *> plugins;
+
+private slots:
+	INJEQT_SET_ALL void set_plugins(QList<plugin *> all_plugins) { plugins = all_plugins; }
+	INJEQT_DONE void done() { done_count++; done_order.push_back("plugin_registry"); }
+
+};
+
+class plugin_monitor : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_monitor() {}
+
+private slots:
+	INJEQT_SET_ALL void set_plugins(QList<plugin *>) {}
+	INJEQT_SET void set_plugin_registry(plugin_registry *) {}
+	INJEQT_DONE void done() { done_count++; done_order.push_back("plugin_monitor"); }
+
+};
+
+class plugin_user : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE plugin_user() {}
+
+private slots:
+	INJEQT_SET void set_plugin_1(plugin_1 *) {}
+
+};
+
+class core_module : public injeqt::module
+{
+public:
+	core_module()
+	{
+		add_type<base_service>();
+		add_type<plugin_registry>();
+	}
+	virtual ~core_module() {}
+};
+
+class plugin_module : public injeqt::module
+{
+public:
+	plugin_module()
+	{
+		add_type<plugin_1>();
+	}
+	virtual ~plugin_module() {}
+};
+
+class plugin_user_module : public injeqt::module
+{
+public:
+	plugin_user_module()
+	{
+		add_type<plugin_user>();
+	}
+	virtual ~plugin_user_module() {}
+};
+
+class plugin_monitor_module : public injeqt::module
+{
+public:
+	plugin_monitor_module()
+	{
+		add_type<plugin_monitor>();
+	}
+	virtual ~plugin_monitor_module() {}
+};
+
+class remove_module_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_destroy_objects_of_removed_module();
+	void should_keep_unrelated_objects();
+	void should_recreate_dependent_objects();
+	void should_finish_diamond_dependents_before_theirs_dependencies();
+	void should_throw_when_remaining_type_depends_on_removed_type();
+
+private:
+	injeqt::injector create_injector(injeqt::module *&plugins);
+
+};
+
+injeqt::injector remove_module_behavior_test::create_injector(injeqt::module *&plugins)
+{
+	done_count = 0;
+	done_order.clear();
+
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<core_module>{new core_module{}});
+	modules.emplace_back(std::unique_ptr<plugin_module>{new plugin_module{}});
+	plugins = modules.back().get();
+	return injeqt::injector{std::move(modules)};
+}
+
+void remove_module_behavior_test::should_destroy_objects_of_removed_module()
+{
+	auto plugins = static_cast<injeqt::module *>(nullptr);
+	auto injector = create_injector(plugins);
+	auto plugin = QPointer<plugin_1>{injector.get<plugin_1>()};
+
+	injector.remove_module(plugins);
+
+	QVERIFY(plugin.isNull());
+	QCOMPARE(done_count, 1);
+	QVERIFY(injector.get_all<::plugin>().empty());
+}
+
+void remove_module_behavior_test::should_keep_unrelated_objects()
+{
+	auto plugins = static_cast<injeqt::module *>(nullptr);
+	auto injector = create_injector(plugins);
+	auto base = QPointer<base_service>{injector.get<base_service>()};
+	injector.get<plugin_1>();
+
+	injector.remove_module(plugins);
+
+	QVERIFY(!base.isNull());
+	QCOMPARE(injector.get<base_service>(), base.data());
+}
+
+void remove_module_behavior_test::should_recreate_dependent_objects()
+{
+	auto plugins = static_cast<injeqt::module *>(nullptr);
+	auto injector = create_injector(plugins);
+	auto registry = QPointer<plugin_registry>{injector.get<plugin_registry>()};
+	QCOMPARE(registry->plugins.size(), 1);
+
+	injector.remove_module(plugins);
+
+	QVERIFY(registry.isNull());
+	QCOMPARE(done_count, 2);
+	QCOMPARE(injector.get<plugin_registry>()->plugins.size(), 0);
+}
+
+void remove_module_behavior_test::should_finish_diamond_dependents_before_theirs_dependencies()
+{
+	auto plugins = static_cast<injeqt::module *>(nullptr);
+	auto injector = create_injector(plugins);
+	auto monitors = std::vector<std::unique_ptr<injeqt::module>>{};
+	monitors.emplace_back(std::unique_ptr<plugin_monitor_module>{new plugin_monitor_module{}});
+	injector.add_modules(std::move(monitors));
+	injector.get<plugin_monitor>();
+
+	// plugin_monitor depends on plugin_1 directly and through plugin_registry
+	injector.remove_module(plugins);
+
+	QCOMPARE(done_order, (std::vector<std::string>{"plugin_monitor", "plugin_registry", "plugin_1"}));
+}
+
+void remove_module_behavior_test::should_throw_when_remaining_type_depends_on_removed_type()
+{
+	auto plugins = static_cast<injeqt::module *>(nullptr);
+	auto injector = create_injector(plugins);
+	auto users = std::vector<std::unique_ptr<injeqt::module>>{};
+	users.emplace_back(std::unique_ptr<plugin_user_module>{new plugin_user_module{}});
+	injector.add_modules(std::move(users));
+	auto plugin = QPointer<plugin_1>{injector.get<plugin_1>()};
+
+	try
+	{
+		injector.remove_module(plugins);
+		QFAIL("Exception not thrown");
+	}
+	catch (injeqt::exception::unresolvable_dependencies &)
+	{
+	}
+
+	QVERIFY(!plugin.isNull());
+	QCOMPARE(done_count, 0);
+	QVERIFY(injector.get<plugin_user>() != nullptr);
+}
+
+QTEST_APPLESS_MAIN(remove_module_behavior_test)
+#include "remove-module-behavior-test.moc"
@@ -0,0 +1,154 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <injeqt/injector.h>
+#include <injeqt/module.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtTest/QtTest>
+
+class service_1 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_1() {}
+
+};
+
+class service_2 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE service_2() {}
+	service_1 *s1 = nullptr;
+
+private slots:
+	INJEQT_SET void set_service_1(service_1 *service) { s1 = service; }
+
+};
+
+class services_module : public injeqt::module
+{
+public:
+	services_module()
+	{
+		add_type<service_1>();
+		add_type<service_2>();
+	}
+	virtual ~services_module() {}
+};
+
+class only_service_1_module : public injeqt::module
+{
+public:
+	only_service_1_module()
+	{
+		add_type<service_1>();
+	}
+	virtual ~only_service_1_module() {}
+};
+
+template<typename M>
+injeqt::injector create_injector(const QString &cache_file_name)
+{
+	auto modules = std::vector<std::unique_ptr<injeqt::module>>{};
+	modules.emplace_back(std::unique_ptr<injeqt::module>{new M{}});
+	return injeqt::injector{std::move(modules), cache_file_name};
+}
+
+class types_model_cache_behavior_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void cleanup();
+	void should_create_cache_file();
+	void should_use_cache_file();
+	void should_ignore_invalid_cache_file();
+	void should_ignore_stale_cache_file();
+
+private:
+	QString cache_file_name() const;
+
+};
+
+QString types_model_cache_behavior_test::cache_file_name() const
+{
+	return QDir::temp().filePath("injeqt-types-model-cache-behavior-test.bin");
+}
+
+void types_model_cache_behavior_test::init()
+{
+	QFile::remove(cache_file_name());
+}
+
+void types_model_cache_behavior_test::cleanup()
+{
+	QFile::remove(cache_file_name());
+}
+
+void types_model_cache_behavior_test::should_create_cache_file()
+{
+	auto injector = create_injector<services_module>(cache_file_name());
+	QVERIFY(QFile{cache_file_name()}.exists());
+}
+
+void types_model_cache_behavior_test::should_use_cache_file()
+{
+	{
+		auto injector = create_injector<services_module>(cache_file_name());
+	}
+
+	auto injector = create_injector<services_module>(cache_file_name());
+	auto s2 = injector.get<service_2>();
+	QVERIFY(s2->s1 != nullptr);
+	QCOMPARE(s2->s1, injector.get<service_1>());
+}
+
+void types_model_cache_behavior_test::should_ignore_invalid_cache_file()
+{
+	{
+		QFile file{cache_file_name()};
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		file.write("broken");
+	}
+
+	auto injector = create_injector<services_module>(cache_file_name());
+	auto s2 = injector.get<service_2>();
+	QVERIFY(s2->s1 != nullptr);
+}
+
+void types_model_cache_behavior_test::should_ignore_stale_cache_file()
+{
+	{
+		auto injector = create_injector<only_service_1_module>(cache_file_name());
+	}
+
+	auto injector = create_injector<services_module>(cache_file_name());
+	auto s2 = injector.get<service_2>();
+	QVERIFY(s2->s1 != nullptr);
+}
+
+QTEST_APPLESS_MAIN(types_model_cache_behavior_test)
+#include "types-model-cache-behavior-test.moc"
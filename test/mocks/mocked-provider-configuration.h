@@ -35,6 +35,7 @@ public:
 	virtual ~mocked_provider_configuration() {}
 
     virtual std::vector<type> types() const override { return {}; }
+	virtual type provided_type() const override { return type{}; }
 	virtual std::unique_ptr<provider> create_provider(const types_by_name &) const override { return nullptr; }
 
 };
@@ -53,6 +53,8 @@ public:
 
 	virtual bool require_resolving() const override { return true; }
 
+	virtual void reset() override { _object = nullptr; }
+
 	QObject * object() const { return _object; }
 
 private:
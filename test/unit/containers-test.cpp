@@ -0,0 +1,87 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/containers.h"
+
+#include <QtTest/QtTest>
+#include <stdexcept>
+
+using namespace injeqt::internal;
+
+class containers_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_parallel_transform_in_order();
+	void should_parallel_transform_small_input();
+	void should_rethrow_first_exception_from_parallel_transform();
+
+};
+
+void containers_test::should_parallel_transform_in_order()
+{
+	auto source = std::vector<int>{};
+	for (auto i = 0; i < 1000; i++)
+		source.push_back(i);
+
+	auto result = parallel_transform(source, std::function<int(const int &)>{[](const int &x){ return x * 2; }}, 1);
+	QCOMPARE(result.size(), size_t{1000});
+	for (auto i = 0; i < 1000; i++)
+		QCOMPARE(result[i], i * 2);
+}
+
+void containers_test::should_parallel_transform_small_input()
+{
+	auto result = parallel_transform(std::vector<int>{1, 2, 3}, std::function<int(const int &)>{[](const int &x){ return x + 1; }});
+	QCOMPARE(result, (std::vector<int>{2, 3, 4}));
+}
+
+void containers_test::should_rethrow_first_exception_from_parallel_transform()
+{
+	auto source = std::vector<int>{};
+	for (auto i = 0; i < 1000; i++)
+		source.push_back(i);
+
+	auto transform_with_errors = std::function<int(const int &)>{[](const int &x){
+		if (x % 100 == 37)
+			throw std::runtime_error{std::to_string(x)};
+		return x;
+	}};
+
+	for (auto repeat = 0; repeat < 10; repeat++)
+	{
+		try
+		{
+			parallel_transform(source, transform_with_errors, 1);
+			QFAIL("Exception not thrown");
+		}
+		catch (std::runtime_error &e)
+		{
+			QCOMPARE(std::string{e.what()}, std::string{"37"});
+		}
+	}
+}
+
+QTEST_APPLESS_MAIN(containers_test)
+#include "containers-test.moc"
@@ -0,0 +1,195 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include <injeqt/type.h>
+
+#include "internal/dependency-closures.h"
+#include "internal/dependency-graph.h"
+#include "internal/types-by-name.h"
+#include "internal/types-model.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class cycle_1;
+
+class leaf_type : public QObject
+{
+	Q_OBJECT
+};
+
+class cycle_2 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_cycle_1(cycle_1 *) {}
+	INJEQT_SET void set_leaf_type(leaf_type *) {}
+};
+
+class cycle_1 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_cycle_2(cycle_2 *) {}
+};
+
+class chain_type : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_cycle_1(cycle_1 *) {}
+};
+
+class dependency_closures_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_create_empty_node_set();
+	void should_combine_node_sets_word_by_word();
+	void should_return_empty_closure_for_leaf();
+	void should_return_transitive_closure();
+	void should_share_closure_in_cycle();
+	void should_answer_reachability_queries();
+	void should_return_same_closure_for_copies_of_graph();
+
+private:
+	types_model make_model() const;
+	std::vector<type> closure_of(const dependency_graph &graph, const type &t) const;
+
+};
+
+types_model dependency_closures_test::make_model() const
+{
+	auto all_types = std::vector<type>{
+		make_type<chain_type>(),
+		make_type<cycle_1>(),
+		make_type<cycle_2>(),
+		make_type<leaf_type>()
+	};
+	auto known_types = types_by_name{all_types};
+	return make_types_model(known_types, all_types, all_types);
+}
+
+std::vector<type> dependency_closures_test::closure_of(const dependency_graph &graph, const type &t) const
+{
+	auto result = std::vector<type>{};
+	for (auto &&id : graph.closure(graph.find(t)).ids())
+		result.push_back(graph.node_type(id));
+	std::sort(std::begin(result), std::end(result));
+	return result;
+}
+
+void dependency_closures_test::should_create_empty_node_set()
+{
+	auto set = node_set{130};
+
+	QCOMPARE(set.size(), size_t{130});
+	QVERIFY(set.none());
+	QCOMPARE(set.ids(), std::vector<size_t>{});
+}
+
+void dependency_closures_test::should_combine_node_sets_word_by_word()
+{
+	auto set_1 = node_set{130};
+	set_1.set(0);
+	set_1.set(64);
+	set_1.set(129);
+	auto set_2 = node_set{130};
+	set_2.set(64);
+	set_2.set(100);
+
+	QVERIFY(set_1.test(129));
+	QVERIFY(!set_1.test(100));
+	QVERIFY(set_1.intersects(set_2));
+
+	auto sum = set_1;
+	sum |= set_2;
+	QCOMPARE(sum.ids(), (std::vector<size_t>{0, 64, 100, 129}));
+
+	sum.and_not(set_1);
+	QCOMPARE(sum.ids(), std::vector<size_t>{100});
+	QVERIFY(!sum.intersects(set_1));
+}
+
+void dependency_closures_test::should_return_empty_closure_for_leaf()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	QVERIFY(graph.closure(graph.find(make_type<leaf_type>())).none());
+	QVERIFY(!graph.in_cycle(graph.find(make_type<leaf_type>())));
+}
+
+void dependency_closures_test::should_return_transitive_closure()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	auto expected = std::vector<type>{make_type<cycle_1>(), make_type<cycle_2>(), make_type<leaf_type>()};
+	std::sort(std::begin(expected), std::end(expected));
+	QCOMPARE(closure_of(graph, make_type<chain_type>()), expected);
+	QVERIFY(!graph.in_cycle(graph.find(make_type<chain_type>())));
+}
+
+void dependency_closures_test::should_share_closure_in_cycle()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	auto expected = std::vector<type>{make_type<cycle_1>(), make_type<cycle_2>(), make_type<leaf_type>()};
+	std::sort(std::begin(expected), std::end(expected));
+	QCOMPARE(closure_of(graph, make_type<cycle_1>()), expected);
+	QCOMPARE(&graph.closure(graph.find(make_type<cycle_1>())), &graph.closure(graph.find(make_type<cycle_2>())));
+	QVERIFY(graph.in_cycle(graph.find(make_type<cycle_1>())));
+	QVERIFY(graph.in_cycle(graph.find(make_type<cycle_2>())));
+}
+
+void dependency_closures_test::should_answer_reachability_queries()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	auto chain = graph.find(make_type<chain_type>());
+	auto leaf = graph.find(make_type<leaf_type>());
+	QVERIFY(graph.depends_on(chain, leaf));
+	QVERIFY(!graph.depends_on(leaf, chain));
+	QVERIFY(!graph.depends_on(chain, chain));
+}
+
+void dependency_closures_test::should_return_same_closure_for_copies_of_graph()
+{
+	auto model = make_model();
+	auto graph = model.graph();
+
+	auto &closure = graph.closure(graph.find(make_type<chain_type>()));
+	QCOMPARE(&model.graph().closure(model.graph().find(make_type<chain_type>())), &closure);
+}
+
+QTEST_APPLESS_MAIN(dependency_closures_test)
+#include "dependency-closures-test.moc"
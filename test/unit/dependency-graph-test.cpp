@@ -0,0 +1,158 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include <injeqt/type.h>
+
+#include "internal/dependency-graph.h"
+#include "internal/types-by-name.h"
+#include "internal/types-model.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_1_subtype_1 : public type_1
+{
+	Q_OBJECT
+};
+
+class type_1_subtype_2 : public type_1
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_1_subtype_1(type_1_subtype_1 *) {}
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET_ALL void set_type_1(QList<type_1 *>) {}
+	INJEQT_SET void set_type_2(type_2 *) {}
+};
+
+class dependency_graph_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_be_empty_after_default_construction();
+	void should_contain_node_for_each_implementation_type();
+	void should_map_dependencies_to_implementation_types();
+	void should_add_edge_for_each_implementation_of_set_all_dependency();
+
+private:
+	types_model make_model() const;
+	std::vector<type> targets_of(const dependency_graph &graph, const type &t) const;
+
+};
+
+types_model dependency_graph_test::make_model() const
+{
+	auto all_types = std::vector<type>{
+		make_type<type_1_subtype_1>(),
+		make_type<type_1_subtype_2>(),
+		make_type<type_2>(),
+		make_type<type_3>()
+	};
+	auto known = all_types;
+	known.push_back(make_type<type_1>());
+	auto known_types = types_by_name{known};
+	return make_types_model(known_types, all_types, all_types);
+}
+
+std::vector<type> dependency_graph_test::targets_of(const dependency_graph &graph, const type &t) const
+{
+	auto result = std::vector<type>{};
+	for (auto &&id : graph.targets_of(graph.find(t)))
+		result.push_back(graph.node_type(id));
+	std::sort(std::begin(result), std::end(result));
+	return result;
+}
+
+void dependency_graph_test::should_be_empty_after_default_construction()
+{
+	auto graph = dependency_graph{};
+
+	QCOMPARE(graph.size(), size_t{0});
+	QCOMPARE(graph.find(make_type<type_1>()), size_t{0});
+}
+
+void dependency_graph_test::should_contain_node_for_each_implementation_type()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	QCOMPARE(graph.size(), size_t{4});
+	for (auto &&t : {make_type<type_1_subtype_1>(), make_type<type_1_subtype_2>(), make_type<type_2>(), make_type<type_3>()})
+	{
+		QVERIFY(graph.find(t) < graph.size());
+		QCOMPARE(graph.node_type(graph.find(t)), t);
+	}
+	QCOMPARE(graph.find(make_type<type_1>()), graph.size());
+}
+
+void dependency_graph_test::should_map_dependencies_to_implementation_types()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	QCOMPARE(targets_of(graph, make_type<type_1_subtype_1>()), std::vector<type>{});
+	QCOMPARE(targets_of(graph, make_type<type_2>()), std::vector<type>{make_type<type_1_subtype_1>()});
+
+	auto setters = graph.setters_of(graph.find(make_type<type_2>()));
+	QCOMPARE(setters.size(), size_t{1});
+	QCOMPARE(setters.begin()->parameter_type(), make_type<type_1_subtype_1>());
+}
+
+void dependency_graph_test::should_add_edge_for_each_implementation_of_set_all_dependency()
+{
+	auto model = make_model();
+	auto &graph = model.graph();
+
+	auto expected = std::vector<type>{make_type<type_1_subtype_1>(), make_type<type_1_subtype_2>(), make_type<type_2>()};
+	std::sort(std::begin(expected), std::end(expected));
+	QCOMPARE(targets_of(graph, make_type<type_3>()), expected);
+
+	auto targets = graph.targets_of(graph.find(make_type<type_3>()));
+	auto setters = graph.setters_of(graph.find(make_type<type_3>()));
+	QCOMPARE(setters.size(), targets.size());
+	for (auto i = size_t{0}; i < targets.size(); i++)
+		QCOMPARE(setters.begin()[i].is_all(), graph.node_type(targets.begin()[i]) != make_type<type_2>());
+}
+
+QTEST_APPLESS_MAIN(dependency_graph_test)
+#include "dependency-graph-test.moc"
@@ -0,0 +1,106 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "eytzinger-index.h"
+
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace injeqt::internal;
+
+class eytzinger_index_test : public QObject
+{
+	Q_OBJECT
+
+	static int extract_key(const int &x)
+	{
+		return x;
+	}
+
+private slots:
+	void should_not_be_built_after_construction();
+	void should_return_size_for_empty_data();
+	void should_return_the_same_positions_as_lower_bound();
+	void should_work_with_string_keys();
+	void should_not_be_built_after_clear();
+
+};
+
+void eytzinger_index_test::should_not_be_built_after_construction()
+{
+	auto index = eytzinger_index<int>{};
+	QVERIFY(!index.built());
+}
+
+void eytzinger_index_test::should_return_size_for_empty_data()
+{
+	auto data = std::vector<int>{};
+	auto index = eytzinger_index<int>{};
+	index.build(std::begin(data), std::end(data), extract_key);
+
+	QVERIFY(index.built());
+	QCOMPARE(index.lower_bound(0), size_t{0});
+}
+
+void eytzinger_index_test::should_return_the_same_positions_as_lower_bound()
+{
+	for (auto size = 0; size < 70; size++)
+	{
+		auto data = std::vector<int>{};
+		for (auto i = 0; i < size; i++)
+			data.push_back(2 * i + 1);
+
+		auto index = eytzinger_index<int>{};
+		index.build(std::begin(data), std::end(data), extract_key);
+
+		for (auto k = 0; k <= 2 * size + 1; k++)
+		{
+			auto expected = static_cast<size_t>(std::lower_bound(std::begin(data), std::end(data), k) - std::begin(data));
+			QCOMPARE(index.lower_bound(k), expected);
+		}
+	}
+}
+
+void eytzinger_index_test::should_work_with_string_keys()
+{
+	auto data = std::vector<std::string>{"a", "c", "e", "g"};
+	auto index = eytzinger_index<std::string>{};
+	index.build(std::begin(data), std::end(data), [](const std::string &s){ return s; });
+
+	QCOMPARE(index.lower_bound("a"), size_t{0});
+	QCOMPARE(index.lower_bound("b"), size_t{1});
+	QCOMPARE(index.lower_bound("g"), size_t{3});
+	QCOMPARE(index.lower_bound("h"), size_t{4});
+}
+
+void eytzinger_index_test::should_not_be_built_after_clear()
+{
+	auto data = std::vector<int>{1, 2, 3};
+	auto index = eytzinger_index<int>{};
+	index.build(std::begin(data), std::end(data), extract_key);
+	index.clear();
+
+	QVERIFY(!index.built());
+}
+
+QTEST_APPLESS_MAIN(eytzinger_index_test)
+#include "eytzinger-index-test.moc"
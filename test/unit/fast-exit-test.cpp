@@ -0,0 +1,74 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/fast-exit.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class not_marked_type : public QObject
+{
+	Q_OBJECT
+};
+
+class marked_type : public not_marked_type
+{
+	Q_OBJECT
+	INJEQT_DONE_ON_FAST_EXIT
+};
+
+class marked_inherited_type : public marked_type
+{
+	Q_OBJECT
+};
+
+class fast_exit_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_require_done_by_default();
+	void should_require_done_when_directly_marked();
+	void should_require_done_when_supertype_is_marked();
+
+};
+
+void fast_exit_test::should_not_require_done_by_default()
+{
+	QVERIFY(!requires_done_on_fast_exit<not_marked_type>());
+}
+
+void fast_exit_test::should_require_done_when_directly_marked()
+{
+	QVERIFY(requires_done_on_fast_exit<marked_type>());
+}
+
+void fast_exit_test::should_require_done_when_supertype_is_marked()
+{
+	QVERIFY(requires_done_on_fast_exit<marked_inherited_type>());
+}
+
+QTEST_APPLESS_MAIN(fast_exit_test)
+#include "fast-exit-test.moc"
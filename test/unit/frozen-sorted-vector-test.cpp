@@ -0,0 +1,116 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "frozen-sorted-vector.h"
+#include "sorted-unique-vector.h"
+
+#include <QtTest/QtTest>
+#include <string>
+
+using namespace injeqt::internal;
+
+class frozen_sorted_vector_test : public QObject
+{
+	Q_OBJECT
+
+	static int extract_key(const int &x)
+	{
+		return x;
+	}
+
+	static std::string extract_key_pair(const std::pair<std::string, int> &x)
+	{
+		return x.first;
+	}
+
+	using suv_int = sorted_unique_vector<int, int, extract_key>;
+	using suv_pair = sorted_unique_vector<std::string, std::pair<std::string, int>, extract_key_pair>;
+	using fsv_int = frozen_sorted_vector<suv_int>;
+	using fsv_pair = frozen_sorted_vector<suv_pair>;
+
+private slots:
+	void should_be_empty_after_default_construction();
+	void should_sort_and_remove_duplicates();
+	void should_find_the_same_items_as_sorted_vector();
+	void should_find_items_with_string_keys();
+	void should_not_change_after_modifying_copy_of_sorted();
+
+};
+
+void frozen_sorted_vector_test::should_be_empty_after_default_construction()
+{
+	auto data = fsv_int{};
+
+	QVERIFY(data.empty());
+	QCOMPARE(data.size(), fsv_int::size_type{0});
+	QVERIFY(!data.contains_key(1));
+	QVERIFY(data.get(1) == end(data));
+}
+
+void frozen_sorted_vector_test::should_sort_and_remove_duplicates()
+{
+	auto data = fsv_int{std::vector<int>{5, 1, 3, 1, 5}};
+
+	QCOMPARE(data.content(), (std::vector<int>{1, 3, 5}));
+	QVERIFY(data.contains(3));
+	QVERIFY(!data.contains(4));
+}
+
+void frozen_sorted_vector_test::should_find_the_same_items_as_sorted_vector()
+{
+	for (auto size = 0; size < 20; size++)
+	{
+		auto values = std::vector<int>{};
+		for (auto i = 0; i < size; i++)
+			values.push_back(2 * i);
+
+		auto sorted = suv_int{values};
+		auto frozen = fsv_int{sorted};
+		for (auto k = -1; k < 2 * size + 1; k++)
+		{
+			QCOMPARE(frozen.contains_key(k), sorted.contains_key(k));
+			QCOMPARE(frozen.get(k) - begin(frozen), sorted.get(k) - begin(sorted));
+		}
+	}
+}
+
+void frozen_sorted_vector_test::should_find_items_with_string_keys()
+{
+	auto data = fsv_pair{std::make_pair(std::string{"b"}, 2), std::make_pair(std::string{"a"}, 1), std::make_pair(std::string{"c"}, 3)};
+
+	QCOMPARE(data.get("a")->second, 1);
+	QCOMPARE(data.get("c")->second, 3);
+	QVERIFY(data.get("d") == end(data));
+	QVERIFY(!data.contains_key(""));
+}
+
+void frozen_sorted_vector_test::should_not_change_after_modifying_copy_of_sorted()
+{
+	auto data = fsv_int{2, 4, 6};
+	auto modified = data.sorted();
+	modified.add(5);
+
+	QVERIFY(!data.contains_key(5));
+	QCOMPARE(data.size(), fsv_int::size_type{3});
+	QVERIFY(fsv_int{modified}.contains_key(5));
+}
+
+QTEST_APPLESS_MAIN(frozen_sorted_vector_test)
+#include "frozen-sorted-vector-test.moc"
@@ -0,0 +1,86 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/implemented-by-all.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_1_subtype_1 : public type_1
+{
+	Q_OBJECT
+};
+
+class type_1_subtype_2 : public type_1
+{
+	Q_OBJECT
+};
+
+class implemented_by_all_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_accept_no_implementations();
+	void should_accept_implemented_by_self_and_subtypes();
+	void should_properly_compare();
+
+};
+
+void implemented_by_all_test::should_accept_no_implementations()
+{
+	auto i = implemented_by_all{make_type<type_1>(), types{}};
+
+	QCOMPARE(make_type<type_1>(), i.interface_type());
+	QCOMPARE(types{}, i.implementation_types());
+}
+
+void implemented_by_all_test::should_accept_implemented_by_self_and_subtypes()
+{
+	auto i = implemented_by_all{make_type<type_1>(), types{make_type<type_1_subtype_2>(), make_type<type_1>(), make_type<type_1_subtype_1>()}};
+
+	QCOMPARE(make_type<type_1>(), i.interface_type());
+	QCOMPARE((types{make_type<type_1>(), make_type<type_1_subtype_1>(), make_type<type_1_subtype_2>()}), i.implementation_types());
+}
+
+void implemented_by_all_test::should_properly_compare()
+{
+	auto iba1a = implemented_by_all{make_type<type_1>(), types{make_type<type_1_subtype_1>()}};
+	auto iba1b = implemented_by_all{make_type<type_1>(), types{make_type<type_1_subtype_1>()}};
+	auto iba2a = implemented_by_all{make_type<type_1>(), types{make_type<type_1_subtype_1>(), make_type<type_1_subtype_2>()}};
+	auto iba2b = implemented_by_all{make_type<type_1>(), types{make_type<type_1_subtype_2>(), make_type<type_1_subtype_1>()}};
+	auto iba3a = implemented_by_all{make_type<type_1_subtype_1>(), types{make_type<type_1_subtype_1>()}};
+	auto iba3b = implemented_by_all{make_type<type_1_subtype_1>(), types{make_type<type_1_subtype_1>()}};
+
+	test_compare<implemented_by_all>({{iba1a, iba1b}, {iba2a, iba2b}, {iba3a, iba3b}});
+}
+
+QTEST_APPLESS_MAIN(implemented_by_all_test)
+#include "implemented-by-all-test.moc"
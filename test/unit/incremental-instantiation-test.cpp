@@ -0,0 +1,194 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/incremental-instantiation.h"
+
+#include <QtTest/QtTest>
+#include <stdexcept>
+#include <thread>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+};
+
+class incremental_instantiation_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_not_be_running_when_empty();
+	void should_run_all_steps_in_order_within_budget();
+	void should_run_one_step_per_slice_when_budget_exceeded();
+	void should_report_error_and_continue_with_next_request();
+	void should_not_call_finished_after_clear();
+	void should_stop_slice_when_step_clears_requests();
+	void should_run_request_added_after_clear_by_step();
+
+};
+
+void incremental_instantiation_test::should_not_be_running_when_empty()
+{
+	auto instantiated = std::vector<type>{};
+	incremental_instantiation i{[&](const type &t){ instantiated.push_back(t); }};
+
+	QVERIFY(!i.is_running());
+	i.run_slice();
+	QVERIFY(instantiated.empty());
+}
+
+void incremental_instantiation_test::should_run_all_steps_in_order_within_budget()
+{
+	auto instantiated = std::vector<type>{};
+	auto finished_count = 0;
+	incremental_instantiation i{[&](const type &t){ instantiated.push_back(t); }};
+
+	i.add(std::vector<type>{make_type<type_1>(), make_type<type_2>(), make_type<type_3>()}, std::chrono::milliseconds{1000},
+		[&](std::exception_ptr error){ QVERIFY(!error); finished_count++; });
+	QVERIFY(i.is_running());
+
+	i.run_slice();
+	QVERIFY(!i.is_running());
+	QCOMPARE(finished_count, 1);
+	QCOMPARE(instantiated, (std::vector<type>{make_type<type_1>(), make_type<type_2>(), make_type<type_3>()}));
+}
+
+void incremental_instantiation_test::should_run_one_step_per_slice_when_budget_exceeded()
+{
+	auto instantiated = std::vector<type>{};
+	auto finished_count = 0;
+	incremental_instantiation i{[&](const type &t){
+		instantiated.push_back(t);
+		std::this_thread::sleep_for(std::chrono::milliseconds{5});
+	}};
+
+	i.add(std::vector<type>{make_type<type_1>(), make_type<type_2>()}, std::chrono::milliseconds{1},
+		[&](std::exception_ptr){ finished_count++; });
+
+	i.run_slice();
+	QCOMPARE(instantiated.size(), size_t{1});
+	QCOMPARE(finished_count, 0);
+
+	i.run_slice();
+	QCOMPARE(instantiated.size(), size_t{2});
+	QCOMPARE(finished_count, 1);
+	QVERIFY(!i.is_running());
+}
+
+void incremental_instantiation_test::should_report_error_and_continue_with_next_request()
+{
+	auto instantiated = std::vector<type>{};
+	auto errors = std::vector<bool>{};
+	incremental_instantiation i{[&](const type &t){
+		if (t == make_type<type_1>())
+			throw std::runtime_error{"type_1"};
+		instantiated.push_back(t);
+	}};
+
+	i.add(std::vector<type>{make_type<type_1>(), make_type<type_2>()}, std::chrono::milliseconds{1000},
+		[&](std::exception_ptr error){ errors.push_back(error != nullptr); });
+	i.add(std::vector<type>{make_type<type_3>()}, std::chrono::milliseconds{1000},
+		[&](std::exception_ptr error){ errors.push_back(error != nullptr); });
+
+	i.run_slice();
+	QCOMPARE(errors, (std::vector<bool>{true, false}));
+	QCOMPARE(instantiated, std::vector<type>{make_type<type_3>()});
+}
+
+void incremental_instantiation_test::should_not_call_finished_after_clear()
+{
+	auto finished_count = 0;
+	incremental_instantiation i{[](const type &){}};
+
+	i.add(std::vector<type>{make_type<type_1>()}, std::chrono::milliseconds{1000}, [&](std::exception_ptr){ finished_count++; });
+	i.clear();
+	i.run_slice();
+
+	QVERIFY(!i.is_running());
+	QCOMPARE(finished_count, 0);
+}
+
+void incremental_instantiation_test::should_stop_slice_when_step_clears_requests()
+{
+	auto instantiated = std::vector<type>{};
+	auto finished_count = 0;
+	auto i = static_cast<incremental_instantiation *>(nullptr);
+	incremental_instantiation instantiation{[&](const type &t){
+		instantiated.push_back(t);
+		if (t == make_type<type_1>())
+			i->clear();
+	}};
+	i = &instantiation;
+
+	instantiation.add(std::vector<type>{make_type<type_1>(), make_type<type_2>()}, std::chrono::milliseconds{1000},
+		[&](std::exception_ptr){ finished_count++; });
+	instantiation.add(std::vector<type>{make_type<type_3>()}, std::chrono::milliseconds{1000},
+		[&](std::exception_ptr){ finished_count++; });
+	instantiation.run_slice();
+
+	QVERIFY(!instantiation.is_running());
+	QCOMPARE(finished_count, 0);
+	QCOMPARE(instantiated, std::vector<type>{make_type<type_1>()});
+}
+
+void incremental_instantiation_test::should_run_request_added_after_clear_by_step()
+{
+	auto instantiated = std::vector<type>{};
+	auto finished_count = 0;
+	auto i = static_cast<incremental_instantiation *>(nullptr);
+	incremental_instantiation instantiation{[&](const type &t){
+		instantiated.push_back(t);
+		if (t == make_type<type_1>())
+		{
+			i->clear();
+			i->add(std::vector<type>{make_type<type_3>()}, std::chrono::milliseconds{1000}, [&](std::exception_ptr){ finished_count++; });
+		}
+	}};
+	i = &instantiation;
+
+	instantiation.add(std::vector<type>{make_type<type_1>(), make_type<type_2>()}, std::chrono::milliseconds{1000},
+		[&](std::exception_ptr){ finished_count++; });
+	instantiation.run_slice();
+	QVERIFY(instantiation.is_running());
+
+	instantiation.run_slice();
+	QVERIFY(!instantiation.is_running());
+	QCOMPARE(finished_count, 1);
+	QCOMPARE(instantiated, (std::vector<type>{make_type<type_1>(), make_type<type_3>()}));
+}
+
+QTEST_GUILESS_MAIN(incremental_instantiation_test)
+#include "incremental-instantiation-test.moc"
@@ -0,0 +1,133 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/action-method.h"
+#include "internal/injection-plan.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class injected_type : public QObject
+{
+	Q_OBJECT
+
+public:
+	type_1 *_1 = nullptr;
+	type_2 *_2 = nullptr;
+	bool set_before_init = false;
+	int init_count = 0;
+
+public slots:
+	INJEQT_SET void setter_1(type_1 *a) { _1 = a; }
+	INJEQT_SET void setter_2(type_2 *a) { _2 = a; }
+	INJEQT_INIT void init() { set_before_init = _1 && _2; init_count++; }
+
+};
+
+class injection_plan_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_create_empty_plan();
+	void should_apply_setters_before_init_actions();
+	void should_apply_on_many_objects();
+
+private:
+	injection_plan make_plan(QObject *object_1, QObject *object_2);
+
+};
+
+injection_plan injection_plan_test::make_plan(QObject *object_1, QObject *object_2)
+{
+	auto resolved_1 = resolved_dependency{implementation{make_type<type_1>(), object_1}, make_test_setter_method<injected_type, type_1>("setter_1(type_1*)")};
+	auto resolved_2 = resolved_dependency{implementation{make_type<type_2>(), object_2}, make_test_setter_method<injected_type, type_2>("setter_2(type_2*)")};
+
+	return injection_plan{make_type<injected_type>(), std::vector<resolved_dependency>{resolved_1, resolved_2},
+		std::vector<resolved_all_dependency>{}, extract_actions("INJEQT_INIT", make_type<injected_type>())};
+}
+
+void injection_plan_test::should_create_empty_plan()
+{
+	auto plan = injection_plan{};
+
+	QVERIFY(plan.object_type().is_empty());
+	QVERIFY(plan.resolved_dependencies().empty());
+	QVERIFY(plan.resolved_all_dependencies().empty());
+	QVERIFY(plan.init_actions().empty());
+}
+
+void injection_plan_test::should_apply_setters_before_init_actions()
+{
+	auto object_1 = make_object<type_1>();
+	auto object_2 = make_object<type_2>();
+	auto apply_on_object = make_object<injected_type>();
+	auto plan = make_plan(object_1.get(), object_2.get());
+
+	QCOMPARE(make_type<injected_type>(), plan.object_type());
+	QCOMPARE(plan.resolved_dependencies().size(), size_t{2});
+	QCOMPARE(plan.init_actions().size(), size_t{1});
+
+	plan.apply_on(apply_on_object.get());
+
+	auto injected = static_cast<injected_type *>(apply_on_object.get());
+	QCOMPARE(object_1.get(), injected->_1);
+	QCOMPARE(object_2.get(), injected->_2);
+	QVERIFY(injected->set_before_init);
+	QCOMPARE(1, injected->init_count);
+}
+
+void injection_plan_test::should_apply_on_many_objects()
+{
+	auto object_1 = make_object<type_1>();
+	auto object_2 = make_object<type_2>();
+	auto apply_on_object_a = make_object<injected_type>();
+	auto apply_on_object_b = make_object<injected_type>();
+	auto plan = make_plan(object_1.get(), object_2.get());
+
+	plan.apply_on(apply_on_object_a.get());
+	plan.apply_on(apply_on_object_b.get());
+
+	for (auto &&apply_on_object : {apply_on_object_a.get(), apply_on_object_b.get()})
+	{
+		auto injected = static_cast<injected_type *>(apply_on_object);
+		QCOMPARE(object_1.get(), injected->_1);
+		QCOMPARE(object_2.get(), injected->_2);
+		QCOMPARE(1, injected->init_count);
+	}
+}
+
+QTEST_APPLESS_MAIN(injection_plan_test)
+#include "injection-plan-test.moc"
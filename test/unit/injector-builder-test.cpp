@@ -0,0 +1,166 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include <injeqt/module.h>
+
+#include "internal/injector-builder.h"
+#include "internal/provider.h"
+#include "internal/provider-configuration.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE type_1() {}
+
+};
+
+class type_1_subtype_1 : public type_1
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE type_1_subtype_1() {}
+
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE type_2() {}
+
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+
+public:
+	Q_INVOKABLE type_3() {}
+
+private slots:
+	INJEQT_SET void set_type_2(type_2 *) {}
+
+};
+
+class module_1 : public module
+{
+public:
+	module_1()
+	{
+		add_type<type_1_subtype_1>();
+	}
+	virtual ~module_1() {}
+};
+
+class module_2 : public module
+{
+public:
+	module_2()
+	{
+		add_type<type_2>();
+		add_type<type_3>();
+	}
+	virtual ~module_2() {}
+};
+
+class injector_builder_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_collect_configurations_of_all_modules();
+	void should_create_known_types_with_interfaces();
+	void should_create_providers_in_order();
+	void should_prune_unreachable_configurations();
+
+private:
+	std::vector<std::unique_ptr<module>> make_modules() const;
+
+};
+
+std::vector<std::unique_ptr<module>> injector_builder_test::make_modules() const
+{
+	auto result = std::vector<std::unique_ptr<module>>{};
+	result.emplace_back(std::unique_ptr<module>{new module_1{}});
+	result.emplace_back(std::unique_ptr<module>{new module_2{}});
+	return result;
+}
+
+void injector_builder_test::should_collect_configurations_of_all_modules()
+{
+	auto modules = make_modules();
+	injector_builder builder{modules};
+
+	QCOMPARE(builder.configurations().size(), size_t{3});
+	QCOMPARE(builder.configurations()[0]->provided_type(), make_type<type_1_subtype_1>());
+	QCOMPARE(builder.configurations()[1]->provided_type(), make_type<type_2>());
+	QCOMPARE(builder.configurations()[2]->provided_type(), make_type<type_3>());
+}
+
+void injector_builder_test::should_create_known_types_with_interfaces()
+{
+	auto modules = make_modules();
+	injector_builder builder{modules};
+	auto known_types = builder.known_types();
+
+	QCOMPARE(known_types.size(), size_t{4});
+	QVERIFY(known_types.contains_key("type_1"));
+	QVERIFY(known_types.contains_key("type_1_subtype_1"));
+	QVERIFY(known_types.contains_key("type_2"));
+	QVERIFY(known_types.contains_key("type_3"));
+}
+
+void injector_builder_test::should_create_providers_in_order()
+{
+	auto modules = make_modules();
+	injector_builder builder{modules};
+	auto providers = builder.create_providers(builder.known_types());
+
+	QCOMPARE(providers.size(), size_t{3});
+	QCOMPARE(providers[0]->provided_type(), make_type<type_1_subtype_1>());
+	QCOMPARE(providers[1]->provided_type(), make_type<type_2>());
+	QCOMPARE(providers[2]->provided_type(), make_type<type_3>());
+}
+
+void injector_builder_test::should_prune_unreachable_configurations()
+{
+	auto modules = make_modules();
+	injector_builder builder{modules};
+	auto pruned = builder.prune(std::vector<std::string>{"type_3"}, std::vector<std::string>{});
+
+	QCOMPARE(pruned, std::vector<type>{make_type<type_1_subtype_1>()});
+	QCOMPARE(builder.configurations().size(), size_t{2});
+	QCOMPARE(builder.known_types().size(), size_t{2});
+}
+
+QTEST_APPLESS_MAIN(injector_builder_test)
+#include "injector-builder-test.moc"
@@ -169,6 +169,13 @@ private slots:
 	void should_accept_dependencies_that_are_required();
 	void should_inject_into_unregistered_type();
 	void should_not_inject_into_when_unknown_dependencies();
+	void should_keep_old_configuration_snapshot_after_add_providers();
+	void should_keep_old_configuration_snapshot_after_remove_providers();
+	void should_return_ready_object_only_after_publishing();
+	void should_keep_ready_objects_in_new_snapshot();
+	void should_defer_dependency_validation_in_lazy_mode();
+	void should_defer_required_types_validation_in_lazy_mode();
+	void should_validate_dependencies_of_requested_type_in_lazy_mode();
 	// TODO: https://github.com/vogel/injeqt/issues/3
 	/*
 		void should_not_accept_cyclic_required_types();
@@ -485,6 +492,126 @@ void injector_core_test::should_not_inject_into_when_unknown_dependencies()
 	});
 }
 
+void injector_core_test::should_keep_old_configuration_snapshot_after_add_providers()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_1>());
+
+	auto i = injector_core{types_by_name{make_type<type_1>()}, std::move(configuration)};
+	auto old_snapshot = i.configuration();
+
+	auto new_providers = std::vector<std::unique_ptr<provider>>{};
+	new_providers.push_back(make_mocked_provider<type_3>());
+	i.add_providers(types_by_name{std::vector<type>{make_type<type_1>(), make_type<type_3>()}}, std::move(new_providers));
+
+	auto new_snapshot = i.configuration();
+	QVERIFY(old_snapshot != new_snapshot);
+	QVERIFY(!old_snapshot->model.contains(make_type<type_3>()));
+	QVERIFY(!old_snapshot->known_types.contains_key("type_3"));
+	QCOMPARE(old_snapshot->provided_types.size(), size_t{1});
+	QVERIFY(new_snapshot->model.contains(make_type<type_3>()));
+	QVERIFY(new_snapshot->known_types.contains_key("type_3"));
+	QCOMPARE(new_snapshot->provided_types.size(), size_t{2});
+}
+
+void injector_core_test::should_keep_old_configuration_snapshot_after_remove_providers()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_1>());
+	configuration.push_back(make_mocked_provider<type_3>());
+
+	auto i = injector_core{types_by_name{std::vector<type>{make_type<type_1>(), make_type<type_3>()}}, std::move(configuration)};
+	auto old_snapshot = i.configuration();
+
+	i.remove_providers(std::vector<type>{make_type<type_3>()});
+
+	QVERIFY(old_snapshot->model.contains(make_type<type_3>()));
+	QCOMPARE(old_snapshot->provided_types.size(), size_t{2});
+	QVERIFY(!i.configuration()->model.contains(make_type<type_3>()));
+	QCOMPARE(i.provided_types(), std::vector<type>{make_type<type_1>()});
+}
+
+void injector_core_test::should_return_ready_object_only_after_publishing()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_1>());
+
+	auto i = injector_core{types_by_name{make_type<type_1>()}, std::move(configuration)};
+	QVERIFY(i.ready_object(make_type<type_1>()) == nullptr);
+
+	auto o = get<type_1>(i);
+	QVERIFY(i.ready_object(make_type<type_1>()) == nullptr);
+
+	i.publish_new_objects();
+	QCOMPARE(i.ready_object(make_type<type_1>()), static_cast<QObject *>(o));
+}
+
+void injector_core_test::should_keep_ready_objects_in_new_snapshot()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_1>());
+
+	auto i = injector_core{types_by_name{make_type<type_1>()}, std::move(configuration)};
+	auto o = get<type_1>(i);
+	i.publish_new_objects();
+
+	auto new_providers = std::vector<std::unique_ptr<provider>>{};
+	new_providers.push_back(make_mocked_provider<type_3>());
+	i.add_providers(types_by_name{std::vector<type>{make_type<type_1>(), make_type<type_3>()}}, std::move(new_providers));
+
+	QCOMPARE(i.ready_object(make_type<type_1>()), static_cast<QObject *>(o));
+	QVERIFY(i.ready_object(make_type<type_3>()) == nullptr);
+}
+
+void injector_core_test::should_defer_dependency_validation_in_lazy_mode()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_2>());
+	configuration.push_back(make_mocked_provider<type_3>());
+
+	auto i = injector_core{types_by_name{std::vector<type>{make_type<type_2>(), make_type<type_3>()}}, std::move(configuration),
+		QString{}, validation_mode::lazy};
+	QVERIFY(get<type_3>(i) != nullptr);
+
+	expect<exception::invalid_setter>({"set_type_1"}, [&](){
+		get<type_2>(i);
+	});
+}
+
+void injector_core_test::should_defer_required_types_validation_in_lazy_mode()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_3, type_1>());
+	configuration.push_back(make_mocked_provider<type_7>());
+
+	auto i = injector_core{types_by_name{std::vector<type>{make_type<type_3>(), make_type<type_7>()}}, std::move(configuration),
+		QString{}, validation_mode::lazy};
+	QVERIFY(get<type_7>(i) != nullptr);
+
+	expect<exception::unavailable_required_types>({"type_1"}, [&](){
+		get<type_3>(i);
+	});
+}
+
+void injector_core_test::should_validate_dependencies_of_requested_type_in_lazy_mode()
+{
+	auto configuration = std::vector<std::unique_ptr<provider>>{};
+	configuration.push_back(make_mocked_provider<type_7>());
+	configuration.push_back(make_mocked_provider<type_8>());
+	configuration.push_back(make_mocked_provider<type_9>());
+
+	auto i = injector_core{types_by_name{std::vector<type>{make_type<type_7>(), make_type<type_8>(), make_type<type_9>()}}, std::move(configuration),
+		QString{}, validation_mode::lazy};
+	QVERIFY(i.configuration()->model.mapped_dependencies().empty());
+
+	auto o9 = get<type_9>(i);
+	QVERIFY(o9->o7 == get<type_7>(i));
+	QVERIFY(o9->o8 == get<type_8>(i));
+	QVERIFY(i.configuration()->validated_types.contains_key(make_type<type_7>()));
+	QVERIFY(i.configuration()->validated_types.contains_key(make_type<type_8>()));
+	QVERIFY(i.configuration()->validated_types.contains_key(make_type<type_9>()));
+}
+
 // TODO: https://github.com/vogel/injeqt/issues/3
 /*
 void injector_core_test::should_not_accept_cyclic_required_types()
@@ -0,0 +1,207 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/instantiation-profile.h"
+
+#include <QtTest/QtTest>
+#include <map>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_1(type_1 *) {}
+
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_4 : public QObject
+{
+	Q_OBJECT
+};
+
+class instantiation_profile_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_create_empty_profile();
+	void should_record_build_and_init();
+	void should_ignore_init_without_build();
+	void should_sum_costs_of_repeated_type();
+	void should_serialize_and_deserialize();
+	void should_return_empty_profile_for_invalid_json();
+	void should_change_signature_with_types();
+	void should_order_by_critical_path();
+	void should_follow_provider_required_types_in_critical_path();
+	void should_break_cycles_in_critical_path_where_walk_enters_them();
+
+};
+
+void instantiation_profile_test::should_create_empty_profile()
+{
+	auto p = instantiation_profile{};
+	QVERIFY(p.is_empty());
+	QCOMPARE(p.cost_of("type_1"), qint64{0});
+}
+
+void instantiation_profile_test::should_record_build_and_init()
+{
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_build(make_type<type_2>(), 20);
+	p.add_init(make_type<type_1>(), 5);
+
+	QCOMPARE(p.timings().size(), size_t{2});
+	QCOMPARE(p.timings()[0].type_name, std::string{"type_1"});
+	QCOMPARE(p.timings()[1].type_name, std::string{"type_2"});
+	QCOMPARE(p.cost_of("type_1"), qint64{15});
+	QCOMPARE(p.cost_of("type_2"), qint64{20});
+}
+
+void instantiation_profile_test::should_ignore_init_without_build()
+{
+	auto p = instantiation_profile{};
+	p.add_init(make_type<type_1>(), 5);
+
+	QVERIFY(p.is_empty());
+}
+
+void instantiation_profile_test::should_sum_costs_of_repeated_type()
+{
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_init(make_type<type_1>(), 5);
+	p.add_build(make_type<type_2>(), 20);
+	p.add_build(make_type<type_1>(), 7);
+	p.add_init(make_type<type_1>(), 1);
+
+	QCOMPARE(p.timings().size(), size_t{3});
+	QCOMPARE(p.timings()[0].init_ns, qint64{5});
+	QCOMPARE(p.timings()[2].init_ns, qint64{1});
+	QCOMPARE(p.cost_of("type_1"), qint64{23});
+
+	auto read = instantiation_profile{QByteArray{}, p.timings()};
+	QCOMPARE(read.cost_of("type_1"), qint64{23});
+	QCOMPARE(read.cost_of("type_2"), qint64{20});
+}
+
+void instantiation_profile_test::should_serialize_and_deserialize()
+{
+	auto p = instantiation_profile{make_profile_signature(std::vector<type>{make_type<type_1>()}), std::vector<type_timing>{}};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_init(make_type<type_1>(), 5);
+	p.add_build(make_type<type_2>(), 20);
+
+	auto read = instantiation_profile::from_json(p.to_json());
+	QCOMPARE(read.signature(), p.signature());
+	QCOMPARE(read.timings().size(), size_t{2});
+	QCOMPARE(read.timings()[0].type_name, std::string{"type_1"});
+	QCOMPARE(read.timings()[0].build_ns, qint64{10});
+	QCOMPARE(read.timings()[0].init_ns, qint64{5});
+	QCOMPARE(read.timings()[1].type_name, std::string{"type_2"});
+	QCOMPARE(read.timings()[1].build_ns, qint64{20});
+}
+
+void instantiation_profile_test::should_return_empty_profile_for_invalid_json()
+{
+	QVERIFY(instantiation_profile::from_json("").is_empty());
+	QVERIFY(instantiation_profile::from_json("not a json").is_empty());
+	QVERIFY(instantiation_profile::from_json("{\"version\":999,\"types\":[{\"type\":\"type_1\"}]}").is_empty());
+	QVERIFY(instantiation_profile::from_json("{\"version\":1,\"types\":[{\"build_ns\":1}]}").is_empty());
+}
+
+void instantiation_profile_test::should_change_signature_with_types()
+{
+	auto signature_1 = make_profile_signature(std::vector<type>{make_type<type_1>(), make_type<type_2>()});
+	auto signature_2 = make_profile_signature(std::vector<type>{make_type<type_2>(), make_type<type_1>()});
+	auto signature_3 = make_profile_signature(std::vector<type>{make_type<type_1>(), make_type<type_3>()});
+
+	QCOMPARE(signature_1, signature_2);
+	QVERIFY(signature_1 != signature_3);
+}
+
+void instantiation_profile_test::should_order_by_critical_path()
+{
+	auto all_types = std::vector<type>{make_type<type_1>(), make_type<type_2>(), make_type<type_3>()};
+	auto dependencies = std::map<type, std::vector<type>>{};
+	dependencies[make_type<type_2>()] = std::vector<type>{make_type<type_1>()};
+
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_build(make_type<type_2>(), 5);
+	p.add_build(make_type<type_3>(), 12);
+
+	QCOMPARE(critical_path_weights(all_types, dependencies, p), (std::vector<qint64>{10, 15, 12}));
+	QCOMPARE(critical_path_order(all_types, dependencies, p), (std::vector<type>{make_type<type_2>(), make_type<type_3>(), make_type<type_1>()}));
+}
+
+void instantiation_profile_test::should_follow_provider_required_types_in_critical_path()
+{
+	// type_4 is created by factory of type_3, which depends on type_1
+	auto all_types = std::vector<type>{make_type<type_1>(), make_type<type_3>(), make_type<type_4>()};
+	auto dependencies = std::map<type, std::vector<type>>{};
+	dependencies[make_type<type_3>()] = std::vector<type>{make_type<type_1>()};
+	dependencies[make_type<type_4>()] = std::vector<type>{make_type<type_3>()};
+
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_build(make_type<type_3>(), 5);
+	p.add_build(make_type<type_4>(), 1);
+
+	QCOMPARE(critical_path_weights(all_types, dependencies, p), (std::vector<qint64>{10, 15, 16}));
+	QCOMPARE(critical_path_order(all_types, dependencies, p), (std::vector<type>{make_type<type_4>(), make_type<type_3>(), make_type<type_1>()}));
+}
+
+void instantiation_profile_test::should_break_cycles_in_critical_path_where_walk_enters_them()
+{
+	auto all_types = std::vector<type>{make_type<type_1>(), make_type<type_3>(), make_type<type_4>()};
+	auto dependencies = std::map<type, std::vector<type>>{};
+	dependencies[make_type<type_1>()] = std::vector<type>{make_type<type_3>()};
+	dependencies[make_type<type_3>()] = std::vector<type>{make_type<type_4>()};
+	dependencies[make_type<type_4>()] = std::vector<type>{make_type<type_1>()};
+
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_build(make_type<type_3>(), 5);
+	p.add_build(make_type<type_4>(), 1);
+
+	// walk enters cycle at type_1, so edge from type_4 back to type_1 counts as 0
+	QCOMPARE(critical_path_weights(all_types, dependencies, p), (std::vector<qint64>{16, 6, 1}));
+}
+
+QTEST_APPLESS_MAIN(instantiation_profile_test)
+#include "instantiation-profile-test.moc"
@@ -0,0 +1,114 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../mocks/mocked-provider.h"
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/providers.h"
+
+#include <QtTest/QtTest>
+#include <memory>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+};
+
+class provider_entry_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_store_provider_metadata();
+	void should_keep_metadata_after_move();
+	void should_sort_providers_by_provided_type();
+	void should_release_provider();
+
+};
+
+void provider_entry_test::should_store_provider_metadata()
+{
+	auto p = make_mocked_provider<type_1, type_2, type_3>();
+	auto provider = p.get();
+	auto entry = provider_entry{std::move(p)};
+
+	QCOMPARE(entry.provided_type(), make_type<type_1>());
+	QCOMPARE(entry.required_types(), (types{make_type<type_2>(), make_type<type_3>()}));
+	QCOMPARE(entry.require_resolving(), true);
+	QCOMPARE(entry.get(), provider);
+}
+
+void provider_entry_test::should_keep_metadata_after_move()
+{
+	auto p = make_mocked_provider<type_1, type_2>();
+	auto provider = p.get();
+	auto entries = std::vector<provider_entry>{};
+	entries.emplace_back(std::move(p));
+	entries.emplace_back(make_mocked_provider<type_2>());
+	entries.emplace_back(make_mocked_provider<type_3>());
+
+	QCOMPARE(entries[0].provided_type(), make_type<type_1>());
+	QCOMPARE(entries[0].required_types(), types{make_type<type_2>()});
+	QCOMPARE(entries[0].get(), provider);
+}
+
+void provider_entry_test::should_sort_providers_by_provided_type()
+{
+	auto all_providers = std::vector<std::unique_ptr<provider>>{};
+	all_providers.push_back(make_mocked_provider<type_3>());
+	all_providers.push_back(make_mocked_provider<type_1>());
+	all_providers.push_back(make_mocked_provider<type_2>());
+	auto p = make_providers(std::move(all_providers));
+
+	QCOMPARE(p.size(), size_t{3});
+	QVERIFY(p.contains_key(make_type<type_1>()));
+	QVERIFY(p.contains_key(make_type<type_2>()));
+	QVERIFY(p.contains_key(make_type<type_3>()));
+	QCOMPARE(p.get(make_type<type_2>())->provided_type(), make_type<type_2>());
+}
+
+void provider_entry_test::should_release_provider()
+{
+	auto p = make_mocked_provider<type_1>();
+	auto provider = std::unique_ptr<mocked_provider>{};
+	auto entry = provider_entry{std::move(p)};
+	provider.reset(static_cast<mocked_provider *>(entry.release()));
+
+	QVERIFY(entry.get() == nullptr);
+	QCOMPARE(provider->provided_type(), make_type<type_1>());
+	QCOMPARE(entry.provided_type(), make_type<type_1>());
+}
+
+QTEST_APPLESS_MAIN(provider_entry_test)
+#include "provider-entry-test.moc"
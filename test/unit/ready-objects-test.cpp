@@ -0,0 +1,100 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "internal/ready-objects.h"
+
+#include <QtTest/QtTest>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace injeqt::internal;
+
+class ready_objects_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_create_empty_slots();
+	void should_return_stored_objects();
+	void should_read_objects_stored_by_other_thread();
+
+};
+
+void ready_objects_test::should_create_empty_slots()
+{
+	ready_objects objects{3};
+
+	QCOMPARE(objects.size(), size_t{3});
+	QVERIFY(objects.get(0) == nullptr);
+	QVERIFY(objects.get(1) == nullptr);
+	QVERIFY(objects.get(2) == nullptr);
+}
+
+void ready_objects_test::should_return_stored_objects()
+{
+	auto object_1 = std::unique_ptr<QObject>{new QObject{}};
+	auto object_2 = std::unique_ptr<QObject>{new QObject{}};
+	ready_objects objects{3};
+
+	objects.set(0, object_1.get());
+	objects.set(2, object_2.get());
+
+	QCOMPARE(objects.get(0), object_1.get());
+	QVERIFY(objects.get(1) == nullptr);
+	QCOMPARE(objects.get(2), object_2.get());
+}
+
+void ready_objects_test::should_read_objects_stored_by_other_thread()
+{
+	auto stored = std::vector<std::unique_ptr<QObject>>{};
+	for (auto i = 0; i < 64; i++)
+		stored.emplace_back(new QObject{});
+	ready_objects objects{stored.size()};
+
+	auto writer = std::thread{[&](){
+		for (auto i = size_t{0}; i < stored.size(); i++)
+		{
+			stored[i]->setObjectName(QString::number(i));
+			objects.set(i, stored[i].get());
+		}
+	}};
+
+	// each object is read either as nullptr or fully prepared by writer
+	auto found = size_t{0};
+	while (found < stored.size())
+	{
+		found = 0;
+		for (auto i = size_t{0}; i < objects.size(); i++)
+		{
+			auto object = objects.get(i);
+			if (!object)
+				continue;
+
+			QCOMPARE(object->objectName(), QString::number(i));
+			found++;
+		}
+	}
+
+	writer.join();
+}
+
+QTEST_APPLESS_MAIN(ready_objects_test)
+#include "ready-objects-test.moc"
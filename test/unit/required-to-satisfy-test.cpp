@@ -128,6 +128,8 @@ private slots:
 	void should_return_all_types_with_cyclic_dependnecies_for_simple_model_with_partial_implementations();
 	void should_return_all_subtypes_with_cyclic_dependnecies_for_inheriting_model_with_partial_implementations();
 	void should_return_type_when_supertype_is_already_available();
+	void should_not_return_dependencies_of_available_types();
+	void should_not_return_types_marked_ready();
 
 private:
 	types_by_name known_types;
@@ -213,13 +215,13 @@ required_to_satisfy_test::required_to_satisfy_test() :
 
 void required_to_satisfy_test::should_return_nothing_when_empty_dependencies()
 {
-	auto result = required_to_satisfy(dependencies{}, simple_types_model, {});
+	auto result = required_to_satisfy(dependencies{}, simple_types_model, ready_nodes(simple_types_model, {}));
 	QCOMPARE(result, types{});
 }
 
 void required_to_satisfy_test::should_return_dependencies_for_simple_model_with_empty_implementations()
 {
-	auto result = required_to_satisfy(type_2_dependencies, simple_types_model, {});
+	auto result = required_to_satisfy(type_2_dependencies, simple_types_model, ready_nodes(simple_types_model, {}));
 	QCOMPARE(result, (types{type_1_type}));
 }
 
@@ -230,13 +232,13 @@ void required_to_satisfy_test::should_return_nothing_for_simple_model_with_full_
 	{
 		implementation{type_1_type, type_1_object.get()}
 	};
-	auto result = required_to_satisfy(type_2_dependencies, simple_types_model, available_implementations);
+	auto result = required_to_satisfy(type_2_dependencies, simple_types_model, ready_nodes(simple_types_model, available_implementations));
 	QCOMPARE(result, (types{}));
 }
 
 void required_to_satisfy_test::should_return_subtype_dependencies_for_inheriting_model_with_empty_implementations()
 {
-	auto result = required_to_satisfy(type_2_dependencies, inheriting_types_model, {});
+	auto result = required_to_satisfy(type_2_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, {}));
 	QCOMPARE(result, (types{type_1_subtype_1_type}));
 }
 
@@ -247,7 +249,7 @@ void required_to_satisfy_test::should_return_nothing_for_inheriting_model_with_f
 	{
 		implementation{type_1_subtype_1_type, type_1_subtype_1_object.get()}
 	};
-	auto result = required_to_satisfy(type_2_dependencies, inheriting_types_model, available_implementations);
+	auto result = required_to_satisfy(type_2_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, available_implementations));
 	QCOMPARE(result, (types{}));
 }
 
@@ -258,13 +260,13 @@ void required_to_satisfy_test::should_return_dependencies_for_inheriting_model_w
 	{
 		implementation{type_1_type, type_1_object.get()}
 	};
-	auto result = required_to_satisfy(type_2_dependencies, inheriting_types_model, available_implementations);
+	auto result = required_to_satisfy(type_2_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, available_implementations));
 	QCOMPARE(result, (types{type_1_subtype_1_type}));
 }
 
 void required_to_satisfy_test::should_return_all_dependencies_for_simple_model_with_empty_implementations()
 {
-	auto result = required_to_satisfy(type_3_dependencies, simple_types_model, {});
+	auto result = required_to_satisfy(type_3_dependencies, simple_types_model, ready_nodes(simple_types_model, {}));
 	QCOMPARE(result, (types{type_1_type, type_2_type}));
 }
 
@@ -276,31 +278,31 @@ void required_to_satisfy_test::should_return_partial_dependencies_for_simple_mod
 		implementation{type_1_type, type_1_object.get()}
 	};
 
-	auto result = required_to_satisfy(type_3_dependencies, simple_types_model, available_implementations);
+	auto result = required_to_satisfy(type_3_dependencies, simple_types_model, ready_nodes(simple_types_model, available_implementations));
 	QCOMPARE(result, (types{type_2_type}));
 }
 
 void required_to_satisfy_test::should_return_all_types_with_cyclic_dependnecies_for_simple_model_with_partial_implementations()
 {
-	auto result1 = required_to_satisfy(cyclic_type_1_dependencies, simple_types_model, {});
+	auto result1 = required_to_satisfy(cyclic_type_1_dependencies, simple_types_model, ready_nodes(simple_types_model, {}));
 	QCOMPARE(result1, (types{cyclic_type_1_type, cyclic_type_2_type, cyclic_type_3_type}));
 
-	auto result2 = required_to_satisfy(cyclic_type_2_dependencies, simple_types_model, {});
+	auto result2 = required_to_satisfy(cyclic_type_2_dependencies, simple_types_model, ready_nodes(simple_types_model, {}));
 	QCOMPARE(result2, (types{cyclic_type_1_type, cyclic_type_2_type, cyclic_type_3_type}));
 
-	auto result3 = required_to_satisfy(cyclic_type_3_dependencies, simple_types_model, {});
+	auto result3 = required_to_satisfy(cyclic_type_3_dependencies, simple_types_model, ready_nodes(simple_types_model, {}));
 	QCOMPARE(result3, (types{cyclic_type_1_type, cyclic_type_2_type, cyclic_type_3_type}));
 }
 
 void required_to_satisfy_test::should_return_all_subtypes_with_cyclic_dependnecies_for_inheriting_model_with_partial_implementations()
 {
-	auto result1 = required_to_satisfy(cyclic_type_1_dependencies, inheriting_types_model, {});
+	auto result1 = required_to_satisfy(cyclic_type_1_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, {}));
 	QCOMPARE(result1, (types{cyclic_type_1_subtype_1_type, cyclic_type_2_subtype_1_type, cyclic_type_3_subtype_1_type}));
 
-	auto result2 = required_to_satisfy(cyclic_type_2_dependencies, inheriting_types_model, {});
+	auto result2 = required_to_satisfy(cyclic_type_2_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, {}));
 	QCOMPARE(result2, (types{cyclic_type_1_subtype_1_type, cyclic_type_2_subtype_1_type, cyclic_type_3_subtype_1_type}));
 
-	auto result3 = required_to_satisfy(cyclic_type_3_dependencies, inheriting_types_model, {});
+	auto result3 = required_to_satisfy(cyclic_type_3_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, {}));
 	QCOMPARE(result3, (types{cyclic_type_1_subtype_1_type, cyclic_type_2_subtype_1_type, cyclic_type_3_subtype_1_type}));
 }
 
@@ -312,10 +314,34 @@ void required_to_satisfy_test::should_return_type_when_supertype_is_already_avai
 		implementation{type_1_type, type_1_object.get()},
 	};
 
-	auto result = required_to_satisfy(type_1_subtype_1_dependencies, inheriting_types_model, available_implementations);
+	auto result = required_to_satisfy(type_1_subtype_1_dependencies, inheriting_types_model, ready_nodes(inheriting_types_model, available_implementations));
 	QCOMPARE(result, (types{}));
 }
 
+void required_to_satisfy_test::should_not_return_dependencies_of_available_types()
+{
+	auto type_1_object = make_object<type_1>();
+	auto type_2_object = make_object<type_2>();
+	auto available_implementations = implementations
+	{
+		implementation{type_1_type, type_1_object.get()},
+		implementation{type_2_type, type_2_object.get()}
+	};
+
+	auto result = required_to_satisfy(type_3_dependencies, simple_types_model, ready_nodes(simple_types_model, available_implementations));
+	QCOMPARE(result, (types{}));
+}
+
+void required_to_satisfy_test::should_not_return_types_marked_ready()
+{
+	auto type_1_object = make_object<type_1>();
+	auto ready = ready_nodes(simple_types_model, {});
+
+	mark_ready(ready, simple_types_model, std::vector<implementation>{implementation{type_1_type, type_1_object.get()}});
+	auto result = required_to_satisfy(type_3_dependencies, simple_types_model, ready);
+	QCOMPARE(result, (types{type_2_type}));
+}
+
 QTEST_APPLESS_MAIN(required_to_satisfy_test);
 
 #include "required-to-satisfy-test.moc"
@@ -50,6 +50,7 @@ class test_type : public QObject
 
 public:
 	injectable_type1 *_1 = nullptr;
+	QList<injectable_type1 *> _all;
 
 	test_type() {}
 
@@ -61,6 +62,7 @@ public:
 public slots:
 	INJEQT_SET void tagged_setter_slot_1(injectable_type1 *a) { _1 = a; }
 	INJEQT_SETTER void tagged_setter_slot_2(injectable_type1 *a) { _1 = a; }
+	INJEQT_SET_ALL void tagged_setter_all_slot(QList<injectable_type1 *> a) { _all = a; }
 	INJEQT_SETTER void invalid_setter_multi_arguments(injectable_type1 *, injectable_type2 *) { }
 	INVALID_SETTER_TAG void invalid_setter_invalid_tag(injectable_type1 *) { }
 	void invalid_setter_no_tag(injectable_type1 *) { }
@@ -85,6 +87,7 @@ private slots:
 	void should_create_valid_from_tagged_setter_method();
 	void should_create_valid_from_tagged_setter_slot();
 	void should_invoke_have_results();
+	void should_invoke_set_all_with_list_of_objects();
 	void should_throw_when_empty_method();
 	void should_throw_when_multiple_arguments();
 	void should_throw_when_invalid_tag();
@@ -147,6 +150,24 @@ void setter_method_test::should_invoke_have_results()
 	QCOMPARE(with.get(), static_cast<test_type *>(on.get())->_1);
 }
 
+void setter_method_test::should_invoke_set_all_with_list_of_objects()
+{
+	auto setter = make_setter_method(_known_types, get_method<test_type>("tagged_setter_all_slot(QList<injectable_type1*>)"));
+	QVERIFY(setter.is_all());
+
+	auto on = make_object<test_type>();
+	auto with_1 = make_object<injectable_type1>();
+	auto with_2 = make_object<injectable_type1>();
+	auto list = setter.make_parameter_list(std::vector<QObject *>{with_1.get(), with_2.get()});
+	QCOMPARE(list.size(), 2);
+
+	setter.invoke(on.get(), list);
+	auto &all = static_cast<test_type *>(on.get())->_all;
+	QCOMPARE(all.size(), 2);
+	QCOMPARE(static_cast<QObject *>(all.at(0)), with_1.get());
+	QCOMPARE(static_cast<QObject *>(all.at(1)), with_2.get());
+}
+
 void setter_method_test::should_throw_when_empty_method()
 {
 	expect<exception::invalid_setter>({"setter does not have enclosing meta object"}, [&]{
@@ -0,0 +1,165 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "small-vector.h"
+
+#include <QtTest/QtTest>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace injeqt::internal;
+
+class small_vector_test : public QObject
+{
+	Q_OBJECT
+
+	using small_vector_int = small_vector<int, 4>;
+
+private slots:
+	void should_be_empty_and_inline_after_default_construction();
+	void should_keep_items_inline_up_to_capacity();
+	void should_move_items_to_heap_after_exceeding_capacity();
+	void should_insert_items_in_the_middle();
+	void should_erase_items();
+	void should_copy_items();
+	void should_move_inline_items();
+	void should_move_heap_items_without_copying();
+	void should_store_move_only_items();
+	void should_convert_from_vector();
+	void should_be_nothrow_movable();
+
+};
+
+void small_vector_test::should_be_empty_and_inline_after_default_construction()
+{
+	auto data = small_vector_int{};
+
+	QVERIFY(data.empty());
+	QVERIFY(data.is_inline());
+	QCOMPARE(data.capacity(), size_t{4});
+}
+
+void small_vector_test::should_keep_items_inline_up_to_capacity()
+{
+	auto data = small_vector_int{1, 2, 3, 4};
+
+	QCOMPARE(data.size(), size_t{4});
+	QVERIFY(data.is_inline());
+	QCOMPARE(std::vector<int>(std::begin(data), std::end(data)), (std::vector<int>{1, 2, 3, 4}));
+}
+
+void small_vector_test::should_move_items_to_heap_after_exceeding_capacity()
+{
+	auto data = small_vector_int{1, 2, 3, 4};
+	data.push_back(5);
+
+	QCOMPARE(data.size(), size_t{5});
+	QVERIFY(!data.is_inline());
+	QVERIFY(data.capacity() >= 5);
+	QCOMPARE(std::vector<int>(std::begin(data), std::end(data)), (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+void small_vector_test::should_insert_items_in_the_middle()
+{
+	auto data = small_vector_int{1, 4};
+	data.emplace(std::begin(data) + 1, 3);
+	data.emplace(std::begin(data) + 1, 2);
+	auto values = std::vector<int>{5, 6};
+	data.insert(std::end(data), std::begin(values), std::end(values));
+	data.insert(std::begin(data), std::begin(values), std::begin(values) + 1);
+
+	QCOMPARE(std::vector<int>(std::begin(data), std::end(data)), (std::vector<int>{5, 1, 2, 3, 4, 5, 6}));
+}
+
+void small_vector_test::should_erase_items()
+{
+	auto data = small_vector_int{1, 2, 3, 4, 5};
+	data.erase(std::begin(data) + 1, std::begin(data) + 3);
+	data.erase(std::begin(data));
+
+	QCOMPARE(std::vector<int>(std::begin(data), std::end(data)), (std::vector<int>{4, 5}));
+}
+
+void small_vector_test::should_copy_items()
+{
+	auto data = small_vector<std::string, 2>{"a", "b", "c"};
+	auto copy = data;
+	auto assigned = small_vector<std::string, 2>{"d"};
+	assigned = data;
+
+	QVERIFY(copy == data);
+	QVERIFY(assigned == data);
+	QCOMPARE(data.size(), size_t{3});
+}
+
+void small_vector_test::should_move_inline_items()
+{
+	auto data = small_vector<std::string, 2>{"a", "b"};
+	auto moved = std::move(data);
+
+	QVERIFY(data.empty());
+	QVERIFY(moved.is_inline());
+	QVERIFY(moved == (small_vector<std::string, 2>{"a", "b"}));
+}
+
+void small_vector_test::should_move_heap_items_without_copying()
+{
+	auto data = small_vector_int{1, 2, 3, 4, 5};
+	auto items = data.data();
+	auto moved = std::move(data);
+
+	QVERIFY(data.empty());
+	QVERIFY(data.is_inline());
+	QCOMPARE(moved.data(), items);
+	QCOMPARE(moved.size(), size_t{5});
+}
+
+void small_vector_test::should_store_move_only_items()
+{
+	auto data = small_vector<std::unique_ptr<int>, 2>{};
+	for (auto i = 0; i < 5; i++)
+		data.emplace_back(new int{i});
+	data.emplace(std::begin(data), new int{-1});
+
+	QCOMPARE(data.size(), size_t{6});
+	QCOMPARE(*data[0], -1);
+	QCOMPARE(*data[5], 4);
+}
+
+void small_vector_test::should_convert_from_vector()
+{
+	auto data = small_vector_int{std::vector<int>{3, 2, 1}};
+
+	QVERIFY(data.is_inline());
+	QCOMPARE(std::vector<int>(std::begin(data), std::end(data)), (std::vector<int>{3, 2, 1}));
+}
+
+void small_vector_test::should_be_nothrow_movable()
+{
+	// std::vector moves items on reallocation only if that can not throw
+	QVERIFY(std::is_nothrow_move_constructible<small_vector_int>::value);
+	QVERIFY(std::is_nothrow_move_assignable<small_vector_int>::value);
+	QVERIFY((std::is_nothrow_move_constructible<small_vector<std::unique_ptr<int>, 2>>::value));
+}
+
+QTEST_APPLESS_MAIN(small_vector_test)
+#include "small-vector-test.moc"
@@ -21,6 +21,7 @@
 #include "sorted-unique-vector.h"
 
 #include <QtTest/QtTest>
+#include <memory>
 
 using namespace injeqt::internal;
 
@@ -38,8 +39,14 @@ class sorted_unique_vector_test : public QObject
 		return x.first;
 	}
 
+	static int extract_key_pointer(const std::unique_ptr<int> &x)
+	{
+		return *x;
+	}
+
 	using suv_int = sorted_unique_vector<int, int, extract_key>;
 	using suv_pair = sorted_unique_vector<int, std::pair<int, std::string>, extract_key_pair>;
+	using suv_pointer = sorted_unique_vector<int, std::unique_ptr<int>, extract_key_pointer>;
 
 private slots:
 	void should_be_empty_after_default_construction();
@@ -50,6 +57,7 @@ private slots:
 	void should_be_valid_after_conversion_from_non_unique_vector();
 	void should_be_valid_after_conversion_from_unique_sorted_vector();
 	void should_be_valid_after_conversion_from_non_unique_sorted_vector();
+	void should_keep_content_after_conversion_from_already_sorted_unique_vector();
 	void should_be_valid_after_adding_less_than_smallest_element();
 	void should_be_valid_after_adding_smallest_element();
 	void should_be_valid_after_adding_medium_element();
@@ -62,12 +70,19 @@ private slots:
 	void should_be_valid_after_merging_misc_unique_elements();
 	void should_be_valid_after_merging_greater_or_equal_elements();
 	void should_be_valid_after_merging_greater_elements();
+	void should_keep_existing_items_after_merging_duplicates();
+	void should_keep_existing_items_after_moving_duplicates();
+	void should_be_valid_after_merging_move_only_elements();
+	void should_be_valid_after_adding_all_unsorted_elements();
+	void should_not_reallocate_merge_after_reserve();
 	void should_match_return_nothing_for_two_empty_vectors();
 	void should_match_return_only_unresolved_for_first_empty_vector();
 	void should_match_return_only_unresolved_for_second_empty_vector();
 	void should_match_return_only_unresolved_for_non_matching_vectors();
 	void should_match_return_only_resolved_for_matching_vectors();
 	void should_match_return_valid_data_for_partially_matching_vectors();
+	void should_match_visit_report_items_in_order();
+	void should_match_visit_use_given_key_extractors();
 	void should_return_false_for_contains_when_empty();
 	void should_return_false_for_contains_when_does_not_contain();
 	void should_return_true_for_contains_when_contains();
@@ -75,6 +90,7 @@ private slots:
 	void should_return_false_for_contains_key_when_empty();
 	void should_return_false_for_contains_when_does_not_contain_key();
 	void should_return_true_for_contains_when_contains_key();
+	void should_be_as_small_as_storage();
 
 };
 
@@ -129,6 +145,15 @@ void sorted_unique_vector_test::should_be_valid_after_conversion_from_unique_vec
 	QCOMPARE(data.content(), (std::vector<int>{1, 2, 4, 5}));
 }
 
+void sorted_unique_vector_test::should_keep_content_after_conversion_from_already_sorted_unique_vector()
+{
+	auto data = suv_int{already_sorted_unique, std::vector<int>{1, 2, 4, 5}};
+
+	QVERIFY(!data.empty());
+	QCOMPARE(data.size(), size_t{4});
+	QCOMPARE(data.content(), (std::vector<int>{1, 2, 4, 5}));
+}
+
 void sorted_unique_vector_test::should_be_valid_after_conversion_from_non_unique_vector()
 {
 	auto data = suv_int{1, 4, 5, 2, 1, 4, 5, 2};
@@ -282,6 +307,67 @@ void sorted_unique_vector_test::should_be_valid_after_merging_greater_elements()
 	QCOMPARE(data.content(), (std::vector<int>{1, 2, 4, 5, 6, 7}));
 }
 
+void sorted_unique_vector_test::should_keep_existing_items_after_merging_duplicates()
+{
+	auto data = suv_pair{std::make_pair(1, std::string{"a"}), std::make_pair(3, std::string{"a"})};
+	auto data_to_add = suv_pair{std::make_pair(1, std::string{"b"}), std::make_pair(2, std::string{"b"}), std::make_pair(3, std::string{"b"})};
+	data.merge(data_to_add);
+
+	QCOMPARE(data.content(), (std::vector<std::pair<int, std::string>>{
+		std::make_pair(1, std::string{"a"}), std::make_pair(2, std::string{"b"}), std::make_pair(3, std::string{"a"})}));
+	QCOMPARE(data_to_add.size(), size_t{3});
+}
+
+void sorted_unique_vector_test::should_keep_existing_items_after_moving_duplicates()
+{
+	auto data = suv_pair{std::make_pair(2, std::string{"a"}), std::make_pair(4, std::string{"a"})};
+	data.merge(suv_pair{std::make_pair(1, std::string{"b"}), std::make_pair(2, std::string{"b"}), std::make_pair(4, std::string{"b"}), std::make_pair(5, std::string{"b"})});
+
+	QCOMPARE(data.content(), (std::vector<std::pair<int, std::string>>{
+		std::make_pair(1, std::string{"b"}), std::make_pair(2, std::string{"a"}), std::make_pair(4, std::string{"a"}), std::make_pair(5, std::string{"b"})}));
+}
+
+void sorted_unique_vector_test::should_be_valid_after_merging_move_only_elements()
+{
+	auto items = std::vector<std::unique_ptr<int>>{};
+	items.emplace_back(new int{5});
+	items.emplace_back(new int{1});
+	auto data = suv_pointer{std::move(items)};
+
+	auto items_to_add = std::vector<std::unique_ptr<int>>{};
+	items_to_add.emplace_back(new int{3});
+	items_to_add.emplace_back(new int{6});
+	items_to_add.emplace_back(new int{1});
+	data.merge(suv_pointer{std::move(items_to_add)});
+
+	auto keys = std::vector<int>{};
+	for (auto &&item : data)
+		keys.push_back(*item);
+	QCOMPARE(keys, (std::vector<int>{1, 3, 5, 6}));
+}
+
+void sorted_unique_vector_test::should_be_valid_after_adding_all_unsorted_elements()
+{
+	auto data = suv_int{2, 4, 6};
+	data.add_all(std::vector<int>{7, 1, 4, 3, 1});
+
+	QCOMPARE(data.size(), size_t{6});
+	QCOMPARE(data.content(), (std::vector<int>{1, 2, 3, 4, 6, 7}));
+}
+
+void sorted_unique_vector_test::should_not_reallocate_merge_after_reserve()
+{
+	auto data = suv_int{1, 3};
+	data.reserve(6);
+	QVERIFY(data.capacity() >= 6);
+	auto storage = &*std::begin(data);
+
+	data.merge(suv_int{0, 2, 3, 4});
+
+	QCOMPARE(&*std::begin(data), storage);
+	QCOMPARE(data.content(), (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
 void sorted_unique_vector_test::should_match_return_nothing_for_two_empty_vectors()
 {
 	auto result = match(suv_int{}, suv_int{});
@@ -330,6 +416,38 @@ void sorted_unique_vector_test::should_match_return_valid_data_for_partially_mat
 	QCOMPARE(result.unmatched_2.content(), (std::vector<int>{4, 5}));
 }
 
+void sorted_unique_vector_test::should_match_visit_report_items_in_order()
+{
+	auto matched = std::vector<std::pair<int, int>>{};
+	auto unmatched_1 = std::vector<int>{};
+	auto unmatched_2 = std::vector<int>{};
+	match_visit(suv_int{1, 2, 3, 6}, suv_int{2, 3, 4, 5},
+		[&](int x, int y){ matched.emplace_back(x, y); },
+		[&](int x){ unmatched_1.push_back(x); },
+		[&](int x){ unmatched_2.push_back(x); });
+
+	QCOMPARE(matched, (std::vector<std::pair<int, int>>{{2, 2}, {3, 3}}));
+	QCOMPARE(unmatched_1, (std::vector<int>{1, 6}));
+	QCOMPARE(unmatched_2, (std::vector<int>{4, 5}));
+}
+
+void sorted_unique_vector_test::should_match_visit_use_given_key_extractors()
+{
+	auto matched = std::vector<std::pair<std::pair<int, std::string>, int>>{};
+	auto unmatched_1 = std::vector<std::pair<int, std::string>>{};
+	auto left = suv_pair{std::make_pair(1, std::string{"a"}), std::make_pair(2, std::string{"b"})};
+	match_visit(left, suv_int{1, 2}, extract_key_pair, extract_key,
+		[&](const std::pair<int, std::string> &x, int y){ matched.emplace_back(x, y); },
+		[&](const std::pair<int, std::string> &x){ unmatched_1.push_back(x); },
+		ignore_match{},
+		match_increment_mode::left);
+
+	QCOMPARE(matched.size(), size_t{2});
+	QCOMPARE(matched[0].second, 1);
+	QCOMPARE(matched[1].second, 2);
+	QVERIFY(unmatched_1.empty());
+}
+
 void sorted_unique_vector_test::should_return_false_for_contains_when_empty()
 {
 	auto data = suv_pair{};
@@ -373,5 +491,10 @@ void sorted_unique_vector_test::should_return_true_for_contains_when_contains_ke
 }
 
 
+void sorted_unique_vector_test::should_be_as_small_as_storage()
+{
+	QCOMPARE(sizeof(suv_int), sizeof(suv_int::storage_type));
+}
+
 QTEST_APPLESS_MAIN(sorted_unique_vector_test)
 #include "sorted-unique-vector-test.moc"
@@ -0,0 +1,121 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/instantiation-profile.h"
+#include "internal/startup-analysis.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_4 : public QObject
+{
+	Q_OBJECT
+};
+
+class startup_analysis_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_create_empty_report();
+	void should_find_critical_path_and_slack();
+	void should_break_cycles();
+
+};
+
+void startup_analysis_test::should_create_empty_report()
+{
+	auto report = analyze_startup(std::vector<type>{}, std::map<type, std::vector<type>>{}, instantiation_profile{});
+
+	QVERIFY(report.critical_path.empty());
+	QVERIFY(report.types.empty());
+	QCOMPARE(report.critical_path_ns, qint64{0});
+	QCOMPARE(report.total_ns, qint64{0});
+}
+
+void startup_analysis_test::should_find_critical_path_and_slack()
+{
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 10);
+	p.add_build(make_type<type_2>(), 5);
+	p.add_build(make_type<type_3>(), 12);
+	p.add_build(make_type<type_4>(), 2);
+
+	auto all_types = std::vector<type>{make_type<type_1>(), make_type<type_2>(), make_type<type_3>(), make_type<type_4>()};
+	auto dependencies = std::map<type, std::vector<type>>{
+		{make_type<type_2>(), std::vector<type>{make_type<type_1>()}},
+		{make_type<type_4>(), std::vector<type>{make_type<type_1>(), make_type<type_3>()}}
+	};
+	auto report = analyze_startup(all_types, dependencies, p);
+
+	QCOMPARE(report.critical_path, (std::vector<std::string>{"type_1", "type_2"}));
+	QCOMPARE(report.critical_path_ns, qint64{15});
+	QCOMPARE(report.total_ns, qint64{29});
+	QCOMPARE(report.types.size(), size_t{4});
+	QCOMPARE(report.types[0].type_name, std::string{"type_1"});
+	QCOMPARE(report.types[0].earliest_finish_ns, qint64{10});
+	QCOMPARE(report.types[0].slack_ns, qint64{0});
+	QCOMPARE(report.types[1].earliest_finish_ns, qint64{15});
+	QCOMPARE(report.types[1].slack_ns, qint64{0});
+	QCOMPARE(report.types[2].cost_ns, qint64{12});
+	QCOMPARE(report.types[2].slack_ns, qint64{1});
+	QCOMPARE(report.types[3].earliest_finish_ns, qint64{14});
+	QCOMPARE(report.types[3].slack_ns, qint64{1});
+}
+
+void startup_analysis_test::should_break_cycles()
+{
+	auto p = instantiation_profile{};
+	p.add_build(make_type<type_1>(), 1);
+	p.add_build(make_type<type_2>(), 2);
+
+	auto all_types = std::vector<type>{make_type<type_1>(), make_type<type_2>()};
+	auto dependencies = std::map<type, std::vector<type>>{
+		{make_type<type_1>(), std::vector<type>{make_type<type_2>()}},
+		{make_type<type_2>(), std::vector<type>{make_type<type_1>()}}
+	};
+	auto report = analyze_startup(all_types, dependencies, p);
+
+	QCOMPARE(report.critical_path_ns, qint64{3});
+	QCOMPARE(report.critical_path.size(), size_t{2});
+}
+
+QTEST_APPLESS_MAIN(startup_analysis_test)
+#include "startup-analysis-test.moc"
@@ -0,0 +1,180 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include "internal/type-dependents.h"
+#include "internal/types-model.h"
+
+#include <QtTest/QtTest>
+#include <algorithm>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_1(type_1 *) {}
+
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_2(type_2 *) {}
+
+};
+
+class type_4 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_1(type_1 *) {}
+
+};
+
+class type_5 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_6 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_1(type_1 *) {}
+	INJEQT_SET void set_type_4(type_4 *) {}
+
+};
+
+class type_dependents_test : public QObject
+{
+	Q_OBJECT
+
+public:
+	type_dependents_test();
+
+private slots:
+	void should_create_index_from_dependencies();
+	void should_not_duplicate_dependents();
+	void should_remove_dependents();
+	void should_find_transitive_dependents();
+	void should_find_nothing_more_for_independent_type();
+	void should_list_diamond_dependents_in_topological_order();
+
+private:
+	types_by_name known_types;
+	types_model model;
+
+};
+
+type_dependents_test::type_dependents_test()
+{
+	auto all_types = std::vector<type>{make_type<type_1>(), make_type<type_2>(), make_type<type_3>(), make_type<type_4>(), make_type<type_5>()};
+	known_types = types_by_name{all_types};
+	model = make_types_model(known_types, all_types, all_types);
+}
+
+void type_dependents_test::should_create_index_from_dependencies()
+{
+	auto index = type_dependents{};
+	add_type_dependents(index, model.mapped_dependencies());
+
+	QCOMPARE(index.size(), size_t{2});
+	QCOMPARE(types{index[make_type<type_1>()]}, (types{make_type<type_2>(), make_type<type_4>()}));
+	QCOMPARE(index[make_type<type_2>()], (std::vector<type>{make_type<type_3>()}));
+}
+
+void type_dependents_test::should_not_duplicate_dependents()
+{
+	auto index = type_dependents{};
+	add_type_dependents(index, model.mapped_dependencies());
+	add_type_dependents(index, model.mapped_dependencies());
+	add_type_dependent(index, make_type<type_2>(), make_type<type_3>());
+
+	QCOMPARE(types{index[make_type<type_1>()]}, (types{make_type<type_2>(), make_type<type_4>()}));
+	QCOMPARE(index[make_type<type_2>()], (std::vector<type>{make_type<type_3>()}));
+}
+
+void type_dependents_test::should_remove_dependents()
+{
+	auto index = type_dependents{};
+	add_type_dependents(index, model.mapped_dependencies());
+	remove_type_dependents(index, *model.mapped_dependencies().get(make_type<type_3>()));
+	remove_type_dependent(index, make_type<type_1>(), make_type<type_2>());
+
+	QCOMPARE(index.size(), size_t{1});
+	QCOMPARE(index[make_type<type_1>()], (std::vector<type>{make_type<type_4>()}));
+}
+
+void type_dependents_test::should_find_transitive_dependents()
+{
+	auto index = type_dependents{};
+	add_type_dependents(index, model.mapped_dependencies());
+
+	auto dependents_of_1 = transitive_dependents(index, model, {make_type<type_1>()});
+	QCOMPARE(dependents_of_1.size(), size_t{4});
+	QCOMPARE(dependents_of_1[0], make_type<type_1>());
+	QCOMPARE(types{dependents_of_1}, (types{make_type<type_1>(), make_type<type_2>(), make_type<type_3>(), make_type<type_4>()}));
+	// type_3 depends on type_2, so it is found after it
+	QVERIFY(std::find(std::begin(dependents_of_1), std::end(dependents_of_1), make_type<type_2>())
+		< std::find(std::begin(dependents_of_1), std::end(dependents_of_1), make_type<type_3>()));
+	QCOMPARE(transitive_dependents(index, model, {make_type<type_2>()}),
+		(std::vector<type>{make_type<type_2>(), make_type<type_3>()}));
+}
+
+void type_dependents_test::should_find_nothing_more_for_independent_type()
+{
+	auto index = type_dependents{};
+	add_type_dependents(index, model.mapped_dependencies());
+
+	QCOMPARE(transitive_dependents(index, model, {make_type<type_5>()}), (std::vector<type>{make_type<type_5>()}));
+	QCOMPARE(transitive_dependents(index, model, {make_type<type_3>()}), (std::vector<type>{make_type<type_3>()}));
+}
+
+void type_dependents_test::should_list_diamond_dependents_in_topological_order()
+{
+	auto diamond_types = std::vector<type>{make_type<type_1>(), make_type<type_4>(), make_type<type_6>()};
+	auto diamond_model = make_types_model(types_by_name{diamond_types}, diamond_types, diamond_types);
+
+	// type_6 is registered first, so it is found directly from type_1 before type_4 it depends on
+	auto index = type_dependents{};
+	add_type_dependent(index, make_type<type_1>(), make_type<type_6>());
+	add_type_dependents(index, diamond_model.mapped_dependencies());
+
+	QCOMPARE(transitive_dependents(index, diamond_model, {make_type<type_1>()}),
+		(std::vector<type>{make_type<type_1>(), make_type<type_4>(), make_type<type_6>()}));
+}
+
+QTEST_APPLESS_MAIN(type_dependents_test)
+#include "type-dependents-test.moc"
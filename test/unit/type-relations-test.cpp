@@ -79,6 +79,8 @@ private slots:
 	void should_create_mixed_relations_for_subtypes();
 	void should_create_mixed_relations_for_type_and_subtype();
 	void should_create_mixed_relations_for_subtype_and_type();
+	void should_create_all_relations_for_subtypes();
+	void should_create_all_relations_for_the_same_type();
 
 private:
 	type type_1_type;
@@ -108,6 +110,7 @@ void type_relations_test::should_create_empty_relations()
 
 	QCOMPARE(result.unique(), implemented_by_mapping{});
 	QCOMPARE(result.ambiguous(), types{});
+	QCOMPARE(result.all(), implemented_by_all_mapping{});
 }
 
 void type_relations_test::should_create_empty_relations_for_no_types()
@@ -202,6 +205,30 @@ void type_relations_test::should_create_mixed_relations_for_subtype_and_type()
 	QCOMPARE(result.ambiguous(), types{type_1_type});
 }
 
+void type_relations_test::should_create_all_relations_for_subtypes()
+{
+	auto result = make_type_relations({type_1_sub_1_sub_1_type, type_1_sub_1_sub_2_type, type_2_type});
+
+	QCOMPARE(result.all(), (implemented_by_all_mapping
+	{
+		implemented_by_all{type_1_type, types{type_1_sub_1_sub_1_type, type_1_sub_1_sub_2_type}},
+		implemented_by_all{type_1_sub_1_type, types{type_1_sub_1_sub_1_type, type_1_sub_1_sub_2_type}},
+		implemented_by_all{type_1_sub_1_sub_1_type, types{type_1_sub_1_sub_1_type}},
+		implemented_by_all{type_1_sub_1_sub_2_type, types{type_1_sub_1_sub_2_type}},
+		implemented_by_all{type_2_type, types{type_2_type}}
+	}));
+}
+
+void type_relations_test::should_create_all_relations_for_the_same_type()
+{
+	auto result = make_type_relations({type_1_type, type_1_type});
+
+	QCOMPARE(result.all(), (implemented_by_all_mapping
+	{
+		implemented_by_all{type_1_type, types{type_1_type}}
+	}));
+}
+
 QTEST_APPLESS_MAIN(type_relations_test);
 
 #include "type-relations-test.moc"
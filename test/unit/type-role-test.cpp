@@ -79,6 +79,10 @@ private slots:
 	void should_have_one_role_when_declared_twice();
 	void should_have_two_roles_when_added_in_subtype();
 	void should_have_two_roles_when_directly_declared();
+	void should_extract_no_roles_by_default();
+	void should_extract_one_role_when_declared_in_supertype();
+	void should_extract_one_role_when_declared_twice();
+	void should_extract_two_roles_when_added_in_subtype();
 
 };
 
@@ -118,5 +122,25 @@ void type_role_test::should_have_two_roles_when_directly_declared()
 	QVERIFY(has_type_role<role_1_and_2_type>(ROLE_2));
 }
 
+void type_role_test::should_extract_no_roles_by_default()
+{
+	QVERIFY(extract_type_roles<no_role_type>().empty());
+}
+
+void type_role_test::should_extract_one_role_when_declared_in_supertype()
+{
+	QCOMPARE(extract_type_roles<role_1_inherited_type>(), (std::vector<std::string>{ROLE_1}));
+}
+
+void type_role_test::should_extract_one_role_when_declared_twice()
+{
+	QCOMPARE(extract_type_roles<role_1_double_type>(), (std::vector<std::string>{ROLE_1}));
+}
+
+void type_role_test::should_extract_two_roles_when_added_in_subtype()
+{
+	QCOMPARE(extract_type_roles<role_2_inherited_from_role_1_type>(), (std::vector<std::string>{ROLE_1, ROLE_2}));
+}
+
 QTEST_APPLESS_MAIN(type_role_test)
 #include "type-role-test.moc"
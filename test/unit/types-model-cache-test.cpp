@@ -0,0 +1,204 @@
+/*
+ * %injeqt copyright begin%
+ * Copyright 2016 Rafał Malinowski (rafal.przemyslaw.malinowski@gmail.com)
+ * %injeqt copyright end%
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "expect.h"
+#include "utils.h"
+
+#include <injeqt/type.h>
+
+#include "internal/types-model.h"
+#include "internal/types-model-cache.h"
+
+#include <QtTest/QtTest>
+
+using namespace injeqt::internal;
+using namespace injeqt::v1;
+
+class type_1 : public QObject
+{
+	Q_OBJECT
+};
+
+class type_1_subtype_1 : public type_1
+{
+	Q_OBJECT
+};
+
+class type_2 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET void set_type_1(type_1 *) {}
+
+};
+
+class type_3 : public QObject
+{
+	Q_OBJECT
+
+public slots:
+	INJEQT_SET_ALL void set_type_1(QList<type_1 *>) {}
+
+};
+
+class types_model_cache_test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void should_read_written_model();
+	void should_change_key_with_types();
+	void should_return_empty_model_for_other_key();
+	void should_return_empty_model_for_invalid_data();
+	void should_return_empty_model_for_unknown_type();
+	void should_return_empty_model_for_truncated_data();
+	void should_not_read_corrupted_data_into_invalid_model();
+	void should_return_empty_model_for_data_with_trailing_bytes();
+	void should_return_empty_model_when_tag_was_added_to_cached_slot();
+
+private:
+	std::vector<type> all_types() const;
+	std::vector<type> known_types() const;
+
+};
+
+std::vector<type> types_model_cache_test::all_types() const
+{
+	return std::vector<type>{make_type<type_1_subtype_1>(), make_type<type_2>(), make_type<type_3>()};
+}
+
+std::vector<type> types_model_cache_test::known_types() const
+{
+	return std::vector<type>{make_type<type_1>(), make_type<type_1_subtype_1>(), make_type<type_2>(), make_type<type_3>()};
+}
+
+void types_model_cache_test::should_read_written_model()
+{
+	auto known = types_by_name{known_types()};
+	auto model = make_types_model(known, all_types(), known_types());
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto data = write_types_model_cache(model, key);
+
+	auto read = read_types_model_cache(data.constData(), data.size(), key, known);
+	QCOMPARE(read.available_types(), model.available_types());
+	QCOMPARE(read.all_implementations(), model.all_implementations());
+	QCOMPARE(read.mapped_dependencies(), model.mapped_dependencies());
+}
+
+void types_model_cache_test::should_change_key_with_types()
+{
+	auto key_1 = make_types_model_cache_key(all_types(), known_types());
+	auto key_2 = make_types_model_cache_key(std::vector<type>{make_type<type_1_subtype_1>(), make_type<type_2>()}, known_types());
+	auto key_3 = make_types_model_cache_key(all_types(), std::vector<type>{make_type<type_2>()});
+
+	QCOMPARE(make_types_model_cache_key(all_types(), known_types()), key_1);
+	QVERIFY(key_1 != key_2);
+	QVERIFY(key_1 != key_3);
+}
+
+void types_model_cache_test::should_return_empty_model_for_other_key()
+{
+	auto known = types_by_name{known_types()};
+	auto model = make_types_model(known, all_types(), known_types());
+	auto data = write_types_model_cache(model, make_types_model_cache_key(all_types(), known_types()));
+
+	auto read = read_types_model_cache(data.constData(), data.size(), make_types_model_cache_key(all_types(), std::vector<type>{}), known);
+	QVERIFY(read.available_types().empty());
+}
+
+void types_model_cache_test::should_return_empty_model_for_invalid_data()
+{
+	auto known = types_by_name{known_types()};
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto data = write_types_model_cache(make_types_model(known, all_types(), known_types()), key);
+
+	QVERIFY(read_types_model_cache("", 0, key, known).available_types().empty());
+	QVERIFY(read_types_model_cache("not a cache", 11, key, known).available_types().empty());
+	QVERIFY(read_types_model_cache(data.constData(), data.size() / 2, key, known).available_types().empty());
+}
+
+void types_model_cache_test::should_return_empty_model_for_unknown_type()
+{
+	auto known = types_by_name{known_types()};
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto data = write_types_model_cache(make_types_model(known, all_types(), known_types()), key);
+
+	auto read = read_types_model_cache(data.constData(), data.size(), key, types_by_name{std::vector<type>{make_type<type_2>()}});
+	QVERIFY(read.available_types().empty());
+}
+
+void types_model_cache_test::should_return_empty_model_for_truncated_data()
+{
+	auto known = types_by_name{known_types()};
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto data = write_types_model_cache(make_types_model(known, all_types(), known_types()), key);
+
+	for (auto size = 0; size < data.size(); size++)
+		QVERIFY(read_types_model_cache(data.constData(), size, key, known).available_types().empty());
+}
+
+void types_model_cache_test::should_not_read_corrupted_data_into_invalid_model()
+{
+	auto known = types_by_name{known_types()};
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto model = make_types_model(known, all_types(), known_types());
+	auto data = write_types_model_cache(model, key);
+
+	// any byte changed leads either to empty model or to model with valid relations and setters
+	for (auto i = 0; i < data.size(); i++)
+	{
+		auto corrupted = data;
+		corrupted[i] = static_cast<char>(corrupted[i] ^ 0x5a);
+		auto read = read_types_model_cache(corrupted.constData(), corrupted.size(), key, known);
+		QVERIFY(read.available_types().empty() || read.available_types().size() == model.available_types().size());
+	}
+}
+
+void types_model_cache_test::should_return_empty_model_for_data_with_trailing_bytes()
+{
+	auto known = types_by_name{known_types()};
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto data = write_types_model_cache(make_types_model(known, all_types(), known_types()), key);
+
+	data.append("garbage", 7);
+	QVERIFY(read_types_model_cache(data.constData(), data.size(), key, known).available_types().empty());
+}
+
+void types_model_cache_test::should_return_empty_model_when_tag_was_added_to_cached_slot()
+{
+	auto known = types_by_name{known_types()};
+	auto key = make_types_model_cache_key(all_types(), known_types());
+	auto model = make_types_model(known, all_types(), known_types());
+
+	// cache written when set_type_1 of type_2 was not tagged yet
+	auto stale_dependencies = std::vector<type_dependencies>{};
+	for (auto &&td : model.mapped_dependencies())
+		stale_dependencies.push_back(td.dependent_type() == make_type<type_2>()
+			? type_dependencies{td.dependent_type(), dependencies{}}
+			: td);
+	auto stale_model = types_model{model.available_types().sorted(), types_dependencies{stale_dependencies}, model.all_implementations().sorted()};
+	auto data = write_types_model_cache(stale_model, key);
+
+	QVERIFY(read_types_model_cache(data.constData(), data.size(), key, known).available_types().empty());
+}
+
+QTEST_APPLESS_MAIN(types_model_cache_test)
+#include "types-model-cache-test.moc"
@@ -52,6 +52,11 @@ class type_1_subtype_2_subtype_1 : public type_1_subtype_2
 	Q_OBJECT
 };
 
+class type_1_subtype_2_subtype_2 : public type_1_subtype_2
+{
+	Q_OBJECT
+};
+
 class type_1_subtype_3 : public type_1
 {
 	Q_OBJECT
@@ -77,6 +82,15 @@ private slots:
 	void should_create_with_common_supertype();
 	void should_create_with_dependencies();
 	void should_throw_when_unresolvable_dependency();
+	void should_extend_to_the_same_model_as_created_at_once();
+	void should_extend_with_type_depending_on_existing_types();
+	void should_throw_when_extended_with_subtype_of_configured_type();
+	void should_throw_when_extended_type_has_unresolvable_dependency();
+	void should_throw_when_extension_makes_existing_dependency_ambiguous();
+	void should_share_graph_when_adding_dependencies();
+	void should_throw_when_added_dependency_is_unresolvable();
+	void should_reduce_to_the_same_model_as_created_at_once();
+	void should_make_interface_available_after_reduce();
 
 private:
 	types_by_name known_types;
@@ -84,6 +98,7 @@ private:
 	type type_1_subtype_1_type;
 	type type_1_subtype_2_type;
 	type type_1_subtype_2_subtype_1_type;
+	type type_1_subtype_2_subtype_2_type;
 	type type_1_subtype_3_type;
 
 };
@@ -93,6 +108,7 @@ types_model_test::types_model_test() :
 	type_1_subtype_1_type{make_type<type_1_subtype_1>()},
 	type_1_subtype_2_type{make_type<type_1_subtype_2>()},
 	type_1_subtype_2_subtype_1_type{make_type<type_1_subtype_2_subtype_1>()},
+	type_1_subtype_2_subtype_2_type{make_type<type_1_subtype_2_subtype_2>()},
 	type_1_subtype_3_type{make_type<type_1_subtype_3>()}
 {
 	known_types = types_by_name{std::vector<type>{
@@ -100,6 +116,7 @@ types_model_test::types_model_test() :
 		make_type<type_1_subtype_1>(),
 		make_type<type_1_subtype_2>(), 
 		make_type<type_1_subtype_2_subtype_1>(),
+		make_type<type_1_subtype_2_subtype_2>(),
 		make_type<type_1_subtype_3>()
 	}};
 }
@@ -109,31 +126,31 @@ void types_model_test::should_create_empty_types_model()
 	auto empty_1 = types_model{};
 	auto empty_2 = make_types_model(known_types, std::vector<type>{}, std::vector<type>{});
 
-	QCOMPARE(empty_1.available_types(), implemented_by_mapping{});
-	QCOMPARE(empty_1.mapped_dependencies(), types_dependencies{});
+	QCOMPARE(empty_1.available_types().sorted(), implemented_by_mapping{});
+	QCOMPARE(empty_1.mapped_dependencies().sorted(), types_dependencies{});
 }
 
 void types_model_test::should_create_one_type_types_model()
 {
 	auto m1 = make_types_model(known_types, {type_1_type}, {type_1_type});
 
-	QCOMPARE(m1.available_types(), (implemented_by_mapping
+	QCOMPARE(m1.available_types().sorted(), (implemented_by_mapping
 	{
 		implemented_by{type_1_type, type_1_type}
 	}));
-	QCOMPARE(m1.mapped_dependencies(), (types_dependencies
+	QCOMPARE(m1.mapped_dependencies().sorted(), (types_dependencies
 	{
 		make_type_dependencies(known_types, type_1_type)
 	}));
 
 	auto m2 = make_types_model(known_types, {type_1_subtype_1_type}, {type_1_subtype_1_type});
 
-	QCOMPARE(m2.available_types(), (implemented_by_mapping
+	QCOMPARE(m2.available_types().sorted(), (implemented_by_mapping
 	{
 		implemented_by{type_1_type, type_1_subtype_1_type},
 		implemented_by{type_1_subtype_1_type, type_1_subtype_1_type}
 	}));
-	QCOMPARE(m2.mapped_dependencies(), (types_dependencies
+	QCOMPARE(m2.mapped_dependencies().sorted(), (types_dependencies
 	{
 		make_type_dependencies(known_types, type_1_subtype_1_type)
 	}));
@@ -161,12 +178,12 @@ void types_model_test::should_create_with_common_supertype()
 {
 	auto m = make_types_model(known_types, {type_1_subtype_1_type, type_1_subtype_2_type}, {type_1_subtype_1_type, type_1_subtype_2_type});
 
-	QCOMPARE(m.available_types(), (implemented_by_mapping
+	QCOMPARE(m.available_types().sorted(), (implemented_by_mapping
 	{
 		implemented_by{type_1_subtype_1_type, type_1_subtype_1_type},
 		implemented_by{type_1_subtype_2_type, type_1_subtype_2_type}
 	}));
-	QCOMPARE(m.mapped_dependencies(), (types_dependencies
+	QCOMPARE(m.mapped_dependencies().sorted(), (types_dependencies
 	{
 		make_type_dependencies(known_types, type_1_subtype_1_type),
 		make_type_dependencies(known_types, type_1_subtype_2_type)
@@ -179,13 +196,13 @@ void types_model_test::should_create_with_dependencies()
 		{type_1_subtype_1_type, type_1_subtype_2_type, type_1_subtype_3_type},
 		{type_1_subtype_1_type, type_1_subtype_2_type, type_1_subtype_3_type});
 
-	QCOMPARE(m1.available_types(), (implemented_by_mapping
+	QCOMPARE(m1.available_types().sorted(), (implemented_by_mapping
 	{
 		implemented_by{type_1_subtype_1_type, type_1_subtype_1_type},
 		implemented_by{type_1_subtype_2_type, type_1_subtype_2_type},
 		implemented_by{type_1_subtype_3_type, type_1_subtype_3_type}
 	}));
-	QCOMPARE(m1.mapped_dependencies(), (types_dependencies
+	QCOMPARE(m1.mapped_dependencies().sorted(), (types_dependencies
 	{
 		make_type_dependencies(known_types, type_1_subtype_1_type),
 		make_type_dependencies(known_types, type_1_subtype_2_type),
@@ -196,14 +213,14 @@ void types_model_test::should_create_with_dependencies()
 		{type_1_subtype_1_type, type_1_subtype_2_subtype_1_type, type_1_subtype_3_type},
 		{type_1_subtype_1_type, type_1_subtype_2_subtype_1_type, type_1_subtype_3_type});
 
-	QCOMPARE(m2.available_types(), (implemented_by_mapping
+	QCOMPARE(m2.available_types().sorted(), (implemented_by_mapping
 	{
 		implemented_by{type_1_subtype_1_type, type_1_subtype_1_type},
 		implemented_by{type_1_subtype_2_type, type_1_subtype_2_subtype_1_type},
 		implemented_by{type_1_subtype_2_subtype_1_type, type_1_subtype_2_subtype_1_type},
 		implemented_by{type_1_subtype_3_type, type_1_subtype_3_type}
 	}));
-	QCOMPARE(m2.mapped_dependencies(), (types_dependencies
+	QCOMPARE(m2.mapped_dependencies().sorted(), (types_dependencies
 	{
 		make_type_dependencies(known_types, type_1_subtype_1_type),
 		make_type_dependencies(known_types, type_1_subtype_2_subtype_1_type),
@@ -218,5 +235,119 @@ void types_model_test::should_throw_when_unresolvable_dependency()
 	});
 }
 
+void types_model_test::should_extend_to_the_same_model_as_created_at_once()
+{
+	auto base = make_types_model(known_types, {type_1_subtype_1_type}, {type_1_subtype_1_type});
+	auto extended = extend_types_model(base, known_types, {type_1_subtype_2_type}, {type_1_subtype_2_type});
+	auto at_once = make_types_model(known_types, {type_1_subtype_1_type, type_1_subtype_2_type}, {type_1_subtype_1_type, type_1_subtype_2_type});
+
+	QCOMPARE(extended.available_types(), at_once.available_types());
+	QCOMPARE(extended.mapped_dependencies(), at_once.mapped_dependencies());
+	QCOMPARE(extended.all_implementations(), at_once.all_implementations());
+	QCOMPARE(extended.all_implementations_of(type_1_type), (types{type_1_subtype_1_type, type_1_subtype_2_type}));
+}
+
+void types_model_test::should_extend_with_type_depending_on_existing_types()
+{
+	auto base = make_types_model(known_types, {type_1_subtype_1_type, type_1_subtype_2_type}, {type_1_subtype_1_type, type_1_subtype_2_type});
+	auto extended = extend_types_model(base, known_types, {type_1_subtype_3_type}, {type_1_subtype_3_type});
+
+	QVERIFY(extended.contains(type_1_subtype_3_type));
+	QCOMPARE(extended.mapped_dependencies().sorted(), (types_dependencies
+	{
+		make_type_dependencies(known_types, type_1_subtype_1_type),
+		make_type_dependencies(known_types, type_1_subtype_2_type),
+		make_type_dependencies(known_types, type_1_subtype_3_type)
+	}));
+}
+
+void types_model_test::should_throw_when_extended_with_subtype_of_configured_type()
+{
+	auto base = make_types_model(known_types, {type_1_subtype_2_type}, {type_1_subtype_2_type});
+
+	expect<exception::ambiguous_types>({}, [&]{
+		extend_types_model(base, known_types, {type_1_subtype_2_subtype_1_type}, {type_1_subtype_2_subtype_1_type});
+	});
+}
+
+void types_model_test::should_throw_when_extended_type_has_unresolvable_dependency()
+{
+	auto base = make_types_model(known_types, {type_1_subtype_1_type}, {type_1_subtype_1_type});
+
+	expect<exception::unresolvable_dependencies>({"set_type_1_subtype_2"}, [&]{
+		extend_types_model(base, known_types, {type_1_subtype_3_type}, {type_1_subtype_3_type});
+	});
+}
+
+void types_model_test::should_throw_when_extension_makes_existing_dependency_ambiguous()
+{
+	auto base = make_types_model(known_types,
+		{type_1_subtype_1_type, type_1_subtype_2_subtype_1_type, type_1_subtype_3_type},
+		{type_1_subtype_1_type, type_1_subtype_2_subtype_1_type, type_1_subtype_3_type});
+
+	expect<exception::unresolvable_dependencies>({"set_type_1_subtype_2"}, [&]{
+		extend_types_model(base, known_types, {type_1_subtype_2_subtype_2_type}, {type_1_subtype_2_subtype_2_type});
+	});
+}
+
+void types_model_test::should_share_graph_when_adding_dependencies()
+{
+	auto all_types = std::vector<type>{type_1_subtype_1_type, type_1_subtype_2_type, type_1_subtype_3_type};
+	auto lazy = make_types_model(known_types, all_types, std::vector<type>{});
+	auto &graph = lazy.graph();
+	auto subtype_1 = graph.find(type_1_subtype_1_type);
+	auto subtype_3 = graph.find(type_1_subtype_3_type);
+	auto &subtype_1_closure = graph.closure(subtype_1);
+	QVERIFY(graph.targets_of(subtype_3).empty());
+
+	auto extended = extend_types_dependencies(lazy, types_dependencies{make_type_dependencies(known_types, type_1_subtype_3_type)});
+	auto at_once = make_types_model(known_types, all_types, {type_1_subtype_3_type});
+
+	QCOMPARE(extended.mapped_dependencies(), at_once.mapped_dependencies());
+	QCOMPARE(&extended.graph(), &graph);
+	QCOMPARE(&extended.graph().closure(subtype_1), &subtype_1_closure);
+	QCOMPARE(extended.graph().targets_of(subtype_3).size(), size_t{2});
+	QVERIFY(extended.graph().depends_on(subtype_3, subtype_1));
+	QVERIFY(extended.graph().depends_on(subtype_3, graph.find(type_1_subtype_2_type)));
+}
+
+void types_model_test::should_throw_when_added_dependency_is_unresolvable()
+{
+	auto lazy = make_types_model(known_types, {type_1_subtype_1_type, type_1_subtype_3_type}, std::vector<type>{});
+
+	expect<exception::unresolvable_dependencies>({"set_type_1_subtype_2"}, [&]{
+		extend_types_dependencies(lazy, types_dependencies{make_type_dependencies(known_types, type_1_subtype_3_type)});
+	});
+	QVERIFY(lazy.graph().targets_of(lazy.graph().find(type_1_subtype_3_type)).empty());
+}
+
+void types_model_test::should_reduce_to_the_same_model_as_created_at_once()
+{
+	auto base = make_types_model(known_types,
+		{type_1_subtype_1_type, type_1_subtype_2_type, type_1_subtype_3_type},
+		{type_1_subtype_1_type, type_1_subtype_2_type, type_1_subtype_3_type});
+	auto reduced = reduce_types_model(base, {type_1_subtype_3_type});
+	auto at_once = make_types_model(known_types, {type_1_subtype_1_type, type_1_subtype_2_type}, {type_1_subtype_1_type, type_1_subtype_2_type});
+
+	QCOMPARE(reduced.available_types(), at_once.available_types());
+	QCOMPARE(reduced.mapped_dependencies(), at_once.mapped_dependencies());
+	QCOMPARE(reduced.all_implementations(), at_once.all_implementations());
+}
+
+void types_model_test::should_make_interface_available_after_reduce()
+{
+	auto base = make_types_model(known_types, {type_1_subtype_1_type, type_1_subtype_2_type}, {type_1_subtype_1_type, type_1_subtype_2_type});
+	QVERIFY(!base.contains(type_1_type));
+
+	auto reduced = reduce_types_model(base, {type_1_subtype_2_type});
+
+	QCOMPARE(reduced.available_types().sorted(), (implemented_by_mapping
+	{
+		implemented_by{type_1_type, type_1_subtype_1_type},
+		implemented_by{type_1_subtype_1_type, type_1_subtype_1_type}
+	}));
+	QCOMPARE(reduced.all_implementations_of(type_1_subtype_2_type), types{});
+}
+
 QTEST_APPLESS_MAIN(types_model_test)
 #include "types-model-test.moc"